@@ -0,0 +1,79 @@
+#ifndef STL_ALLOC_PROFILE_HPP
+#define STL_ALLOC_PROFILE_HPP
+
+
+// Per call site heap profiling of make_unique / default_delete.
+// Build with -DSTL_ALLOC_PROFILING=1 to enable it. When disabled (the default) the hooks expand
+// to nothing and none of the profiler's code or storage is compiled in.
+#ifndef STL_ALLOC_PROFILING
+#define STL_ALLOC_PROFILING 0
+#endif
+
+#if STL_ALLOC_PROFILING
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "span.hpp"
+#include "string_view.hpp"
+
+namespace std
+{
+    struct alloc_site_stats
+    {
+        const void* site;           // return address into the caller of make_unique
+        uint64_t allocations;
+        uint64_t bytes;
+        uint64_t live;              // allocations not yet released through default_delete
+        uint64_t lifetime_cycles;   // summed over the released allocations (TSC cycles)
+    };
+
+    struct alloc_profile_totals
+    {
+        uint64_t untracked_allocations; // dropped because a per-thread table was full
+        uint64_t unmatched_deallocations; // freed on another thread, or never tracked
+        uint64_t dropped_sites; // per-thread site entries that did not fit in the summary output
+    };
+
+    namespace detail
+    {
+        inline constexpr uint32_t alloc_profile_max_threads = 16;
+        inline constexpr size_t alloc_profile_site_capacity = 256;  // power of two
+    }
+
+    // Output size for which the summary never drops a site: every thread's table full of distinct sites.
+    inline constexpr size_t alloc_profile_max_sites = detail::alloc_profile_max_threads * detail::alloc_profile_site_capacity;
+
+    // Merges every thread's statistics into output, hottest sites (most bytes) first, and returns
+    // the number of entries written. Meant to be called once the profiled threads are quiescent.
+    size_t alloc_profile_summary(span<alloc_site_stats> output, alloc_profile_totals* totals = nullptr) noexcept;
+
+    // Writes the summary as one text line per site, merging into the caller's scratch storage.
+    // Sites that do not fit are counted on the first line.
+    void alloc_profile_dump(void (*sink)(string_view line), span<alloc_site_stats> scratch) noexcept;
+
+    void alloc_profile_reset() noexcept;
+
+    namespace detail
+    {
+        void alloc_profile_on_allocate(const void* pointer, size_t size, const void* site) noexcept;
+        void alloc_profile_on_deallocate(const void* pointer) noexcept;
+    }
+}
+
+// The call site is the return address of the function using the hook, which therefore must
+// not be inlined into its caller.
+#define STL_ALLOC_PROFILE_NOINLINE [[gnu::noinline]]
+#define STL_ALLOC_PROFILE_ALLOCATE(pointer, size) \
+    ::std::detail::alloc_profile_on_allocate((pointer), (size), __builtin_return_address(0))
+#define STL_ALLOC_PROFILE_DEALLOCATE(pointer) ::std::detail::alloc_profile_on_deallocate(pointer)
+
+#else
+
+#define STL_ALLOC_PROFILE_NOINLINE
+#define STL_ALLOC_PROFILE_ALLOCATE(pointer, size) ((void)0)
+#define STL_ALLOC_PROFILE_DEALLOCATE(pointer) ((void)0)
+
+#endif
+
+
+#endif //STL_ALLOC_PROFILE_HPP
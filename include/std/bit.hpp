@@ -0,0 +1,40 @@
+#ifndef STL_BIT_HPP
+#define STL_BIT_HPP
+
+
+#include "cstdint.hpp"
+
+namespace std
+{
+    // popcount / countr_zero / countl_zero
+    // Thin wrappers over the Clang builtins so that they lower to popcnt/tzcnt/lzcnt
+    // when the target allows it, while staying usable in constant expressions.
+    constexpr int popcount(uint64_t x) noexcept
+    {
+        return __builtin_popcountll(x);
+    }
+
+    constexpr int countr_zero(uint64_t x) noexcept
+    {
+        // The builtins are undefined for 0, the standard functions are not.
+        return x ? __builtin_ctzll(x) : 64;
+    }
+
+    constexpr int countl_zero(uint64_t x) noexcept
+    {
+        return x ? __builtin_clzll(x) : 64;
+    }
+
+    constexpr int countr_one(uint64_t x) noexcept
+    {
+        return countr_zero(~x);
+    }
+
+    constexpr int bit_width(uint64_t x) noexcept
+    {
+        return 64 - countl_zero(x);
+    }
+}
+
+
+#endif //STL_BIT_HPP
@@ -0,0 +1,517 @@
+#ifndef STL_BITSET_HPP
+#define STL_BITSET_HPP
+
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "bit.hpp"
+
+namespace std
+{
+    // Word-level kernels shared by bitset and dynamic_bitset.
+    // They are written as plain counted loops over 64-bit words so that Clang turns the bulk
+    // operations into SSE2/AVX2 code, and the scans into one tzcnt/lzcnt per non-empty word.
+    namespace detail
+    {
+        using bitset_word = uint64_t;
+
+        inline constexpr size_t bitset_word_bits = 64;
+        inline constexpr size_t bitset_npos = static_cast<size_t>(-1);
+
+        constexpr size_t bitset_words_for(size_t bits) noexcept;
+
+        constexpr void bitset_fill(bitset_word* words, size_t count, bitset_word value) noexcept;
+        constexpr void bitset_copy(bitset_word* dst, const bitset_word* src, size_t count) noexcept;
+        constexpr bool bitset_equal(const bitset_word* lhs, const bitset_word* rhs, size_t count) noexcept;
+
+        constexpr void bitset_and(bitset_word* dst, const bitset_word* src, size_t count) noexcept;
+        constexpr void bitset_or(bitset_word* dst, const bitset_word* src, size_t count) noexcept;
+        constexpr void bitset_xor(bitset_word* dst, const bitset_word* src, size_t count) noexcept;
+        constexpr void bitset_and_not(bitset_word* dst, const bitset_word* src, size_t count) noexcept;
+        constexpr void bitset_not(bitset_word* dst, size_t count) noexcept;
+
+        constexpr size_t bitset_count(const bitset_word* words, size_t count) noexcept;
+
+        // Every scan takes an inversion mask: 0 looks for set bits, ~0 looks for clear bits.
+        constexpr size_t bitset_find_next(const bitset_word* words, size_t count, size_t bits, size_t pos, bitset_word invert) noexcept;
+        constexpr size_t bitset_find_last(const bitset_word* words, size_t count, size_t bits, bitset_word invert) noexcept;
+    }
+
+    template<size_t N>
+    class bitset
+    {
+    public:
+        /// Member types
+        using word_type = detail::bitset_word;
+
+        static constexpr size_t npos = detail::bitset_npos;
+
+        /// Constructors
+        constexpr bitset() noexcept;
+        constexpr bitset(unsigned long long value) noexcept;
+
+        /// Operators
+        constexpr bool operator[](size_t pos) const;
+        constexpr bool operator==(const bitset& other) const noexcept;
+
+        constexpr bitset& operator&=(const bitset& other) noexcept;
+        constexpr bitset& operator|=(const bitset& other) noexcept;
+        constexpr bitset& operator^=(const bitset& other) noexcept;
+        constexpr bitset operator~() const noexcept;
+
+        /// Member functions
+        //  Element access
+        constexpr bool test(size_t pos) const;
+        constexpr bool all() const noexcept;
+        constexpr bool any() const noexcept;
+        constexpr bool none() const noexcept;
+        constexpr size_t count() const noexcept;
+
+        //  Modifiers
+        constexpr bitset& set() noexcept;
+        constexpr bitset& set(size_t pos, bool value = true);
+        constexpr bitset& reset() noexcept;
+        constexpr bitset& reset(size_t pos);
+        constexpr bitset& flip() noexcept;
+        constexpr bitset& flip(size_t pos);
+        constexpr bitset& and_not(const bitset& other) noexcept;
+
+        //  Scanning (find_next* start after pos, npos when nothing is found)
+        constexpr size_t find_first() const noexcept;
+        constexpr size_t find_next(size_t pos) const noexcept;
+        constexpr size_t find_last() const noexcept;
+        constexpr size_t find_first_unset() const noexcept;
+        constexpr size_t find_next_unset(size_t pos) const noexcept;
+
+        //  Observers
+        constexpr size_t size() const noexcept;
+        constexpr const word_type* data() const noexcept;
+        constexpr word_type* data() noexcept;
+    private:
+        static constexpr size_t word_count = detail::bitset_words_for(N);
+
+        constexpr void clear_unused_bits() noexcept;
+
+        word_type m_words[word_count ? word_count : 1];
+    };
+
+    /// Extern operators
+    template<size_t N>
+    constexpr bitset<N> operator&(const bitset<N>& lhs, const bitset<N>& rhs) noexcept;
+    template<size_t N>
+    constexpr bitset<N> operator|(const bitset<N>& lhs, const bitset<N>& rhs) noexcept;
+    template<size_t N>
+    constexpr bitset<N> operator^(const bitset<N>& lhs, const bitset<N>& rhs) noexcept;
+
+
+    class dynamic_bitset
+    {
+    public:
+        /// Member types
+        using word_type = detail::bitset_word;
+
+        static constexpr size_t npos = detail::bitset_npos;
+
+        /// Constructors
+        dynamic_bitset() noexcept;
+        explicit dynamic_bitset(size_t bits, bool value = false);
+        dynamic_bitset(const dynamic_bitset& other);
+        dynamic_bitset(dynamic_bitset&& other) noexcept;
+
+        /// Destructor
+        ~dynamic_bitset();
+
+        /// Operators
+        dynamic_bitset& operator=(const dynamic_bitset& other);
+        dynamic_bitset& operator=(dynamic_bitset&& other) noexcept;
+
+        bool operator[](size_t pos) const;
+        bool operator==(const dynamic_bitset& other) const noexcept;
+
+        // Bulk operators require both operands to have the same size.
+        dynamic_bitset& operator&=(const dynamic_bitset& other) noexcept;
+        dynamic_bitset& operator|=(const dynamic_bitset& other) noexcept;
+        dynamic_bitset& operator^=(const dynamic_bitset& other) noexcept;
+
+        /// Member functions
+        //  Element access
+        bool test(size_t pos) const;
+        bool all() const noexcept;
+        bool any() const noexcept;
+        bool none() const noexcept;
+        size_t count() const noexcept;
+
+        //  Modifiers
+        dynamic_bitset& set() noexcept;
+        dynamic_bitset& set(size_t pos, bool value = true);
+        dynamic_bitset& reset() noexcept;
+        dynamic_bitset& reset(size_t pos);
+        dynamic_bitset& flip() noexcept;
+        dynamic_bitset& flip(size_t pos);
+        dynamic_bitset& and_not(const dynamic_bitset& other) noexcept;
+
+        void resize(size_t bits, bool value = false);
+        void clear() noexcept;
+        void swap(dynamic_bitset& other) noexcept;
+
+        //  Scanning (find_next* start after pos, npos when nothing is found)
+        size_t find_first() const noexcept;
+        size_t find_next(size_t pos) const noexcept;
+        size_t find_last() const noexcept;
+        size_t find_first_unset() const noexcept;
+        size_t find_next_unset(size_t pos) const noexcept;
+
+        //  Observers
+        size_t size() const noexcept;
+        size_t num_words() const noexcept;
+        const word_type* data() const noexcept;
+        word_type* data() noexcept;
+    private:
+        void clear_unused_bits() noexcept;
+
+        word_type* m_words;
+        size_t m_size;
+    };
+
+
+    // Word kernels
+    namespace detail
+    {
+        constexpr size_t bitset_words_for(size_t bits) noexcept
+        {
+            return (bits + bitset_word_bits - 1) / bitset_word_bits;
+        }
+
+        constexpr void bitset_fill(bitset_word* words, size_t count, bitset_word value) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                words[i] = value;
+        }
+
+        constexpr void bitset_copy(bitset_word* dst, const bitset_word* src, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                dst[i] = src[i];
+        }
+
+        constexpr bool bitset_equal(const bitset_word* lhs, const bitset_word* rhs, size_t count) noexcept
+        {
+            // No early exit: the OR-reduction vectorizes, a branch per word does not.
+            bitset_word diff = 0;
+            for (size_t i = 0; i < count; ++i)
+                diff |= lhs[i] ^ rhs[i];
+            return diff == 0;
+        }
+
+        constexpr void bitset_and(bitset_word* dst, const bitset_word* src, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                dst[i] &= src[i];
+        }
+
+        constexpr void bitset_or(bitset_word* dst, const bitset_word* src, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                dst[i] |= src[i];
+        }
+
+        constexpr void bitset_xor(bitset_word* dst, const bitset_word* src, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                dst[i] ^= src[i];
+        }
+
+        constexpr void bitset_and_not(bitset_word* dst, const bitset_word* src, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                dst[i] &= ~src[i];
+        }
+
+        constexpr void bitset_not(bitset_word* dst, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                dst[i] = ~dst[i];
+        }
+
+        constexpr size_t bitset_count(const bitset_word* words, size_t count) noexcept
+        {
+            size_t result = 0;
+            for (size_t i = 0; i < count; ++i)
+                result += popcount(words[i]);
+            return result;
+        }
+
+        constexpr size_t bitset_find_next(const bitset_word* words, size_t count, size_t bits, size_t pos, bitset_word invert) noexcept
+        {
+            if (pos >= bits)
+                return bitset_npos;
+
+            size_t index = pos / bitset_word_bits;
+            bitset_word word = (words[index] ^ invert) & (~bitset_word(0) << (pos % bitset_word_bits));
+
+            while (true)
+            {
+                if (word)
+                {
+                    // The padding bits of the last word read as set when inverted, hence the bound check.
+                    size_t result = index * bitset_word_bits + countr_zero(word);
+                    return result < bits ? result : bitset_npos;
+                }
+
+                if (++index == count)
+                    return bitset_npos;
+
+                word = words[index] ^ invert;
+            }
+        }
+
+        constexpr size_t bitset_find_last(const bitset_word* words, size_t count, size_t bits, bitset_word invert) noexcept
+        {
+            if (bits == 0)
+                return bitset_npos;
+
+            const size_t tail = bits % bitset_word_bits;
+            const bitset_word tail_mask = tail ? (bitset_word(1) << tail) - 1 : ~bitset_word(0);
+
+            size_t index = count;
+            bitset_word word = (words[--index] ^ invert) & tail_mask;
+
+            while (true)
+            {
+                if (word)
+                    return index * bitset_word_bits + (bitset_word_bits - 1 - countl_zero(word));
+
+                if (index == 0)
+                    return bitset_npos;
+
+                word = words[--index] ^ invert;
+            }
+        }
+    }
+
+
+    // bitset
+    // Constructors implementations
+    template<size_t N>
+    constexpr bitset<N>::bitset() noexcept : m_words{}
+    {
+    }
+
+    template<size_t N>
+    constexpr bitset<N>::bitset(unsigned long long value) noexcept : m_words{}
+    {
+        if constexpr (word_count > 0)
+        {
+            m_words[0] = value;
+            clear_unused_bits();
+        }
+    }
+
+    // Operators
+    template<size_t N>
+    constexpr bool bitset<N>::operator[](size_t pos) const
+    {
+        return (m_words[pos / detail::bitset_word_bits] >> (pos % detail::bitset_word_bits)) & 1;
+    }
+
+    template<size_t N>
+    constexpr bool bitset<N>::operator==(const bitset& other) const noexcept
+    {
+        return detail::bitset_equal(m_words, other.m_words, word_count);
+    }
+
+    template<size_t N>
+    constexpr bitset<N>& bitset<N>::operator&=(const bitset& other) noexcept
+    {
+        detail::bitset_and(m_words, other.m_words, word_count);
+        return *this;
+    }
+
+    template<size_t N>
+    constexpr bitset<N>& bitset<N>::operator|=(const bitset& other) noexcept
+    {
+        detail::bitset_or(m_words, other.m_words, word_count);
+        return *this;
+    }
+
+    template<size_t N>
+    constexpr bitset<N>& bitset<N>::operator^=(const bitset& other) noexcept
+    {
+        detail::bitset_xor(m_words, other.m_words, word_count);
+        return *this;
+    }
+
+    template<size_t N>
+    constexpr bitset<N> bitset<N>::operator~() const noexcept
+    {
+        bitset result = *this;
+        return result.flip();
+    }
+
+    // Member functions
+    template<size_t N>
+    constexpr bool bitset<N>::test(size_t pos) const
+    {
+        return (*this)[pos];
+    }
+
+    template<size_t N>
+    constexpr bool bitset<N>::all() const noexcept
+    {
+        return count() == N;
+    }
+
+    template<size_t N>
+    constexpr bool bitset<N>::any() const noexcept
+    {
+        return !none();
+    }
+
+    template<size_t N>
+    constexpr bool bitset<N>::none() const noexcept
+    {
+        word_type merged = 0;
+        for (size_t i = 0; i < word_count; ++i)
+            merged |= m_words[i];
+        return merged == 0;
+    }
+
+    template<size_t N>
+    constexpr size_t bitset<N>::count() const noexcept
+    {
+        return detail::bitset_count(m_words, word_count);
+    }
+
+    template<size_t N>
+    constexpr bitset<N>& bitset<N>::set() noexcept
+    {
+        detail::bitset_fill(m_words, word_count, ~word_type(0));
+        clear_unused_bits();
+        return *this;
+    }
+
+    template<size_t N>
+    constexpr bitset<N>& bitset<N>::set(size_t pos, bool value)
+    {
+        const word_type mask = word_type(1) << (pos % detail::bitset_word_bits);
+        word_type& word = m_words[pos / detail::bitset_word_bits];
+        word = value ? word | mask : word & ~mask;
+        return *this;
+    }
+
+    template<size_t N>
+    constexpr bitset<N>& bitset<N>::reset() noexcept
+    {
+        detail::bitset_fill(m_words, word_count, 0);
+        return *this;
+    }
+
+    template<size_t N>
+    constexpr bitset<N>& bitset<N>::reset(size_t pos)
+    {
+        return set(pos, false);
+    }
+
+    template<size_t N>
+    constexpr bitset<N>& bitset<N>::flip() noexcept
+    {
+        detail::bitset_not(m_words, word_count);
+        clear_unused_bits();
+        return *this;
+    }
+
+    template<size_t N>
+    constexpr bitset<N>& bitset<N>::flip(size_t pos)
+    {
+        m_words[pos / detail::bitset_word_bits] ^= word_type(1) << (pos % detail::bitset_word_bits);
+        return *this;
+    }
+
+    template<size_t N>
+    constexpr bitset<N>& bitset<N>::and_not(const bitset& other) noexcept
+    {
+        detail::bitset_and_not(m_words, other.m_words, word_count);
+        return *this;
+    }
+
+    template<size_t N>
+    constexpr size_t bitset<N>::find_first() const noexcept
+    {
+        return detail::bitset_find_next(m_words, word_count, N, 0, 0);
+    }
+
+    template<size_t N>
+    constexpr size_t bitset<N>::find_next(size_t pos) const noexcept
+    {
+        return pos >= N ? npos : detail::bitset_find_next(m_words, word_count, N, pos + 1, 0);
+    }
+
+    template<size_t N>
+    constexpr size_t bitset<N>::find_last() const noexcept
+    {
+        return detail::bitset_find_last(m_words, word_count, N, 0);
+    }
+
+    template<size_t N>
+    constexpr size_t bitset<N>::find_first_unset() const noexcept
+    {
+        return detail::bitset_find_next(m_words, word_count, N, 0, ~word_type(0));
+    }
+
+    template<size_t N>
+    constexpr size_t bitset<N>::find_next_unset(size_t pos) const noexcept
+    {
+        return pos >= N ? npos : detail::bitset_find_next(m_words, word_count, N, pos + 1, ~word_type(0));
+    }
+
+    template<size_t N>
+    constexpr size_t bitset<N>::size() const noexcept
+    {
+        return N;
+    }
+
+    template<size_t N>
+    constexpr const typename bitset<N>::word_type* bitset<N>::data() const noexcept
+    {
+        return m_words;
+    }
+
+    template<size_t N>
+    constexpr typename bitset<N>::word_type* bitset<N>::data() noexcept
+    {
+        return m_words;
+    }
+
+    template<size_t N>
+    constexpr void bitset<N>::clear_unused_bits() noexcept
+    {
+        // Bits past N must stay zero so that count(), == and the scans can work on whole words.
+        if constexpr (N % detail::bitset_word_bits != 0)
+            m_words[word_count - 1] &= (word_type(1) << (N % detail::bitset_word_bits)) - 1;
+    }
+
+    /// Extern operators
+    template<size_t N>
+    constexpr bitset<N> operator&(const bitset<N>& lhs, const bitset<N>& rhs) noexcept
+    {
+        bitset<N> result = lhs;
+        return result &= rhs;
+    }
+
+    template<size_t N>
+    constexpr bitset<N> operator|(const bitset<N>& lhs, const bitset<N>& rhs) noexcept
+    {
+        bitset<N> result = lhs;
+        return result |= rhs;
+    }
+
+    template<size_t N>
+    constexpr bitset<N> operator^(const bitset<N>& lhs, const bitset<N>& rhs) noexcept
+    {
+        bitset<N> result = lhs;
+        return result ^= rhs;
+    }
+}
+
+
+#endif //STL_BITSET_HPP
@@ -7,11 +7,114 @@
 
 
 #include "type_traits.hpp"
+#include "utility.hpp"
 
 namespace std
 {
+    // Core language concepts
     template<class T, class U>
     concept same_as = is_same_v<T, U>;
+
+    template<class Derived, class Base>
+    concept derived_from = is_base_of_v<Base, Derived> && is_convertible_v<const volatile Derived*, const volatile Base*>;
+
+    template<class From, class To>
+    concept convertible_to = is_convertible_v<From, To> && requires { static_cast<To>(declval<From>()); };
+
+    template<class T>
+    concept integral = is_integral_v<T>;
+
+    template<class T>
+    concept signed_integral = integral<T> && is_signed_v<T>;
+
+    template<class T>
+    concept unsigned_integral = integral<T> && !signed_integral<T>;
+
+    template<class LHS, class RHS>
+    concept assignable_from = is_lvalue_reference_v<LHS> && requires(LHS lhs, RHS&& rhs)
+    {
+        { lhs = forward<RHS>(rhs) } -> same_as<LHS>;
+    };
+
+    template<class T>
+    concept destructible = requires(T& value) { { value.~T() } noexcept; };
+
+    template<class T, class... Args>
+    concept constructible_from = destructible<T> && requires { T(declval<Args>()...); };
+
+    template<class T>
+    concept default_initializable = constructible_from<T> && requires { T{}; };
+
+    template<class T>
+    concept move_constructible = constructible_from<T, T> && convertible_to<T, T>;
+
+    template<class T>
+    concept copy_constructible = move_constructible<T>
+                                 && constructible_from<T, T&> && convertible_to<T&, T>
+                                 && constructible_from<T, const T&> && convertible_to<const T&, T>
+                                 && constructible_from<T, const T> && convertible_to<const T, T>;
+
+    // Comparison concepts (without the common_reference requirements)
+    namespace detail
+    {
+        template<class T>
+        concept boolean_testable = convertible_to<T, bool> && requires(T&& value)
+        {
+            { !forward<T>(value) } -> convertible_to<bool>;
+        };
+
+        template<class T, class U>
+        concept weakly_equality_comparable_with = requires(const remove_reference_t<T>& t, const remove_reference_t<U>& u)
+        {
+            { t == u } -> boolean_testable;
+            { t != u } -> boolean_testable;
+            { u == t } -> boolean_testable;
+            { u != t } -> boolean_testable;
+        };
+    }
+
+    template<class T>
+    concept equality_comparable = detail::weakly_equality_comparable_with<T, T>;
+
+    template<class T, class U>
+    concept equality_comparable_with = equality_comparable<T> && equality_comparable<U>
+                                       && detail::weakly_equality_comparable_with<T, U>;
+
+    template<class T>
+    concept totally_ordered = equality_comparable<T> && requires(const remove_reference_t<T>& a, const remove_reference_t<T>& b)
+    {
+        { a < b } -> detail::boolean_testable;
+        { a > b } -> detail::boolean_testable;
+        { a <= b } -> detail::boolean_testable;
+        { a >= b } -> detail::boolean_testable;
+    };
+
+    // Object concepts (swappable is left out: there is no ranges::swap yet)
+    template<class T>
+    concept movable = is_object_v<T> && move_constructible<T> && assignable_from<T&, T>;
+
+    template<class T>
+    concept copyable = copy_constructible<T> && movable<T>
+                       && assignable_from<T&, T&> && assignable_from<T&, const T&> && assignable_from<T&, const T>;
+
+    template<class T>
+    concept semiregular = copyable<T> && default_initializable<T>;
+
+    template<class T>
+    concept regular = semiregular<T> && equality_comparable<T>;
+
+    // Callable concepts (call expressions only, like invoke_result)
+    template<class F, class... Args>
+    concept invocable = requires(F&& function, Args&&... args)
+    {
+        forward<F>(function)(forward<Args>(args)...);
+    };
+
+    template<class F, class... Args>
+    concept regular_invocable = invocable<F, Args...>;
+
+    template<class F, class... Args>
+    concept predicate = regular_invocable<F, Args...> && detail::boolean_testable<invoke_result_t<F, Args...>>;
 }
 
 
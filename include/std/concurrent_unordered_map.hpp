@@ -0,0 +1,569 @@
+#ifndef STL_CONCURRENT_UNORDERED_MAP_HPP
+#define STL_CONCURRENT_UNORDERED_MAP_HPP
+
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "functional.hpp"
+#include "new.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+namespace std
+{
+    namespace detail
+    {
+        inline constexpr size_t concurrent_cache_line = 64;
+
+        // Optimistic reads tried before find falls back to the shared lock.
+        inline constexpr uint32_t optimistic_read_attempts = 4;
+
+        // Reader-writer spinlock paired with a sequence counter.
+        // Writers exclude everyone and make the sequence odd while they hold the lock; readers
+        // either share the lock, or take no lock at all and check afterwards that the sequence
+        // did not move (read_begin / read_retry). A waiting writer stops new readers from
+        // joining, so a steady flow of readers cannot starve it.
+        class shared_seqlock
+        {
+        public:
+            /// Member functions
+            void lock() noexcept;
+            void unlock() noexcept;
+            void lock_shared() noexcept;
+            void unlock_shared() noexcept;
+
+            // Waits until no writer holds the lock and returns the sequence to validate with.
+            uint32_t read_begin() const noexcept;
+            // Whether what was read since read_begin may be torn and must be read again.
+            bool read_retry(uint32_t sequence) const noexcept;
+        private:
+            uint32_t m_state = 0;     // bit 0: writer holding or waiting, above: 2 per reader
+            uint32_t m_sequence = 0;
+        };
+    }
+
+    // Hash map shared by many threads, split into Shards independent shards picked by the high
+    // bits of the key's hash, so that threads working on different keys rarely touch the same
+    // lock or cache line.
+    // Each shard is an open-addressing table (linear probing, one control byte per slot holding
+    // 7 bits of the hash, erasure by backward shift so that no tombstones pile up) behind a
+    // detail::shared_seqlock.
+    // When keys are compared by value (integers, enums, pointers) and Value is trivially
+    // copyable, find takes no lock: it copies the value out and retries if a writer got in the
+    // way. Tables replaced by a growth are then kept until the map is destroyed, since a reader
+    // may still be probing them; they add up to less than the live tables. Any other map is read
+    // under the shared lock, which still only contends with writers to the same shard.
+    //
+    // Entries are never handed out by reference: find copies the value, and visit runs a
+    // function on it while the shard is locked.
+    template<class Key, class Value, class Hash = hash<Key>, class KeyEqual = equal_to<Key>, size_t Shards = 64>
+    class concurrent_unordered_map
+    {
+        static_assert(Shards != 0 && (Shards & (Shards - 1)) == 0, "The shard count must be a power of two.");
+    public:
+        /// Member types
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        // A torn key or value is only ever copied and compared, never dereferenced.
+        static constexpr bool optimistic_reads = (is_arithmetic_v<Key> || is_enum_v<Key> || is_pointer_v<Key>)
+                                                 && is_same_v<KeyEqual, equal_to<Key>> && is_trivially_copyable_v<Value>;
+
+        /// Constructors
+        constexpr concurrent_unordered_map() noexcept = default;
+        concurrent_unordered_map(const concurrent_unordered_map&) = delete;
+
+        /// Destructor
+        ~concurrent_unordered_map();
+
+        /// Operators
+        concurrent_unordered_map& operator=(const concurrent_unordered_map&) = delete;
+
+        /// Member functions
+        //  Lookup
+        // Copies the value of key into result, false when key is absent.
+        bool find(const Key& key, Value& result) const;
+        bool contains(const Key& key) const;
+
+        //  Modifiers
+        // Both return true when they inserted a new entry. They leave the map unchanged and return
+        // false when the shard is full and cannot grow.
+        template<class V>
+        bool insert_or_assign(const Key& key, V&& value);
+        template<class... Args>
+        bool try_emplace(const Key& key, Args&&... args);
+
+        bool erase(const Key& key);
+        void clear();
+
+        //  Visitors
+        // Calls f(Value&) on the entry of key with its shard locked, false when key is absent.
+        template<class F>
+        bool visit(const Key& key, F f);
+        // Calls f(const Key&, const Value&) on every entry, one shard at a time, each shared
+        // locked while it is visited.
+        template<class F>
+        void visit_all(F f) const;
+
+        //  Capacity
+        // Exact only while no other thread modifies the map.
+        size_type size() const noexcept;
+        bool empty() const noexcept;
+    private:
+        struct slot
+        {
+            Key key;
+            Value value;
+        };
+
+        // One allocation: this header, then the control bytes, then the slots.
+        struct table
+        {
+            table* retired;     // previous table of the shard, kept for optimistic readers
+            size_t capacity;    // power of two
+            uint8_t* control;
+            slot* slots;
+        };
+
+        struct alignas(detail::concurrent_cache_line) shard
+        {
+            detail::shared_seqlock lock;
+            table* current = nullptr;
+            size_t size = 0;
+        };
+
+        static constexpr size_t initial_capacity = 16;
+        static constexpr uint8_t empty_control = 0;
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        static size_t hash_of(const Key& key) noexcept;
+        static uint8_t control_of(size_t hash) noexcept;
+        static size_t home_of(size_t hash, size_t capacity) noexcept;
+        shard& shard_of(size_t hash) const noexcept;
+
+        static size_t find_index(const table* entries, size_t hash, const Key& key);
+        static table* allocate_table(size_t capacity) noexcept;
+        static void destroy_entries(table* entries) noexcept;
+
+        bool find_optimistic(shard& owner, size_t hash, const Key& key, Value* result) const;
+        bool find_locked(shard& owner, size_t hash, const Key& key, Value* result) const;
+        // Empty slot for a new entry of a locked shard, growing it first if needed; npos when
+        // the table is full and cannot grow.
+        size_t insert_index(shard& owner, size_t hash);
+        bool grow(shard& owner) noexcept;
+        void erase_index(shard& owner, size_t index);
+
+        mutable shard m_shards[Shards];
+    };
+
+
+    // concurrent_unordered_map
+    // Destructor implementation
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::~concurrent_unordered_map()
+    {
+        for (shard& owner : m_shards)
+        {
+            if (!owner.current)
+                continue;
+
+            destroy_entries(owner.current);
+            for (table* entries = owner.current; entries;)
+            {
+                table* const retired = entries->retired;
+                ::operator delete(entries);
+                entries = retired;
+            }
+        }
+    }
+
+    // Member functions
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    bool concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::find(const Key& key, Value& result) const
+    {
+        const size_t hash = hash_of(key);
+        if constexpr (optimistic_reads)
+            return find_optimistic(shard_of(hash), hash, key, &result);
+        else
+            return find_locked(shard_of(hash), hash, key, &result);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    bool concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::contains(const Key& key) const
+    {
+        const size_t hash = hash_of(key);
+        if constexpr (optimistic_reads)
+            return find_optimistic(shard_of(hash), hash, key, nullptr);
+        else
+            return find_locked(shard_of(hash), hash, key, nullptr);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    template<class V>
+    bool concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::insert_or_assign(const Key& key, V&& value)
+    {
+        const size_t hash = hash_of(key);
+        shard& owner = shard_of(hash);
+        owner.lock.lock();
+
+        const size_t found = find_index(owner.current, hash, key);
+        if (found != npos)
+        {
+            owner.current->slots[found].value = forward<V>(value);
+            owner.lock.unlock();
+            return false;
+        }
+
+        const size_t index = insert_index(owner, hash);
+        if (index != npos)
+        {
+            table* const entries = owner.current;
+            new (&entries->slots[index]) slot{ key, forward<V>(value) };
+            __atomic_store_n(&entries->control[index], control_of(hash), __ATOMIC_RELEASE);
+            __atomic_store_n(&owner.size, owner.size + 1, __ATOMIC_RELAXED);
+        }
+
+        owner.lock.unlock();
+        return index != npos;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    template<class... Args>
+    bool concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::try_emplace(const Key& key, Args&&... args)
+    {
+        const size_t hash = hash_of(key);
+        shard& owner = shard_of(hash);
+        owner.lock.lock();
+
+        size_t index = npos;
+        if (find_index(owner.current, hash, key) == npos)
+        {
+            index = insert_index(owner, hash);
+            if (index != npos)
+            {
+                table* const entries = owner.current;
+                new (&entries->slots[index]) slot{ key, Value(forward<Args>(args)...) };
+                __atomic_store_n(&entries->control[index], control_of(hash), __ATOMIC_RELEASE);
+                __atomic_store_n(&owner.size, owner.size + 1, __ATOMIC_RELAXED);
+            }
+        }
+
+        owner.lock.unlock();
+        return index != npos;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    bool concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::erase(const Key& key)
+    {
+        const size_t hash = hash_of(key);
+        shard& owner = shard_of(hash);
+        owner.lock.lock();
+
+        const size_t index = find_index(owner.current, hash, key);
+        if (index != npos)
+            erase_index(owner, index);
+
+        owner.lock.unlock();
+        return index != npos;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    void concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::clear()
+    {
+        for (shard& owner : m_shards)
+        {
+            owner.lock.lock();
+            if (owner.current)
+            {
+                destroy_entries(owner.current);
+                __builtin_memset(owner.current->control, empty_control, owner.current->capacity);
+                __atomic_store_n(&owner.size, 0, __ATOMIC_RELAXED);
+            }
+            owner.lock.unlock();
+        }
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    template<class F>
+    bool concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::visit(const Key& key, F f)
+    {
+        const size_t hash = hash_of(key);
+        shard& owner = shard_of(hash);
+        owner.lock.lock();
+
+        const size_t index = find_index(owner.current, hash, key);
+        if (index != npos)
+            f(owner.current->slots[index].value);
+
+        owner.lock.unlock();
+        return index != npos;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    template<class F>
+    void concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::visit_all(F f) const
+    {
+        for (shard& owner : m_shards)
+        {
+            owner.lock.lock_shared();
+            if (const table* entries = owner.current)
+            {
+                for (size_t i = 0; i < entries->capacity; ++i)
+                {
+                    if (entries->control[i] != empty_control)
+                        f(static_cast<const Key&>(entries->slots[i].key), static_cast<const Value&>(entries->slots[i].value));
+                }
+            }
+            owner.lock.unlock_shared();
+        }
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::size_type concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::size() const noexcept
+    {
+        size_type total = 0;
+        for (const shard& owner : m_shards)
+            total += __atomic_load_n(&owner.size, __ATOMIC_RELAXED);
+        return total;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    bool concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    size_t concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::hash_of(const Key& key) noexcept
+    {
+        return detail::hash_mix(Hash()(key));
+    }
+
+    // The hash is split three ways: the top bits pick the shard, the low 7 bits are kept in the
+    // control byte, and the bits above them give the home slot.
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    uint8_t concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::control_of(size_t hash) noexcept
+    {
+        return static_cast<uint8_t>(0x80 | (hash & 0x7F));
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    size_t concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::home_of(size_t hash, size_t capacity) noexcept
+    {
+        return (hash >> 7) & (capacity - 1);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::shard& concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::shard_of(size_t hash) const noexcept
+    {
+        if constexpr (Shards == 1)
+            return m_shards[0];
+        else
+            return m_shards[hash >> (sizeof(size_t) * 8 - __builtin_ctzll(Shards))];
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    size_t concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::find_index(const table* entries, size_t hash, const Key& key)
+    {
+        if (!entries)
+            return npos;
+
+        const size_t mask = entries->capacity - 1;
+        const uint8_t control = control_of(hash);
+        size_t index = home_of(hash, entries->capacity);
+
+        for (size_t probes = 0; probes <= mask; ++probes, index = (index + 1) & mask)
+        {
+            const uint8_t current = entries->control[index];
+            if (current == empty_control)
+                return npos;
+            if (current == control && KeyEqual()(entries->slots[index].key, key))
+                return index;
+        }
+        return npos;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::table* concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::allocate_table(size_t capacity) noexcept
+    {
+        static_assert(alignof(slot) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned entries are not supported by concurrent_unordered_map.");
+
+        const size_t slots_offset = (sizeof(table) + capacity + alignof(slot) - 1) & ~(alignof(slot) - 1);
+        char* block = static_cast<char*>(::operator new(slots_offset + capacity * sizeof(slot), nothrow));
+        if (!block)
+            return nullptr;
+
+        table* entries = reinterpret_cast<table*>(block);
+        entries->retired = nullptr;
+        entries->capacity = capacity;
+        entries->control = reinterpret_cast<uint8_t*>(block + sizeof(table));
+        entries->slots = reinterpret_cast<slot*>(block + slots_offset);
+        __builtin_memset(entries->control, empty_control, capacity);
+        return entries;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    void concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::destroy_entries(table* entries) noexcept
+    {
+        if constexpr (!is_trivially_destructible_v<slot>)
+        {
+            for (size_t i = 0; i < entries->capacity; ++i)
+            {
+                if (entries->control[i] != empty_control)
+                    entries->slots[i].~slot();
+            }
+        }
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    bool concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::find_optimistic(shard& owner, size_t hash, const Key& key, Value* result) const
+    {
+        for (uint32_t attempt = 0; attempt < detail::optimistic_read_attempts; ++attempt)
+        {
+            const uint32_t sequence = owner.lock.read_begin();
+            const table* entries = __atomic_load_n(&owner.current, __ATOMIC_ACQUIRE);
+
+            // Everything read here may be torn by a writer: it is copied, checked against the
+            // sequence and only then used. The probe count bounds the loop whatever was read.
+            bool found = false;
+            alignas(Value) unsigned char value[sizeof(Value)];
+            if (entries)
+            {
+                const size_t mask = entries->capacity - 1;
+                const uint8_t control = control_of(hash);
+                size_t index = home_of(hash, entries->capacity);
+
+                for (size_t probes = 0; probes <= mask; ++probes, index = (index + 1) & mask)
+                {
+                    const uint8_t current = __atomic_load_n(&entries->control[index], __ATOMIC_RELAXED);
+                    if (current == empty_control)
+                        break;
+                    if (current != control)
+                        continue;
+
+                    Key candidate;
+                    __builtin_memcpy(&candidate, &entries->slots[index].key, sizeof(Key));
+                    if (candidate == key)
+                    {
+                        __builtin_memcpy(value, &entries->slots[index].value, sizeof(Value));
+                        found = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!owner.lock.read_retry(sequence))
+            {
+                if (found && result)
+                    __builtin_memcpy(result, value, sizeof(Value));
+                return found;
+            }
+        }
+
+        // Writers kept getting in the way.
+        return find_locked(owner, hash, key, result);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    bool concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::find_locked(shard& owner, size_t hash, const Key& key, Value* result) const
+    {
+        owner.lock.lock_shared();
+
+        const size_t index = find_index(owner.current, hash, key);
+        if (index != npos && result)
+            *result = owner.current->slots[index].value;
+
+        owner.lock.unlock_shared();
+        return index != npos;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    size_t concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::insert_index(shard& owner, size_t hash)
+    {
+        // Grown past three quarters full. A failed growth still leaves room while one empty slot
+        // remains to end the probes.
+        table* entries = owner.current;
+        if (!entries || (owner.size + 1) * 4 > entries->capacity * 3)
+        {
+            if (!grow(owner) && (!entries || owner.size + 2 > entries->capacity))
+                return npos;
+            entries = owner.current;
+        }
+
+        const size_t mask = entries->capacity - 1;
+        size_t index = home_of(hash, entries->capacity);
+        while (entries->control[index] != empty_control)
+            index = (index + 1) & mask;
+        return index;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    bool concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::grow(shard& owner) noexcept
+    {
+        table* const previous = owner.current;
+        table* const entries = allocate_table(previous ? previous->capacity * 2 : initial_capacity);
+        if (!entries)
+            return false;
+
+        if (previous)
+        {
+            const size_t mask = entries->capacity - 1;
+            for (size_t i = 0; i < previous->capacity; ++i)
+            {
+                if (previous->control[i] == empty_control)
+                    continue;
+
+                slot& moved = previous->slots[i];
+                const size_t hash = hash_of(moved.key);
+                size_t index = home_of(hash, entries->capacity);
+                while (entries->control[index] != empty_control)
+                    index = (index + 1) & mask;
+
+                new (&entries->slots[index]) slot{ move(moved.key), move(moved.value) };
+                entries->control[index] = control_of(hash);
+                moved.~slot();
+            }
+
+            if constexpr (optimistic_reads)
+                entries->retired = previous;
+            else
+                ::operator delete(previous);
+        }
+
+        __atomic_store_n(&owner.current, entries, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // Backward shift: the entries after the erased one that probed past it move back, so that
+    // every entry stays reachable from its home slot without crossing an empty one.
+    template<class Key, class Value, class Hash, class KeyEqual, size_t Shards>
+    void concurrent_unordered_map<Key, Value, Hash, KeyEqual, Shards>::erase_index(shard& owner, size_t index)
+    {
+        table* const entries = owner.current;
+        const size_t mask = entries->capacity - 1;
+
+        entries->slots[index].~slot();
+        for (size_t next = (index + 1) & mask; entries->control[next] != empty_control; next = (next + 1) & mask)
+        {
+            const size_t home = home_of(hash_of(entries->slots[next].key), entries->capacity);
+
+            // The entry at next stays if its home lies cyclically in (index, next].
+            if (((next - home) & mask) < ((next - index) & mask))
+                continue;
+
+            new (&entries->slots[index]) slot{ move(entries->slots[next].key), move(entries->slots[next].value) };
+            entries->control[index] = entries->control[next];
+            entries->slots[next].~slot();
+            index = next;
+        }
+
+        __atomic_store_n(&entries->control[index], empty_control, __ATOMIC_RELAXED);
+        __atomic_store_n(&owner.size, owner.size - 1, __ATOMIC_RELAXED);
+    }
+}
+
+
+#endif //STL_CONCURRENT_UNORDERED_MAP_HPP
@@ -0,0 +1,452 @@
+#ifndef STL_COROUTINE_HPP
+#define STL_COROUTINE_HPP
+
+
+#include "cstddef.hpp"
+#include "concepts.hpp"
+#include "memory.hpp"
+
+namespace std
+{
+    // coroutine_traits
+    template<class R, class... Args>
+    struct coroutine_traits
+    {
+        using promise_type = typename R::promise_type;
+    };
+
+
+    // coroutine_handle
+    template<class Promise = void>
+    struct coroutine_handle;
+
+    template<>
+    struct coroutine_handle<void>
+    {
+    public:
+        /// Constructors
+        constexpr coroutine_handle() noexcept;
+        constexpr coroutine_handle(nullptr_t) noexcept;
+
+        /// Operators
+        coroutine_handle& operator=(nullptr_t) noexcept;
+        constexpr explicit operator bool() const noexcept;
+        void operator()() const;
+
+        /// Member functions
+        //  Observers
+        bool done() const;
+
+        //  Control
+        void resume() const;
+        void destroy() const;
+
+        //  Import / export
+        constexpr void* address() const noexcept;
+        static constexpr coroutine_handle from_address(void* address);
+    private:
+        void* m_frame;
+    };
+
+    template<class Promise>
+    struct coroutine_handle
+    {
+    public:
+        /// Constructors
+        constexpr coroutine_handle() noexcept;
+        constexpr coroutine_handle(nullptr_t) noexcept;
+
+        static coroutine_handle from_promise(Promise& promise);
+
+        /// Operators
+        coroutine_handle& operator=(nullptr_t) noexcept;
+        constexpr operator coroutine_handle<>() const noexcept;
+        constexpr explicit operator bool() const noexcept;
+        void operator()() const;
+
+        /// Member functions
+        //  Observers
+        bool done() const;
+
+        //  Control
+        void resume() const;
+        void destroy() const;
+
+        //  Promise access
+        Promise& promise() const;
+
+        //  Import / export
+        constexpr void* address() const noexcept;
+        static constexpr coroutine_handle from_address(void* address);
+    private:
+        void* m_frame;
+    };
+
+    /// Extern operators
+    constexpr bool operator==(coroutine_handle<> x, coroutine_handle<> y) noexcept;
+
+
+    // noop_coroutine
+    struct noop_coroutine_promise { };
+
+    template<>
+    struct coroutine_handle<noop_coroutine_promise>
+    {
+    public:
+        /// Operators
+        constexpr operator coroutine_handle<>() const noexcept;
+        constexpr explicit operator bool() const noexcept;
+        constexpr void operator()() const noexcept;
+
+        /// Member functions
+        constexpr bool done() const noexcept;
+        constexpr void resume() const noexcept;
+        constexpr void destroy() const noexcept;
+        noop_coroutine_promise& promise() const noexcept;
+        constexpr void* address() const noexcept;
+    private:
+        friend coroutine_handle noop_coroutine() noexcept;
+
+        explicit coroutine_handle(void* frame) noexcept;
+
+        void* m_frame;
+    };
+
+    using noop_coroutine_handle = coroutine_handle<noop_coroutine_promise>;
+
+    noop_coroutine_handle noop_coroutine() noexcept;
+
+
+    // Trivial awaitables
+    struct suspend_never
+    {
+        constexpr bool await_ready() const noexcept;
+        constexpr void await_suspend(coroutine_handle<>) const noexcept;
+        constexpr void await_resume() const noexcept;
+    };
+
+    struct suspend_always
+    {
+        constexpr bool await_ready() const noexcept;
+        constexpr void await_suspend(coroutine_handle<>) const noexcept;
+        constexpr void await_resume() const noexcept;
+    };
+
+
+    // Frame allocation
+    // Anything with allocate(size) -> void* and deallocate(pointer, size) can back coroutine frames.
+    template<class A>
+    concept coroutine_arena = requires(A& arena, void* pointer, size_t size)
+    {
+        { arena.allocate(size) } -> same_as<void*>;
+        arena.deallocate(pointer, size);
+    };
+
+    // Stack-like arena over a caller-provided buffer. Awaited tasks nest, so their frames are
+    // released in LIFO order and reclaimed immediately; once the buffer is full, frames come
+    // from the global operator new.
+    class frame_arena
+    {
+    public:
+        /// Constructors
+        frame_arena(void* buffer, size_t size) noexcept;
+        frame_arena(const frame_arena&) = delete;
+
+        /// Operators
+        frame_arena& operator=(const frame_arena&) = delete;
+
+        /// Member functions
+        void* allocate(size_t size);
+        void deallocate(void* pointer, size_t size) noexcept;
+
+        // Drops every frame still in the buffer, only valid once none of them is alive.
+        void reset() noexcept;
+        size_t used() const noexcept;
+    private:
+        char* m_begin;
+        char* m_top;
+        char* m_end;
+    };
+
+    namespace detail
+    {
+        // Base for promise types. A coroutine whose parameters start with
+        // (allocator_arg_t, Arena&) - after the implicit object for member coroutines - gets its
+        // frame from that arena; any other coroutine uses the global operator new.
+        // The frame carries a small trailer recording how to free it, so neither the promise
+        // nor the coroutine type depends on the arena type.
+        // None of this gets in the way of Clang's allocation elision: when the coroutine is
+        // inlined into an awaiting caller that destroys it, the whole allocation is removed.
+        struct promise_allocator
+        {
+            static void* operator new(size_t size);
+
+            template<coroutine_arena Arena, class... Args>
+            static void* operator new(size_t size, allocator_arg_t, Arena& arena, Args&...);
+
+            template<class Self, coroutine_arena Arena, class... Args>
+            static void* operator new(size_t size, Self&, allocator_arg_t, Arena& arena, Args&...);
+
+            static void operator delete(void* frame, size_t size) noexcept;
+        };
+    }
+
+
+    // coroutine_handle<void>
+    // Constructors implementations
+    constexpr coroutine_handle<void>::coroutine_handle() noexcept : m_frame(nullptr)
+    {
+    }
+
+    constexpr coroutine_handle<void>::coroutine_handle(nullptr_t) noexcept : m_frame(nullptr)
+    {
+    }
+
+    // Operators
+    inline coroutine_handle<void>& coroutine_handle<void>::operator=(nullptr_t) noexcept
+    {
+        m_frame = nullptr;
+        return *this;
+    }
+
+    constexpr coroutine_handle<void>::operator bool() const noexcept
+    {
+        return m_frame != nullptr;
+    }
+
+    inline void coroutine_handle<void>::operator()() const
+    {
+        resume();
+    }
+
+    // Member functions
+    inline bool coroutine_handle<void>::done() const
+    {
+        return __builtin_coro_done(m_frame);
+    }
+
+    inline void coroutine_handle<void>::resume() const
+    {
+        __builtin_coro_resume(m_frame);
+    }
+
+    inline void coroutine_handle<void>::destroy() const
+    {
+        __builtin_coro_destroy(m_frame);
+    }
+
+    constexpr void* coroutine_handle<void>::address() const noexcept
+    {
+        return m_frame;
+    }
+
+    constexpr coroutine_handle<void> coroutine_handle<void>::from_address(void* address)
+    {
+        coroutine_handle handle;
+        handle.m_frame = address;
+        return handle;
+    }
+
+
+    // coroutine_handle<Promise>
+    // Constructors implementations
+    template<class Promise>
+    constexpr coroutine_handle<Promise>::coroutine_handle() noexcept : m_frame(nullptr)
+    {
+    }
+
+    template<class Promise>
+    constexpr coroutine_handle<Promise>::coroutine_handle(nullptr_t) noexcept : m_frame(nullptr)
+    {
+    }
+
+    template<class Promise>
+    coroutine_handle<Promise> coroutine_handle<Promise>::from_promise(Promise& promise)
+    {
+        coroutine_handle handle;
+        handle.m_frame = __builtin_coro_promise(reinterpret_cast<char*>(&promise), __alignof(Promise), true);
+        return handle;
+    }
+
+    // Operators
+    template<class Promise>
+    coroutine_handle<Promise>& coroutine_handle<Promise>::operator=(nullptr_t) noexcept
+    {
+        m_frame = nullptr;
+        return *this;
+    }
+
+    template<class Promise>
+    constexpr coroutine_handle<Promise>::operator coroutine_handle<>() const noexcept
+    {
+        return coroutine_handle<>::from_address(m_frame);
+    }
+
+    template<class Promise>
+    constexpr coroutine_handle<Promise>::operator bool() const noexcept
+    {
+        return m_frame != nullptr;
+    }
+
+    template<class Promise>
+    void coroutine_handle<Promise>::operator()() const
+    {
+        resume();
+    }
+
+    // Member functions
+    template<class Promise>
+    bool coroutine_handle<Promise>::done() const
+    {
+        return __builtin_coro_done(m_frame);
+    }
+
+    template<class Promise>
+    void coroutine_handle<Promise>::resume() const
+    {
+        __builtin_coro_resume(m_frame);
+    }
+
+    template<class Promise>
+    void coroutine_handle<Promise>::destroy() const
+    {
+        __builtin_coro_destroy(m_frame);
+    }
+
+    template<class Promise>
+    Promise& coroutine_handle<Promise>::promise() const
+    {
+        return *static_cast<Promise*>(__builtin_coro_promise(m_frame, __alignof(Promise), false));
+    }
+
+    template<class Promise>
+    constexpr void* coroutine_handle<Promise>::address() const noexcept
+    {
+        return m_frame;
+    }
+
+    template<class Promise>
+    constexpr coroutine_handle<Promise> coroutine_handle<Promise>::from_address(void* address)
+    {
+        coroutine_handle handle;
+        handle.m_frame = address;
+        return handle;
+    }
+
+    /// Extern operators
+    constexpr bool operator==(coroutine_handle<> x, coroutine_handle<> y) noexcept
+    {
+        return x.address() == y.address();
+    }
+
+
+    // noop_coroutine
+    constexpr coroutine_handle<noop_coroutine_promise>::operator coroutine_handle<>() const noexcept
+    {
+        return coroutine_handle<>::from_address(m_frame);
+    }
+
+    constexpr coroutine_handle<noop_coroutine_promise>::operator bool() const noexcept
+    {
+        return true;
+    }
+
+    constexpr void coroutine_handle<noop_coroutine_promise>::operator()() const noexcept
+    {
+    }
+
+    constexpr bool coroutine_handle<noop_coroutine_promise>::done() const noexcept
+    {
+        return false;
+    }
+
+    constexpr void coroutine_handle<noop_coroutine_promise>::resume() const noexcept
+    {
+    }
+
+    constexpr void coroutine_handle<noop_coroutine_promise>::destroy() const noexcept
+    {
+    }
+
+    constexpr void* coroutine_handle<noop_coroutine_promise>::address() const noexcept
+    {
+        return m_frame;
+    }
+
+
+    // Trivial awaitables
+    constexpr bool suspend_never::await_ready() const noexcept
+    {
+        return true;
+    }
+
+    constexpr void suspend_never::await_suspend(coroutine_handle<>) const noexcept
+    {
+    }
+
+    constexpr void suspend_never::await_resume() const noexcept
+    {
+    }
+
+    constexpr bool suspend_always::await_ready() const noexcept
+    {
+        return false;
+    }
+
+    constexpr void suspend_always::await_suspend(coroutine_handle<>) const noexcept
+    {
+    }
+
+    constexpr void suspend_always::await_resume() const noexcept
+    {
+    }
+
+
+    // promise_allocator
+    namespace detail
+    {
+        struct frame_trailer
+        {
+            void (*deallocate)(void* context, void* frame, size_t size) noexcept;
+            void* context;
+        };
+
+        constexpr size_t frame_trailer_offset(size_t frame_size) noexcept
+        {
+            return (frame_size + alignof(frame_trailer) - 1) & ~(alignof(frame_trailer) - 1);
+        }
+
+        constexpr size_t frame_total_size(size_t frame_size) noexcept
+        {
+            return frame_trailer_offset(frame_size) + sizeof(frame_trailer);
+        }
+
+        inline frame_trailer* frame_trailer_of(void* frame, size_t frame_size) noexcept
+        {
+            return reinterpret_cast<frame_trailer*>(static_cast<char*>(frame) + frame_trailer_offset(frame_size));
+        }
+
+        template<class Arena>
+        void arena_frame_deallocate(void* context, void* frame, size_t size) noexcept
+        {
+            static_cast<Arena*>(context)->deallocate(frame, size);
+        }
+
+        template<coroutine_arena Arena, class... Args>
+        void* promise_allocator::operator new(size_t size, allocator_arg_t, Arena& arena, Args&...)
+        {
+            void* frame = arena.allocate(frame_total_size(size));
+            *frame_trailer_of(frame, size) = { &arena_frame_deallocate<Arena>, &arena };
+            return frame;
+        }
+
+        template<class Self, coroutine_arena Arena, class... Args>
+        void* promise_allocator::operator new(size_t size, Self&, allocator_arg_t, Arena& arena, Args&...)
+        {
+            return operator new(size, allocator_arg, arena);
+        }
+    }
+}
+
+
+#endif //STL_COROUTINE_HPP
@@ -0,0 +1,178 @@
+#ifndef STL_CPU_FEATURES_HPP
+#define STL_CPU_FEATURES_HPP
+
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "utility.hpp"
+
+// Compiles one function for extensions the build flags do not enable. Such a function must
+// only be called once cpu_features() reports them, which is what cpu_dispatch is for.
+#define STL_TARGET(features) [[gnu::target(features)]]
+
+namespace std
+{
+    // x86 extensions the kernels can choose from.
+    enum class cpu_feature : uint32_t
+    {
+        sse2 = 1u << 0,
+        sse3 = 1u << 1,
+        ssse3 = 1u << 2,
+        sse4_1 = 1u << 3,
+        sse4_2 = 1u << 4,
+        popcnt = 1u << 5,
+        lzcnt = 1u << 6,
+        bmi1 = 1u << 7,
+        bmi2 = 1u << 8,
+        avx = 1u << 9,
+        avx2 = 1u << 10,
+        fma = 1u << 11,
+        avx512f = 1u << 12,
+        avx512bw = 1u << 13,
+        avx512vl = 1u << 14
+    };
+
+    class cpu_feature_set
+    {
+    public:
+        /// Constructors
+        constexpr cpu_feature_set() noexcept = default;
+        constexpr cpu_feature_set(cpu_feature feature) noexcept;
+
+        /// Operators
+        constexpr cpu_feature_set operator|(cpu_feature_set other) const noexcept;
+        constexpr bool operator==(const cpu_feature_set& other) const noexcept = default;
+
+        /// Member functions
+        constexpr bool has(cpu_feature feature) const noexcept;
+        constexpr bool contains(cpu_feature_set other) const noexcept;
+        constexpr uint32_t bits() const noexcept;
+    private:
+        uint32_t m_bits = 0;
+    };
+
+    constexpr cpu_feature_set operator|(cpu_feature lhs, cpu_feature rhs) noexcept;
+
+    // Features of the processor running the program, probed with CPUID once by a static
+    // constructor. The register-state extensions (AVX and up) are only reported when XGETBV
+    // shows the firmware or OS has enabled their state, otherwise using them faults.
+    cpu_feature_set cpu_features() noexcept;
+
+    // Picks the best implementation of a kernel for the running processor, the first time it is
+    // called; every later call is a single indirect call. This plays the part of an ELF ifunc,
+    // which a freestanding image has no loader to resolve.
+    //
+    //  using sum_kernel = cpu_dispatch<int(const int*, size_t)>;
+    //  constexpr sum_kernel::variant sum_variants[] = { { cpu_feature::avx2, &sum_avx2 }, { {}, &sum_scalar } };
+    //  constinit sum_kernel sum(sum_variants);
+    template<class Signature>
+    class cpu_dispatch;
+
+    template<class R, class... Args>
+    class cpu_dispatch<R(Args...)>
+    {
+    public:
+        /// Member types
+        using function_type = R (*)(Args...);
+
+        struct variant
+        {
+            cpu_feature_set required;
+            function_type function;
+        };
+
+        /// Constructors
+        // variants are listed best first and must outlive the dispatcher. The last one should
+        // require nothing, so that every processor gets an implementation.
+        template<size_t N>
+        constexpr cpu_dispatch(const variant (&variants)[N]) noexcept;
+
+        /// Operators
+        R operator()(Args... args) const;
+
+        /// Member functions
+        function_type resolve() const noexcept;
+    private:
+        const variant* m_variants;
+        size_t m_count;
+        mutable function_type m_resolved;
+    };
+
+
+    // cpu_feature_set
+    // Constructors implementations
+    constexpr cpu_feature_set::cpu_feature_set(cpu_feature feature) noexcept : m_bits(static_cast<uint32_t>(feature))
+    {
+    }
+
+    // Operators
+    constexpr cpu_feature_set cpu_feature_set::operator|(cpu_feature_set other) const noexcept
+    {
+        cpu_feature_set result;
+        result.m_bits = m_bits | other.m_bits;
+        return result;
+    }
+
+    // Member functions
+    constexpr bool cpu_feature_set::has(cpu_feature feature) const noexcept
+    {
+        return (m_bits & static_cast<uint32_t>(feature)) != 0;
+    }
+
+    constexpr bool cpu_feature_set::contains(cpu_feature_set other) const noexcept
+    {
+        return (m_bits & other.m_bits) == other.m_bits;
+    }
+
+    constexpr uint32_t cpu_feature_set::bits() const noexcept
+    {
+        return m_bits;
+    }
+
+    constexpr cpu_feature_set operator|(cpu_feature lhs, cpu_feature rhs) noexcept
+    {
+        return cpu_feature_set(lhs) | rhs;
+    }
+
+
+    // cpu_dispatch
+    template<class R, class... Args>
+    template<size_t N>
+    constexpr cpu_dispatch<R(Args...)>::cpu_dispatch(const variant (&variants)[N]) noexcept
+        : m_variants(variants), m_count(N), m_resolved(nullptr)
+    {
+    }
+
+    template<class R, class... Args>
+    R cpu_dispatch<R(Args...)>::operator()(Args... args) const
+    {
+        function_type function = __atomic_load_n(&m_resolved, __ATOMIC_RELAXED);
+        if (!function)
+            function = resolve();
+
+        return function(forward<Args>(args)...);
+    }
+
+    // Racing threads all store the same pointer, so the first call needs no lock.
+    template<class R, class... Args>
+    cpu_dispatch<R(Args...)>::function_type cpu_dispatch<R(Args...)>::resolve() const noexcept
+    {
+        const cpu_feature_set available = cpu_features();
+        function_type function = nullptr;
+
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            if (available.contains(m_variants[i].required))
+            {
+                function = m_variants[i].function;
+                break;
+            }
+        }
+
+        __atomic_store_n(&m_resolved, function, __ATOMIC_RELAXED);
+        return function;
+    }
+}
+
+
+#endif //STL_CPU_FEATURES_HPP
@@ -5,7 +5,8 @@
 namespace std
 {
     using nullptr_t = decltype(nullptr);
-    using size_t = unsigned long long;
+    using size_t = decltype(sizeof(0));
+    using ptrdiff_t = decltype(static_cast<int*>(nullptr) - static_cast<int*>(nullptr));
 }
 
 
@@ -0,0 +1,22 @@
+#ifndef STL_CSTDINT_HPP
+#define STL_CSTDINT_HPP
+
+
+namespace std
+{
+    using int8_t = signed char;
+    using int16_t = short;
+    using int32_t = int;
+    using int64_t = long long;
+
+    using uint8_t = unsigned char;
+    using uint16_t = unsigned short;
+    using uint32_t = unsigned int;
+    using uint64_t = unsigned long long;
+
+    using intptr_t = long long;
+    using uintptr_t = unsigned long long;
+}
+
+
+#endif //STL_CSTDINT_HPP
@@ -2,6 +2,12 @@
 #define STL_FUNCTIONAL_HPP
 
 
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "string_view.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
 namespace std
 {
     template<class T = void>
@@ -10,8 +16,200 @@ namespace std
         constexpr bool operator()(const T& lhs, const T& rhs) const;
     };
 
-    // TODO: Implement std::hash
+    template<>
+    struct less<void>
+    {
+        template<class T, class U>
+        constexpr auto operator()(T&& lhs, U&& rhs) const -> decltype(forward<T>(lhs) < forward<U>(rhs));
+    };
+
+    template<class T = void>
+    struct equal_to
+    {
+        constexpr bool operator()(const T& lhs, const T& rhs) const;
+    };
+
+    template<>
+    struct equal_to<void>
+    {
+        template<class T, class U>
+        constexpr auto operator()(T&& lhs, U&& rhs) const -> decltype(forward<T>(lhs) == forward<U>(rhs));
+    };
+
+    template<class T = void>
+    struct plus
+    {
+        constexpr T operator()(const T& lhs, const T& rhs) const;
+    };
+
+    template<>
+    struct plus<void>
+    {
+        template<class T, class U>
+        constexpr auto operator()(T&& lhs, U&& rhs) const -> decltype(forward<T>(lhs) + forward<U>(rhs));
+    };
+
+    template<class T = void>
+    struct multiplies
+    {
+        constexpr T operator()(const T& lhs, const T& rhs) const;
+    };
+
+    template<>
+    struct multiplies<void>
+    {
+        template<class T, class U>
+        constexpr auto operator()(T&& lhs, U&& rhs) const -> decltype(forward<T>(lhs) * forward<U>(rhs));
+    };
+
+    template<class T>
+    constexpr bool less<T>::operator()(const T& lhs, const T& rhs) const
+    {
+        return lhs < rhs;
+    }
+
+    template<class T, class U>
+    constexpr auto less<void>::operator()(T&& lhs, U&& rhs) const -> decltype(forward<T>(lhs) < forward<U>(rhs))
+    {
+        return forward<T>(lhs) < forward<U>(rhs);
+    }
+
+    template<class T>
+    constexpr bool equal_to<T>::operator()(const T& lhs, const T& rhs) const
+    {
+        return lhs == rhs;
+    }
+
+    template<class T, class U>
+    constexpr auto equal_to<void>::operator()(T&& lhs, U&& rhs) const -> decltype(forward<T>(lhs) == forward<U>(rhs))
+    {
+        return forward<T>(lhs) == forward<U>(rhs);
+    }
+
+    template<class T>
+    constexpr T plus<T>::operator()(const T& lhs, const T& rhs) const
+    {
+        return lhs + rhs;
+    }
+
+    template<class T, class U>
+    constexpr auto plus<void>::operator()(T&& lhs, U&& rhs) const -> decltype(forward<T>(lhs) + forward<U>(rhs))
+    {
+        return forward<T>(lhs) + forward<U>(rhs);
+    }
+
+    template<class T>
+    constexpr T multiplies<T>::operator()(const T& lhs, const T& rhs) const
+    {
+        return lhs * rhs;
+    }
+
+    template<class T, class U>
+    constexpr auto multiplies<void>::operator()(T&& lhs, U&& rhs) const -> decltype(forward<T>(lhs) * forward<U>(rhs))
+    {
+        return forward<T>(lhs) * forward<U>(rhs);
+    }
+
+    // Hash function objects.
+    // Integers, enums and pointers hash to their own value, as in the usual implementations; a
+    // table that indexes with the low bits must scramble them first (detail::hash_mix). Strings
+    // are hashed a word at a time. hash<T> is left undefined for any other T.
+    template<class T>
+    struct hash;
+
+    template<class T> requires is_integral_v<T> || is_enum_v<T>
+    struct hash<T>
+    {
+        constexpr size_t operator()(T value) const noexcept;
+    };
+
+    template<class T> requires is_floating_point_v<T>
+    struct hash<T>
+    {
+        size_t operator()(T value) const noexcept;
+    };
+
+    template<class T>
+    struct hash<T*>
+    {
+        size_t operator()(T* pointer) const noexcept;
+    };
+
+    template<>
+    struct hash<nullptr_t>
+    {
+        constexpr size_t operator()(nullptr_t) const noexcept;
+    };
+
+    template<class CharT>
+    struct hash<basic_string_view<CharT>>
+    {
+        size_t operator()(basic_string_view<CharT> str) const noexcept;
+    };
+
+    namespace detail
+    {
+        // Hash of size bytes, every one of them mattering to every bit of the result.
+        size_t hash_bytes(const void* data, size_t size, size_t seed = 0) noexcept;
+
+        inline constexpr uint64_t hash_multiplier = 0x9E3779B97F4A7C15ull;
+        inline constexpr uint64_t hash_secret = 0xE7037ED1A0B428DBull;
+
+        // Both halves of the 128-bit product folded together: every input bit reaches most of
+        // the output bits in one multiplication.
+        constexpr uint64_t hash_fold(uint64_t lhs, uint64_t rhs) noexcept
+        {
+            const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+            return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+        }
+
+        // Spreads a hash value over all its bits, for tables indexing with a few of them.
+        constexpr size_t hash_mix(size_t hash) noexcept
+        {
+            return hash_fold(hash, hash_multiplier);
+        }
+    }
+
+
+    // hash
+    template<class T> requires is_integral_v<T> || is_enum_v<T>
+    constexpr size_t hash<T>::operator()(T value) const noexcept
+    {
+        return static_cast<size_t>(value);
+    }
+
+    template<class T> requires is_floating_point_v<T>
+    size_t hash<T>::operator()(T value) const noexcept
+    {
+        // +0.0 and -0.0 compare equal, so they must hash alike.
+        if (value == T(0))
+            return 0;
+
+        if constexpr (sizeof(T) == sizeof(uint32_t))
+            return __builtin_bit_cast(uint32_t, value);
+        else if constexpr (sizeof(T) == sizeof(uint64_t))
+            return __builtin_bit_cast(uint64_t, value);
+        else
+            return __builtin_bit_cast(uint64_t, static_cast<double>(value)); // the padding of long double is undefined
+    }
+
+    template<class T>
+    size_t hash<T*>::operator()(T* pointer) const noexcept
+    {
+        return reinterpret_cast<size_t>(pointer);
+    }
+
+    constexpr size_t hash<nullptr_t>::operator()(nullptr_t) const noexcept
+    {
+        return 0;
+    }
+
+    template<class CharT>
+    size_t hash<basic_string_view<CharT>>::operator()(basic_string_view<CharT> str) const noexcept
+    {
+        return detail::hash_bytes(str.data(), str.size() * sizeof(CharT));
+    }
 }
 
 
-#endif //STL_FUNCTIONAL_HPP
\ No newline at end of file
+#endif //STL_FUNCTIONAL_HPP
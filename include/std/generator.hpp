@@ -0,0 +1,240 @@
+#ifndef STL_GENERATOR_HPP
+#define STL_GENERATOR_HPP
+
+
+#include "cstddef.hpp"
+#include "coroutine.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+
+namespace std
+{
+    // Lazy sequence produced by co_yield. Yielded values are not copied: the promise keeps a
+    // pointer to them, which stays valid until the consumer advances the iterator.
+    template<class T>
+    class generator
+    {
+    public:
+        /// Member types
+        using value_type = remove_reference_t<T>;
+        using reference = value_type&;
+        using pointer = value_type*;
+
+        class promise_type : public detail::promise_allocator
+        {
+        public:
+            /// Member functions
+            generator get_return_object() noexcept;
+            suspend_always initial_suspend() const noexcept;
+            suspend_always final_suspend() const noexcept;
+            suspend_always yield_value(value_type& value) noexcept;
+            suspend_always yield_value(value_type&& value) noexcept;
+            void return_void() const noexcept;
+            void unhandled_exception() const;
+
+            // A generator is resumed by its consumer only, it cannot await anything itself.
+            template<class U>
+            void await_transform(U&&) = delete;
+        private:
+            friend class generator;
+
+            pointer m_value;
+        };
+
+        class iterator
+        {
+        public:
+            /// Member types
+            using value_type = generator::value_type;
+            using difference_type = ptrdiff_t;
+            using reference = generator::reference;
+            using pointer = generator::pointer;
+            using iterator_category = input_iterator_tag;
+
+            /// Constructors
+            iterator() noexcept;
+            explicit iterator(coroutine_handle<promise_type> handle) noexcept;
+
+            /// Operators
+            reference operator*() const noexcept;
+            pointer operator->() const noexcept;
+            iterator& operator++();
+            void operator++(int);
+            bool operator==(default_sentinel_t) const noexcept;
+        private:
+            coroutine_handle<promise_type> m_handle;
+        };
+
+        /// Constructors
+        generator(const generator&) = delete;
+        generator(generator&& other) noexcept;
+
+        /// Destructor
+        ~generator();
+
+        /// Operators
+        generator& operator=(const generator&) = delete;
+        generator& operator=(generator&& other) noexcept;
+
+        /// Member functions
+        //  Iterators (begin() starts the coroutine, and may only be called once)
+        iterator begin();
+        default_sentinel_t end() const noexcept;
+    private:
+        explicit generator(coroutine_handle<promise_type> handle) noexcept;
+
+        coroutine_handle<promise_type> m_handle;
+    };
+
+
+    // generator::promise_type
+    template<class T>
+    generator<T> generator<T>::promise_type::get_return_object() noexcept
+    {
+        return generator(coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    template<class T>
+    suspend_always generator<T>::promise_type::initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    template<class T>
+    suspend_always generator<T>::promise_type::final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    template<class T>
+    suspend_always generator<T>::promise_type::yield_value(value_type& value) noexcept
+    {
+        m_value = &value;
+        return {};
+    }
+
+    template<class T>
+    suspend_always generator<T>::promise_type::yield_value(value_type&& value) noexcept
+    {
+        // The temporary lives until the end of the co_yield expression, that is past the next resume.
+        m_value = &value;
+        return {};
+    }
+
+    template<class T>
+    void generator<T>::promise_type::return_void() const noexcept
+    {
+    }
+
+    template<class T>
+    void generator<T>::promise_type::unhandled_exception() const
+    {
+#if defined(__cpp_exceptions)
+        throw;
+#else
+        __builtin_trap();
+#endif
+    }
+
+
+    // generator::iterator
+    // Constructors implementations
+    template<class T>
+    generator<T>::iterator::iterator() noexcept : m_handle(nullptr)
+    {
+    }
+
+    template<class T>
+    generator<T>::iterator::iterator(coroutine_handle<promise_type> handle) noexcept : m_handle(handle)
+    {
+    }
+
+    // Operators
+    template<class T>
+    generator<T>::reference generator<T>::iterator::operator*() const noexcept
+    {
+        return *m_handle.promise().m_value;
+    }
+
+    template<class T>
+    generator<T>::pointer generator<T>::iterator::operator->() const noexcept
+    {
+        return m_handle.promise().m_value;
+    }
+
+    template<class T>
+    generator<T>::iterator& generator<T>::iterator::operator++()
+    {
+        m_handle.resume();
+        return *this;
+    }
+
+    template<class T>
+    void generator<T>::iterator::operator++(int)
+    {
+        ++*this;
+    }
+
+    template<class T>
+    bool generator<T>::iterator::operator==(default_sentinel_t) const noexcept
+    {
+        return !m_handle || m_handle.done();
+    }
+
+
+    // generator
+    // Constructors implementations
+    template<class T>
+    generator<T>::generator(coroutine_handle<promise_type> handle) noexcept : m_handle(handle)
+    {
+    }
+
+    template<class T>
+    generator<T>::generator(generator&& other) noexcept : m_handle(other.m_handle)
+    {
+        other.m_handle = nullptr;
+    }
+
+    // Destructor
+    template<class T>
+    generator<T>::~generator()
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    // Operators
+    template<class T>
+    generator<T>& generator<T>::operator=(generator&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_handle)
+                m_handle.destroy();
+
+            m_handle = other.m_handle;
+            other.m_handle = nullptr;
+        }
+
+        return *this;
+    }
+
+    // Member functions
+    template<class T>
+    generator<T>::iterator generator<T>::begin()
+    {
+        if (m_handle)
+            m_handle.resume();
+
+        return iterator(m_handle);
+    }
+
+    template<class T>
+    default_sentinel_t generator<T>::end() const noexcept
+    {
+        return default_sentinel;
+    }
+}
+
+
+#endif //STL_GENERATOR_HPP
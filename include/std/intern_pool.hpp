@@ -0,0 +1,238 @@
+#ifndef STL_INTERN_POOL_HPP
+#define STL_INTERN_POOL_HPP
+
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "functional.hpp"
+#include "section.hpp"
+#include "string_view.hpp"
+
+namespace std
+{
+    // Handle of a string interned by an intern_pool. Two atoms of the same pool are equal exactly
+    // when their strings are, so comparing them is one integer compare. Atoms of different pools
+    // must not be mixed. The default constructed atom is null and names no string.
+    class atom
+    {
+    public:
+        /// Constructors
+        constexpr atom() noexcept = default;
+        constexpr explicit atom(uint32_t id) noexcept;
+
+        /// Operators
+        constexpr bool operator==(const atom& other) const noexcept = default;
+        constexpr explicit operator bool() const noexcept;
+
+        /// Member functions
+        constexpr uint32_t id() const noexcept;
+    private:
+        uint32_t m_id = 0;
+    };
+
+    template<>
+    struct hash<atom>
+    {
+        constexpr size_t operator()(atom value) const noexcept;
+    };
+
+    namespace detail
+    {
+        inline constexpr uint32_t intern_none = static_cast<uint32_t>(-1);
+        inline constexpr size_t intern_first_segment = 64;     // entries, doubling from one segment to the next
+        inline constexpr size_t intern_segment_count = 27;
+        inline constexpr size_t intern_block_size = 4096;
+        inline constexpr size_t intern_cache_line = 64;
+
+        struct intern_entry
+        {
+            const char* data;
+            size_t size;
+        };
+
+        // One shard of a pool: the text of its strings, packed into arena blocks, an entry per
+        // string, and an open-addressing index over them. Entries live in segments that never
+        // move, so reading one needs no lock even while the shard grows.
+        class alignas(intern_cache_line) intern_shard
+        {
+        public:
+            /// Constructors
+            intern_shard() noexcept;
+            intern_shard(const intern_shard&) = delete;
+
+            /// Destructor
+            ~intern_shard();
+
+            /// Operators
+            intern_shard& operator=(const intern_shard&) = delete;
+
+            /// Member functions
+            // Index of text in the shard, added when absent; intern_none when out of memory or
+            // when the shard already holds limit strings.
+            uint32_t intern(string_view text, size_t hash, uint32_t limit) noexcept;
+            // Index of text, intern_none when absent.
+            uint32_t find(string_view text, size_t hash) const noexcept;
+            const intern_entry& entry(uint32_t index) const noexcept;
+            uint32_t size() const noexcept;
+
+            void lock() noexcept;
+            void unlock() noexcept;
+        private:
+            // Slot of text in m_index: the one holding it, or the empty one it would go to.
+            size_t probe(string_view text, size_t hash) const noexcept;
+            bool grow_index() noexcept;
+            const char* store(string_view text) noexcept;
+
+            intern_entry* m_segments[intern_segment_count];
+            uint64_t* m_index;         // (hash << 32) | (index + 1), 0 for an empty slot
+            size_t m_index_capacity;   // power of two
+            uint32_t m_count;
+            char* m_cursor;            // free space of the current arena block
+            size_t m_available;
+            void* m_blocks;            // every arena block, linked through their first word
+            bool m_lock;
+        };
+    }
+
+    // Deduplicating string table: intern copies each distinct string once into an arena and
+    // returns its atom, view gives the string back (NUL terminated, so view(a).data() is also a
+    // C string). Strings stay valid, at a fixed address, until the pool is destroyed.
+    //
+    // The concurrent form splits the strings over 16 shards picked by hash, each with its own
+    // lock, so that threads interning different strings rarely meet. view never locks in either
+    // form.
+    template<bool ThreadSafe = false>
+    class basic_intern_pool
+    {
+    public:
+        /// Constructors
+        basic_intern_pool() noexcept;
+        basic_intern_pool(const basic_intern_pool&) = delete;
+
+        /// Operators
+        basic_intern_pool& operator=(const basic_intern_pool&) = delete;
+
+        /// Member functions
+        // The atom of text, interning it first if needed. A null atom when out of memory.
+        atom intern(string_view text) noexcept;
+        // The atom of text if it was interned, a null atom otherwise.
+        atom find(string_view text) const noexcept;
+        // The string of an atom of this pool, an empty string for the null atom.
+        string_view view(atom value) const noexcept;
+        // The number of distinct strings.
+        size_t size() const noexcept;
+    private:
+        static constexpr uint32_t shard_bits = ThreadSafe ? 4 : 0;
+        static constexpr uint32_t shard_count = uint32_t(1) << shard_bits;
+
+        static uint32_t shard_of(size_t hash) noexcept;
+
+        mutable detail::intern_shard m_shards[shard_count];
+    };
+
+    using intern_pool = basic_intern_pool<false>;
+    using concurrent_intern_pool = basic_intern_pool<true>;
+
+
+    // atom
+    // Constructors implementations
+    constexpr atom::atom(uint32_t id) noexcept : m_id(id)
+    {
+    }
+
+    // Operators
+    constexpr atom::operator bool() const noexcept
+    {
+        return m_id != 0;
+    }
+
+    // Member functions
+    constexpr uint32_t atom::id() const noexcept
+    {
+        return m_id;
+    }
+
+
+    // hash<atom>
+    // Operators
+    constexpr size_t hash<atom>::operator()(atom value) const noexcept
+    {
+        return value.id();
+    }
+
+
+    // basic_intern_pool
+    // Constructors implementations
+    template<bool ThreadSafe>
+    basic_intern_pool<ThreadSafe>::basic_intern_pool() noexcept : m_shards()
+    {
+    }
+
+    // Member functions
+    template<bool ThreadSafe>
+    STL_HOT atom basic_intern_pool<ThreadSafe>::intern(string_view text) noexcept
+    {
+        const size_t hash = detail::hash_bytes(text.data(), text.size());
+        const uint32_t shard = shard_of(hash);
+
+        if constexpr (ThreadSafe)
+            m_shards[shard].lock();
+
+        // An atom is ((index + 1) << shard_bits) | shard, which must fit in 32 bits.
+        const uint32_t index = m_shards[shard].intern(text, hash, (detail::intern_none >> shard_bits) - 1);
+
+        if constexpr (ThreadSafe)
+            m_shards[shard].unlock();
+
+        return index == detail::intern_none ? atom() : atom(((index + 1) << shard_bits) | shard);
+    }
+
+    template<bool ThreadSafe>
+    atom basic_intern_pool<ThreadSafe>::find(string_view text) const noexcept
+    {
+        const size_t hash = detail::hash_bytes(text.data(), text.size());
+        const uint32_t shard = shard_of(hash);
+
+        if constexpr (ThreadSafe)
+            m_shards[shard].lock();
+
+        const uint32_t index = m_shards[shard].find(text, hash);
+
+        if constexpr (ThreadSafe)
+            m_shards[shard].unlock();
+
+        return index == detail::intern_none ? atom() : atom(((index + 1) << shard_bits) | shard);
+    }
+
+    template<bool ThreadSafe>
+    STL_HOT string_view basic_intern_pool<ThreadSafe>::view(atom value) const noexcept
+    {
+        if (!value)
+            return string_view();
+
+        const detail::intern_entry& entry = m_shards[value.id() & (shard_count - 1)].entry((value.id() >> shard_bits) - 1);
+        return string_view(entry.data, entry.size);
+    }
+
+    template<bool ThreadSafe>
+    size_t basic_intern_pool<ThreadSafe>::size() const noexcept
+    {
+        size_t count = 0;
+        for (const detail::intern_shard& shard : m_shards)
+            count += shard.size();
+        return count;
+    }
+
+    template<bool ThreadSafe>
+    uint32_t basic_intern_pool<ThreadSafe>::shard_of(size_t hash) noexcept
+    {
+        // The high bits: the low ones index the shard's table.
+        if constexpr (shard_bits == 0)
+            return 0;
+        else
+            return static_cast<uint32_t>(hash >> (sizeof(size_t) * 8 - shard_bits));
+    }
+}
+
+
+#endif //STL_INTERN_POOL_HPP
@@ -7,6 +7,8 @@
 
 
 #include "concepts.hpp"
+#include "cstddef.hpp"
+#include "type_traits.hpp"
 
 namespace std
 {
@@ -41,6 +43,159 @@ namespace std
         using reference = Reference;
         using iterator_category = Category;
     };
+
+    // Sentinels
+    struct default_sentinel_t { };
+
+    inline constexpr default_sentinel_t default_sentinel{};
+
+
+    // Associated types (there is no iterator_traits: only the member typedefs are looked at, and
+    // the cv-ref qualifiers are stripped by the aliases)
+    template<class I>
+    struct incrementable_traits { };
+
+    template<class T> requires is_object_v<T>
+    struct incrementable_traits<T*> { using difference_type = ptrdiff_t; };
+
+    template<class I> requires requires { typename I::difference_type; }
+    struct incrementable_traits<I> { using difference_type = I::difference_type; };
+
+    template<class I>
+    using iter_difference_t = incrementable_traits<remove_cvref_t<I>>::difference_type;
+
+    template<class I>
+    struct indirectly_readable_traits { };
+
+    template<class T> requires is_object_v<T>
+    struct indirectly_readable_traits<T*> { using value_type = remove_cv_t<T>; };
+
+    template<class I> requires is_array_v<I>
+    struct indirectly_readable_traits<I> { using value_type = remove_cv_t<remove_reference_t<decltype(declval<I&>()[0])>>; };
+
+    template<class I> requires requires { typename I::value_type; }
+    struct indirectly_readable_traits<I> { using value_type = remove_cv_t<typename I::value_type>; };
+
+    template<class I> requires requires { typename I::element_type; } && (!requires { typename I::value_type; })
+    struct indirectly_readable_traits<I> { using value_type = remove_cv_t<typename I::element_type>; };
+
+    template<class I>
+    using iter_value_t = indirectly_readable_traits<remove_cvref_t<I>>::value_type;
+
+    template<class I>
+    using iter_reference_t = decltype(*declval<I&>());
+
+    template<class I>
+    using iter_rvalue_reference_t = decltype(move(*declval<I&>()));
+
+
+    // Iterator concepts
+    namespace detail
+    {
+        template<class T>
+        concept referenceable = requires { typename type_identity<T&>::type; };
+
+        // ITER_CONCEPT: iterator_concept, then iterator_category, and pointers are contiguous.
+        template<class I>
+        struct iter_concept { };
+
+        template<class I>
+        concept has_iterator_concept = requires { typename I::iterator_concept; };
+
+        template<class I> requires has_iterator_concept<I>
+        struct iter_concept<I> { using type = I::iterator_concept; };
+
+        template<class I> requires (!has_iterator_concept<I>) && requires { typename I::iterator_category; }
+        struct iter_concept<I> { using type = I::iterator_category; };
+
+        template<class T>
+        struct iter_concept<T*> { using type = contiguous_iterator_tag; };
+
+        template<class I>
+        using iter_concept_t = iter_concept<I>::type;
+
+        template<class I, class Tag>
+        concept iter_concept_derived_from = requires { typename iter_concept_t<I>; }
+                                            && derived_from<iter_concept_t<I>, Tag>;
+    }
+
+    template<class I>
+    concept indirectly_readable = requires(const I iterator)
+    {
+        typename iter_value_t<I>;
+        typename iter_reference_t<I>;
+        typename iter_rvalue_reference_t<I>;
+        { *iterator } -> same_as<iter_reference_t<I>>;
+    };
+
+    template<class I>
+    concept weakly_incrementable = movable<I> && requires(I iterator)
+    {
+        typename iter_difference_t<I>;
+        requires signed_integral<iter_difference_t<I>>;
+        { ++iterator } -> same_as<I&>;
+        iterator++;
+    };
+
+    template<class I>
+    concept incrementable = regular<I> && weakly_incrementable<I> && requires(I iterator)
+    {
+        { iterator++ } -> same_as<I>;
+    };
+
+    template<class I>
+    concept input_or_output_iterator = weakly_incrementable<I> && requires(I iterator)
+    {
+        { *iterator } -> detail::referenceable;
+    };
+
+    template<class S, class I>
+    concept sentinel_for = semiregular<S> && input_or_output_iterator<I> && detail::weakly_equality_comparable_with<S, I>;
+
+    template<class S, class I>
+    concept sized_sentinel_for = sentinel_for<S, I> && requires(const I& iterator, const S& sentinel)
+    {
+        { sentinel - iterator } -> same_as<iter_difference_t<I>>;
+        { iterator - sentinel } -> same_as<iter_difference_t<I>>;
+    };
+
+    template<class I>
+    concept input_iterator = input_or_output_iterator<I> && indirectly_readable<I>
+                             && detail::iter_concept_derived_from<I, input_iterator_tag>;
+
+    template<class I>
+    concept forward_iterator = input_iterator<I> && detail::iter_concept_derived_from<I, forward_iterator_tag>
+                               && incrementable<I> && sentinel_for<I, I>;
+
+    template<class I>
+    concept bidirectional_iterator = forward_iterator<I> && detail::iter_concept_derived_from<I, bidirectional_iterator_tag>
+                                     && requires(I iterator)
+    {
+        { --iterator } -> same_as<I&>;
+        { iterator-- } -> same_as<I>;
+    };
+
+    template<class I>
+    concept random_access_iterator = bidirectional_iterator<I> && detail::iter_concept_derived_from<I, random_access_iterator_tag>
+                                     && totally_ordered<I> && sized_sentinel_for<I, I>
+                                     && requires(I iterator, const I constant, const iter_difference_t<I> offset)
+    {
+        { iterator += offset } -> same_as<I&>;
+        { constant + offset } -> same_as<I>;
+        { offset + constant } -> same_as<I>;
+        { iterator -= offset } -> same_as<I&>;
+        { constant - offset } -> same_as<I>;
+        { constant[offset] } -> same_as<iter_reference_t<I>>;
+    };
+
+    // Contiguous iterators are what SIMD code can lower to a pointer and a length.
+    template<class I>
+    concept contiguous_iterator = random_access_iterator<I> && detail::iter_concept_derived_from<I, contiguous_iterator_tag>
+                                  && is_lvalue_reference_v<iter_reference_t<I>>
+                                  && same_as<iter_value_t<I>, remove_cvref_t<iter_reference_t<I>>>;
+
+    template<class F, class I>
+    concept indirect_unary_predicate = indirectly_readable<I> && copy_constructible<F> && predicate<F&, iter_reference_t<I>>;
 }
 
 
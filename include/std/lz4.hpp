@@ -0,0 +1,196 @@
+#ifndef STL_LZ4_HPP
+#define STL_LZ4_HPP
+
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "span.hpp"
+
+// LZ4 block and frame formats (lz4.org), as written by the reference lz4 tool.
+// Decoding is freestanding and never allocates: blocks decode into caller buffers, frames
+// through a caller-provided workspace. Compression is host-only, for the build step producing
+// the compressed blobs.
+namespace std
+{
+    inline constexpr size_t lz4_error = static_cast<size_t>(-1);
+    inline constexpr size_t lz4_max_distance = 65535;
+
+    enum class lz4_block_size : uint8_t
+    {
+        max_64kb = 4,
+        max_256kb = 5,
+        max_1mb = 6,
+        max_4mb = 7
+    };
+
+    enum class lz4_status
+    {
+        done,           // the frame ended, and everything it holds was written out
+        need_input,     // input was used up, call again with more
+        output_full,    // output was filled, call again with more room
+        error           // malformed or corrupted frame, or a workspace too small for its blocks
+    };
+
+    constexpr size_t lz4_block_bytes(lz4_block_size size) noexcept;
+
+    namespace detail
+    {
+        inline constexpr size_t lz4_history = 65536;
+
+        // XXH32, the checksum of the frame format, over data arriving in pieces.
+        class lz4_xxh32_state
+        {
+        public:
+            /// Constructors
+            explicit lz4_xxh32_state(uint32_t seed = 0) noexcept;
+
+            /// Member functions
+            void reset(uint32_t seed = 0) noexcept;
+            void update(const void* data, size_t size) noexcept;
+            uint32_t digest() const noexcept;
+        private:
+            uint32_t m_lanes[4];
+            uint8_t m_buffer[16];
+            size_t m_buffered;
+            uint64_t m_total;
+            uint32_t m_seed;
+        };
+
+        uint32_t lz4_xxh32(const void* data, size_t size, uint32_t seed = 0) noexcept;
+
+        // Decodes source at destination + position; matches may refer back to destination +
+        // history. Returns the new position or lz4_error.
+        size_t lz4_decode(const uint8_t* source, size_t size, uint8_t* destination, size_t history, size_t position, size_t capacity) noexcept;
+    }
+
+    // Decodes one block into destination and returns the decoded size, lz4_error when the block
+    // is malformed or does not fit. Bytes of destination past the decoded size may be
+    // overwritten: literals and matches are copied 8 or 16 bytes at a time whenever there is
+    // room for it, overlapping matches included.
+    size_t lz4_decompress_block(span<const char> source, span<char> destination) noexcept;
+
+    // Incremental frame decoder: each call consumes what it can of input and fills what it can
+    // of output, advancing both spans past the bytes used, so data can be parsed chunk by chunk
+    // while it is being decompressed. Checksums present in the frame are verified, skippable
+    // frames are skipped, dictionaries are not supported.
+    //
+    // The workspace holds a compressed block arriving in pieces and the decoded blocks, with
+    // the 64 KiB they may refer back to when the frame links its blocks; workspace_size gives
+    // the minimum for a block size. A larger workspace moves that history less often.
+    class lz4_frame_decoder
+    {
+    public:
+        /// Constructors
+        explicit lz4_frame_decoder(span<char> workspace) noexcept;
+        lz4_frame_decoder(const lz4_frame_decoder&) = delete;
+
+        /// Operators
+        lz4_frame_decoder& operator=(const lz4_frame_decoder&) = delete;
+
+        /// Member functions
+        static constexpr size_t workspace_size(lz4_block_size block_size = lz4_block_size::max_4mb, bool linked = true) noexcept;
+
+        lz4_status decompress(span<const char>& input, span<char>& output) noexcept;
+
+        // Prepares for the next frame, after done or error.
+        void reset() noexcept;
+
+        // The decoded size the frame header announces, 0 when it has none.
+        uint64_t content_size() const noexcept;
+    private:
+        enum class stage : uint8_t
+        {
+            magic,
+            skippable_size,
+            skip,
+            descriptor,
+            block_size,
+            block_data,
+            block_checksum,
+            flush,
+            content_checksum,
+            done,
+            error
+        };
+
+        // Moves input bytes to m_header until it holds size of them.
+        bool gather(span<const char>& input, size_t size) noexcept;
+        bool parse_descriptor() noexcept;
+        void prepare_window() noexcept;
+        bool finish_block(const char* data) noexcept;
+
+        span<char> m_workspace;
+        char* m_staging;            // a compressed block received in pieces
+        char* m_window;             // decoded blocks and their history
+        size_t m_window_size;
+        size_t m_window_used;
+        size_t m_flushed;           // window bytes already written out
+        size_t m_block_max;
+        size_t m_block_size;        // of the current block, as stored
+        size_t m_block_received;
+        bool m_block_compressed;
+        uint8_t m_flags;
+        uint32_t m_block_hash;
+        uint64_t m_content_size;
+        uint64_t m_skip;
+        uint8_t m_header[16];
+        size_t m_header_size;
+        stage m_stage;
+        detail::lz4_xxh32_state m_content_hash;
+    };
+
+// Host-only: the firmware build only decodes.
+#if defined(__linux__) && defined(__x86_64__)
+
+    constexpr size_t lz4_compress_bound(size_t size) noexcept;
+    constexpr size_t lz4_frame_bound(size_t size, lz4_block_size block_size = lz4_block_size::max_64kb) noexcept;
+
+    // Greedy single-pass compression of one block (the reference tool's fast level). Returns
+    // the compressed size, 0 when destination is too small.
+    size_t lz4_compress_block(span<const char> source, span<char> destination) noexcept;
+
+    // A frame of independent blocks, with the content size and content checksum in it. Blocks
+    // that do not shrink are stored uncompressed. Returns the frame size, 0 when destination is
+    // too small.
+    size_t lz4_compress_frame(span<const char> source, span<char> destination, lz4_block_size block_size = lz4_block_size::max_64kb) noexcept;
+
+#endif
+
+
+    // Functions
+    constexpr size_t lz4_block_bytes(lz4_block_size size) noexcept
+    {
+        return size_t(1) << (8 + 2 * static_cast<uint8_t>(size));
+    }
+
+
+    // lz4_frame_decoder
+    // Member functions
+    constexpr size_t lz4_frame_decoder::workspace_size(lz4_block_size block_size, bool linked) noexcept
+    {
+        return 2 * lz4_block_bytes(block_size) + (linked ? detail::lz4_history : 0);
+    }
+
+
+#if defined(__linux__) && defined(__x86_64__)
+
+    // Functions
+    constexpr size_t lz4_compress_bound(size_t size) noexcept
+    {
+        return size + size / 255 + 16;
+    }
+
+    constexpr size_t lz4_frame_bound(size_t size, lz4_block_size block_size) noexcept
+    {
+        const size_t block = lz4_block_bytes(block_size);
+        const size_t blocks = (size + block - 1) / block;
+
+        // Header, the blocks (stored ones at worst) and their sizes, end mark and checksum.
+        return 15 + size + blocks * 4 + 4 + 4;
+    }
+
+#endif
+}
+
+
+#endif //STL_LZ4_HPP
@@ -0,0 +1,136 @@
+#ifndef STL_MAPPED_FILE_HPP
+#define STL_MAPPED_FILE_HPP
+
+
+// Host-only facility: the firmware build has no file system to map from.
+#if defined(__linux__) && defined(__x86_64__)
+
+#include "cstddef.hpp"
+#include "span.hpp"
+#include "string_view.hpp"
+
+namespace std
+{
+    enum class access_hint
+    {
+        normal,
+        sequential,
+        random
+    };
+
+    // Read-only, private mapping of a whole regular file.
+    // The pages are pre-faulted with MAP_POPULATE, so a parser walking the view never stalls
+    // on demand paging, and no byte is ever copied into an owning buffer.
+    class mapped_file
+    {
+    public:
+        /// Constructors
+        mapped_file() noexcept;
+        explicit mapped_file(const char* path, access_hint hint = access_hint::sequential) noexcept;
+        mapped_file(const mapped_file&) = delete;
+        mapped_file(mapped_file&& other) noexcept;
+
+        /// Destructor
+        ~mapped_file();
+
+        /// Operators
+        mapped_file& operator=(const mapped_file&) = delete;
+        mapped_file& operator=(mapped_file&& other) noexcept;
+
+        explicit operator bool() const noexcept;
+
+        /// Member functions
+        //  Modifiers
+        // Fails (returns false) on anything that is not a regular file, use file_input for pipes.
+        bool open(const char* path, access_hint hint = access_hint::sequential) noexcept;
+        // Maps an already open descriptor, which stays owned (and open) on the caller side.
+        bool open_fd(int fd, access_hint hint = access_hint::sequential) noexcept;
+        void close() noexcept;
+        void swap(mapped_file& other) noexcept;
+
+        //  Observers
+        bool is_open() const noexcept;
+        span<const char> bytes() const noexcept;
+        string_view view() const noexcept;
+        size_t size() const noexcept;
+    private:
+        const char* m_data;
+        size_t m_size;
+        bool m_open;
+    };
+
+    // Streams a file descriptor through a caller-provided buffer, one read() per chunk.
+    class chunked_reader
+    {
+    public:
+        /// Constructors
+        chunked_reader(int fd, span<char> buffer) noexcept;
+
+        /// Member functions
+        // Returns the next chunk, an empty span at end of input or on error.
+        span<const char> next() noexcept;
+
+        bool failed() const noexcept;
+    private:
+        int m_fd;
+        span<char> m_buffer;
+        bool m_failed;
+    };
+
+    // Maps regular files and falls back to chunked reads for pipes, FIFOs and character devices.
+    class file_input
+    {
+    public:
+        /// Constructors
+        explicit file_input(span<char> fallback_buffer) noexcept;
+        file_input(const file_input&) = delete;
+
+        /// Destructor
+        ~file_input();
+
+        /// Operators
+        file_input& operator=(const file_input&) = delete;
+
+        /// Member functions
+        bool open(const char* path, access_hint hint = access_hint::sequential) noexcept;
+        bool open_fd(int fd, access_hint hint = access_hint::sequential) noexcept;
+        void close() noexcept;
+
+        bool is_mapped() const noexcept;
+
+        // Calls f(string_view) once for a mapped file, once per chunk otherwise.
+        // Returns false if reading failed part way.
+        template<class F>
+        bool for_each_chunk(F&& f);
+    private:
+        mapped_file m_mapping;
+        span<char> m_buffer;
+        int m_fd;
+        bool m_owns_fd;
+    };
+
+
+    template<class F>
+    bool file_input::for_each_chunk(F&& f)
+    {
+        if (is_mapped())
+        {
+            f(m_mapping.view());
+            return true;
+        }
+
+        if (m_fd < 0)
+            return false;
+
+        chunked_reader reader(m_fd, m_buffer);
+        for (span<const char> chunk = reader.next(); !chunk.empty(); chunk = reader.next())
+            f(string_view(chunk.data(), chunk.size()));
+
+        return !reader.failed();
+    }
+}
+
+#endif
+
+
+#endif //STL_MAPPED_FILE_HPP
@@ -2,12 +2,21 @@
 #define STL_MEMORY_HPP
 
 
+#include "alloc_profile.hpp"
 #include "cstddef.hpp"
+#include "functional.hpp"
+#include "trace.hpp"
 #include "type_traits.hpp"
 #include "utility.hpp"
 
 namespace std
 {
+    // allocator_arg
+    struct allocator_arg_t { explicit allocator_arg_t() = default; };
+
+    inline constexpr allocator_arg_t allocator_arg{};
+
+
     template<class T>
     struct default_delete
     {
@@ -17,10 +26,10 @@ namespace std
         template<class U>
         explicit default_delete(const default_delete<U[]>& d) noexcept;
 
-        void operator()(T* ptr) const;
+        void operator()(T* ptr) const noexcept;
 
         template<class U>
-        void operator()(U* ptr) const;
+        void operator()(U* ptr) const noexcept;
     };
 
     template<class A>
@@ -32,44 +41,53 @@ namespace std
     template<class A>
     concept RValueReferenceType = is_rvalue_reference_v<A>;
 
+    namespace detail
+    {
+        // Deleter::pointer when the deleter names one, T* otherwise.
+        template<class T, class Deleter>
+        struct unique_ptr_pointer
+        {
+            using type = T*;
+        };
+
+        template<class T, class Deleter> requires requires { typename remove_reference_t<Deleter>::pointer; }
+        struct unique_ptr_pointer<T, Deleter>
+        {
+            using type = remove_reference_t<Deleter>::pointer;
+        };
+    }
+
     template<class T, class Deleter = default_delete<T>>
     class unique_ptr
     {
     public:
         /// Member types
-        using pointer = decltype(remove_reference<Deleter>::type::pointer(), T::pointer());
+        using pointer = detail::unique_ptr_pointer<T, Deleter>::type;
         using element_type = T;
         using deleter_type = Deleter;
 
         /// Constructors
-        constexpr unique_ptr();
-        constexpr explicit unique_ptr(nullptr_t ptr) noexcept;
+        constexpr unique_ptr() noexcept;
+        constexpr unique_ptr(nullptr_t ptr) noexcept;
         explicit unique_ptr(pointer p) noexcept;
 
-        template<NonReferenceType A>
-        unique_ptr(pointer p, const A& d) noexcept;
-        template<NonReferenceType A>
-        unique_ptr(pointer p, A&& d) noexcept;
-
-        template<LValueReferenceType A>
-        unique_ptr(pointer p, A& d) noexcept;
-        template<LValueReferenceType A>
-        unique_ptr(pointer p, A&& d) = delete;
+        unique_ptr(pointer p, const Deleter& d) noexcept requires NonReferenceType<Deleter>;
+        unique_ptr(pointer p, remove_reference_t<Deleter>&& d) noexcept requires NonReferenceType<Deleter>;
 
-        template<RValueReferenceType A>
-        unique_ptr(pointer p, const A& d) noexcept;
-        template<RValueReferenceType A>
-        unique_ptr(pointer p, const A&& d) = delete;
+        unique_ptr(pointer p, Deleter d) noexcept requires LValueReferenceType<Deleter>;
+        unique_ptr(pointer p, remove_reference_t<Deleter>&& d) requires LValueReferenceType<Deleter> = delete;
 
+        unique_ptr(const unique_ptr&) = delete;
         unique_ptr(unique_ptr&& u) noexcept;
 
         template<class U, class E>
-        explicit unique_ptr(unique_ptr<U, E>&& u) noexcept;
+        unique_ptr(unique_ptr<U, E>&& u) noexcept;
 
         /// Destructor
         ~unique_ptr();
 
         /// Operators
+        unique_ptr& operator=(const unique_ptr&) = delete;
         unique_ptr& operator=(unique_ptr&& r) noexcept;
         template<class U, class E>
         unique_ptr& operator=(unique_ptr<U,E>&& r) noexcept;
@@ -90,10 +108,7 @@ namespace std
         Deleter& get_deleter() noexcept;
         const Deleter& get_deleter() const noexcept;
     private:
-        template<class U, class E>
-        void transfer_ownership_from(unique_ptr<U, E>&& r);
-
-        element_type* m_element;
+        pointer m_element;
         deleter_type m_deleter;
     };
 
@@ -149,7 +164,369 @@ namespace std
     bool operator>=(nullptr_t, const unique_ptr<T, D>& y);
 
     /// Specialised structs
-    //  TODO: Implement std::hash struct specialization for unique_ptr
+    template<class T, class D>
+    struct hash<unique_ptr<T, D>>
+    {
+        size_t operator()(const unique_ptr<T, D>& ptr) const noexcept;
+    };
+
+
+    // default_delete
+    template<class T>
+    template<class U>
+    default_delete<T>::default_delete(const default_delete<U> &d) noexcept
+    {
+        static_assert(is_same_v<T*, U*>, "The right class cannot be converted to the left class (cast feature not implemented yet).");
+    }
+
+    template<class T>
+    template<class U>
+    default_delete<T>::default_delete(const default_delete<U[]> &d) noexcept
+    {
+        static_assert(is_same_v<T(*)[], U(*)[]>, "The right class cannot be converted to the left class (cast feature not implemented yet).");
+    }
+
+    template<class T>
+    void default_delete<T>::operator()(T *ptr) const noexcept
+    {
+        STL_TRACE_ZONE(memory, "default_delete");
+        STL_ALLOC_PROFILE_DEALLOCATE(ptr);
+        delete ptr;
+    }
+
+    template<class T>
+    template<class U>
+    void default_delete<T>::operator()(U* ptr) const noexcept
+    {
+        STL_TRACE_ZONE(memory, "default_delete[]");
+        STL_ALLOC_PROFILE_DEALLOCATE(ptr);
+        delete[] ptr;
+    }
+
+
+    namespace detail
+    {
+        template<class Deleter>
+        constexpr void unique_ptr_check_default_deleter() noexcept
+        {
+            static_assert(is_nothrow_default_constructible_v<Deleter>, "Deleter type default constructor should be marked as noexcept");
+            static_assert(!is_pointer_v<Deleter>, "Deleter type cannot be a pointer");
+        }
+    }
+
+
+    // unique_ptr
+    // Constructors implementations
+    template<class T, class Deleter>
+    constexpr unique_ptr<T, Deleter>::unique_ptr() noexcept : m_element(), m_deleter()
+    {
+        detail::unique_ptr_check_default_deleter<Deleter>();
+    }
+
+    template<class T, class Deleter>
+    constexpr unique_ptr<T, Deleter>::unique_ptr(nullptr_t) noexcept : unique_ptr()
+    {
+    }
+
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>::unique_ptr(pointer p) noexcept : m_element(p), m_deleter()
+    {
+        detail::unique_ptr_check_default_deleter<Deleter>();
+    }
+
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>::unique_ptr(pointer p, const Deleter& d) noexcept requires NonReferenceType<Deleter>
+        : m_element(p), m_deleter(d)
+    {
+        static_assert(is_nothrow_copy_constructible_v<Deleter>, "The deleter copy constructor must exist and be marked as noexcept.");
+    }
+
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>::unique_ptr(pointer p, remove_reference_t<Deleter>&& d) noexcept requires NonReferenceType<Deleter>
+        : m_element(p), m_deleter(move(d))
+    {
+        static_assert(is_nothrow_move_constructible_v<Deleter>, "The deleter move constructor must exist and be marked as noexcept.");
+    }
+
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>::unique_ptr(pointer p, Deleter d) noexcept requires LValueReferenceType<Deleter>
+        : m_element(p), m_deleter(d)
+    {
+    }
+
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>::unique_ptr(unique_ptr&& u) noexcept : m_element(u.release()), m_deleter(forward<Deleter>(u.get_deleter()))
+    {
+        if constexpr (!is_reference<Deleter>)
+            static_assert(is_nothrow_move_constructible_v<Deleter>, "The deleter move constructor must exist and be marked as noexcept.");
+    }
+
+    template<class T, class Deleter>
+    template<class U, class E>
+    unique_ptr<T, Deleter>::unique_ptr(unique_ptr<U, E>&& u) noexcept : m_element(u.release()), m_deleter(forward<E>(u.get_deleter()))
+    {
+        static_assert(is_convertible_v<typename unique_ptr<U, E>::pointer, pointer>, "The provided class pointer cannot be converted into this class pointer.");
+        static_assert(!is_array_v<U>, "Cannot transfer the provided value to an array.");
+        static_assert
+        (
+                (is_reference<Deleter> && is_same_v<E, Deleter>) ||
+                (!is_reference<Deleter> && is_convertible_v<E, Deleter>),
+                "Either Deleter must be a reference type and E the same type as Deleter or "
+                "Deleter must not be a reference type and E convertible to Deleter"
+        );
+    }
+
+    // Destructor
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>::~unique_ptr()
+    {
+        static_assert(noexcept(get_deleter()(get())), "Deleter must not throw an exception.");
+
+        if (m_element)
+            get_deleter()(m_element);
+    }
+
+    // Operators
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>& unique_ptr<T, Deleter>::operator=(unique_ptr&& r) noexcept
+    {
+        if constexpr (is_reference<Deleter>)
+            static_assert(is_nothrow_copy_assignable_v<remove_reference_t<Deleter>>, "Deleter must be copy assignable and marked as noexcept.");
+        else
+            static_assert(is_nothrow_move_assignable_v<Deleter>, "Deleter must be move assignable.");
+
+        reset(r.release());
+        get_deleter() = forward<Deleter>(r.get_deleter());
+        return *this;
+    }
+
+    template<class T, class Deleter>
+    template<class U, class E>
+    unique_ptr<T, Deleter>& unique_ptr<T, Deleter>::operator=(unique_ptr<U,E>&& r) noexcept
+    {
+        static_assert(!is_array_v<U>, "The provided element cannot be an array.");
+        static_assert(is_convertible_v<typename unique_ptr<U,E>::pointer, pointer>, "The provided class pointer cannot be converted into this class pointer.");
+        static_assert(is_assignable_v<Deleter&, E&&>, "The provided Deleter cannot be move assigned to this class Deleter.");
+
+        reset(r.release());
+        get_deleter() = forward<E>(r.get_deleter());
+        return *this;
+    }
+
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter> &unique_ptr<T, Deleter>::operator=(nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>::operator bool() const noexcept
+    {
+        return get() != nullptr;
+    }
+
+    template<class T, class Deleter>
+    add_lvalue_reference_t<T> unique_ptr<T, Deleter>::operator*() const noexcept(noexcept(*declval<pointer>()))
+    {
+        return *get();
+    }
+
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>::pointer unique_ptr<T, Deleter>::operator->() const noexcept
+    {
+        return get();
+    }
+
+    // Member functions
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>::pointer unique_ptr<T, Deleter>::release() noexcept
+    {
+        pointer old_ptr = m_element;
+        m_element = pointer();
+        return old_ptr;
+    }
+
+    template<class T, class Deleter>
+    void unique_ptr<T, Deleter>::reset(pointer ptr) noexcept
+    {
+        STL_TRACE_ZONE(memory, "unique_ptr::reset");
+        pointer old_ptr = m_element;
+        m_element = ptr;
+        if (old_ptr) get_deleter()(old_ptr);
+    }
+
+    template<class T, class Deleter>
+    void unique_ptr<T, Deleter>::swap(unique_ptr &other) noexcept
+    {
+        std::swap(m_element, other.m_element);
+        std::swap(m_deleter, other.m_deleter);
+    }
+
+    template<class T, class Deleter>
+    unique_ptr<T, Deleter>::pointer unique_ptr<T, Deleter>::get() const noexcept
+    {
+        return m_element;
+    }
+
+    template<class T, class Deleter>
+    Deleter &unique_ptr<T, Deleter>::get_deleter() noexcept
+    {
+        return m_deleter;
+    }
+
+    template<class T, class Deleter>
+    const Deleter &unique_ptr<T, Deleter>::get_deleter() const noexcept
+    {
+        return m_deleter;
+    }
+
+
+    /// Extern functions
+    template<class T, class... Args>
+    STL_ALLOC_PROFILE_NOINLINE unique_ptr<T> make_unique(Args&&... args)
+    {
+        static_assert(!is_array_v<T>);
+        STL_TRACE_ZONE(memory, "make_unique");
+        T* ptr = new T(forward<Args>(args)...);
+        STL_ALLOC_PROFILE_ALLOCATE(ptr, sizeof(T));
+        return unique_ptr<T>(ptr);
+    }
+
+    template<class T>
+    STL_ALLOC_PROFILE_NOINLINE unique_ptr<T> make_unique_for_overwrite()
+    {
+        STL_TRACE_ZONE(memory, "make_unique_for_overwrite");
+        T* ptr = new T;
+        STL_ALLOC_PROFILE_ALLOCATE(ptr, sizeof(T));
+        return unique_ptr<T>(ptr);
+    }
+
+    template<class T, class D>
+    void swap(unique_ptr<T, D>& lhs, unique_ptr<T, D>& rhs) noexcept
+    {
+        static_assert(is_swappable_v<D>, "The Deleter must be swappable.");
+        lhs.swap(rhs);
+    }
+
+
+    /// Extern operators
+    //  Comparison between unique_ptrs
+    template<class T1, class D1, class T2, class D2>
+    bool operator==(const unique_ptr<T1, D1>& x, const unique_ptr<T2, D2>& y)
+    {
+        return x.get() == y.get();
+    }
+
+    template<class T1, class D1, class T2, class D2>
+    bool operator!=(const unique_ptr<T1, D1>& x, const unique_ptr<T2, D2>& y)
+    {
+        return !(x == y);
+    }
+
+    template<class T1, class D1, class T2, class D2>
+    bool operator<(const unique_ptr<T1, D1>& x, const unique_ptr<T2, D2>& y)
+    {
+        return less<>()(x.get(), y.get());
+    }
+
+    template<class T1, class D1, class T2, class D2>
+    bool operator<=(const unique_ptr<T1, D1>& x, const unique_ptr<T2, D2>& y)
+    {
+        return !(y < x);
+    }
+
+    template<class T1, class D1, class T2, class D2>
+    bool operator>(const unique_ptr<T1, D1>& x, const unique_ptr<T2, D2>& y)
+    {
+        return y < x;
+    }
+
+    template<class T1, class D1, class T2, class D2>
+    bool operator>=(const unique_ptr<T1, D1>& x, const unique_ptr<T2, D2>& y)
+    {
+        return !(x < y);
+    }
+
+    //  Comparison between unique_ptr and nullptr
+    template<class T, class D>
+    bool operator==(const unique_ptr<T, D>& x, nullptr_t) noexcept
+    {
+        return !x;
+    }
+
+    template<class T, class D>
+    bool operator==(nullptr_t, const unique_ptr<T, D>& x) noexcept
+    {
+        return !x;
+    }
+
+    template<class T, class D>
+    bool operator!=(const unique_ptr<T, D>& x, nullptr_t) noexcept
+    {
+        return (bool)x;
+    }
+
+    template<class T, class D>
+    bool operator!=(nullptr_t, const unique_ptr<T, D>& x) noexcept
+    {
+        return (bool)x;
+    }
+
+    template<class T, class D>
+    bool operator<(const unique_ptr<T, D>& x, nullptr_t)
+    {
+        return less<typename unique_ptr<T, D>::pointer>()(x.get(), nullptr);
+    }
+
+    template<class T, class D>
+    bool operator<(nullptr_t, const unique_ptr<T, D>& y)
+    {
+        return less<typename unique_ptr<T, D>::pointer>()(nullptr, y.get());
+    }
+
+    template<class T, class D>
+    bool operator<=(const unique_ptr<T, D>& x, nullptr_t)
+    {
+        return !(nullptr < x);
+    }
+
+    template<class T, class D>
+    bool operator<=(nullptr_t, const unique_ptr<T, D>& y)
+    {
+        return !(y < nullptr);
+    }
+
+    template<class T, class D>
+    bool operator>(const unique_ptr<T, D>& x, nullptr_t)
+    {
+        return nullptr < x;
+    }
+
+    template<class T, class D>
+    bool operator>(nullptr_t, const unique_ptr<T, D>& y)
+    {
+        return y < nullptr;
+    }
+
+    template<class T, class D>
+    bool operator>=(const unique_ptr<T, D>& x, nullptr_t)
+    {
+        return !(x < nullptr);
+    }
+
+    template<class T, class D>
+    bool operator>=(nullptr_t, const unique_ptr<T, D>& y)
+    {
+        return !(nullptr < y);
+    }
+
+    /// Specialised structs
+    template<class T, class D>
+    size_t hash<unique_ptr<T, D>>::operator()(const unique_ptr<T, D>& ptr) const noexcept
+    {
+        return hash<typename unique_ptr<T, D>::pointer>()(ptr.get());
+    }
 }
 
 
@@ -0,0 +1,44 @@
+#ifndef STL_NEW_HPP
+#define STL_NEW_HPP
+
+
+#include "cstddef.hpp"
+
+namespace std
+{
+    struct nothrow_t
+    {
+        explicit nothrow_t() = default;
+    };
+
+    inline constexpr nothrow_t nothrow{};
+}
+
+// The replaceable global forms are implicitly declared in every translation unit, except the
+// nothrow ones. Like the others, those are provided by the platform: they return nullptr on
+// failure, where the plain forms do not return at all.
+[[nodiscard]] void* operator new(std::size_t size, const std::nothrow_t&) noexcept;
+[[nodiscard]] void* operator new[](std::size_t size, const std::nothrow_t&) noexcept;
+void operator delete(void* pointer, const std::nothrow_t&) noexcept;
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept;
+
+[[nodiscard]] inline void* operator new(std::size_t, void* place) noexcept
+{
+    return place;
+}
+
+[[nodiscard]] inline void* operator new[](std::size_t, void* place) noexcept
+{
+    return place;
+}
+
+inline void operator delete(void*, void*) noexcept
+{
+}
+
+inline void operator delete[](void*, void*) noexcept
+{
+}
+
+
+#endif //STL_NEW_HPP
@@ -0,0 +1,686 @@
+#ifndef STL_NUMERIC_HPP
+#define STL_NUMERIC_HPP
+
+
+#include "bit.hpp"
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "span.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace std
+{
+    template<class I>
+    struct min_max_result
+    {
+        I min;
+        I max;
+    };
+
+    // The operations below may regroup and reorder their operands: op must be associative and
+    // commutative, and floating point results can differ from a left to right loop in the last
+    // bits.
+    //
+    // Contiguous ranges of arithmetic values combined with plus, multiplies and less run on
+    // vectors, 32 bytes wide when built with AVX2 and 16 bytes with SSE2, each loop keeping
+    // several independent accumulators. A narrower input type is widened to the accumulator
+    // type when that gives the same result as the scalar loop (summing bytes into a uint64_t
+    // checksum, for instance). Other random access ranges are reduced on four scalar chains,
+    // anything else on a single one.
+
+    /// Reductions
+    template<input_iterator I>
+    iter_value_t<I> reduce(I first, I last);
+    template<input_iterator I, class T>
+    T reduce(I first, I last, T init);
+    template<input_iterator I, class T, class BinaryOp>
+    T reduce(I first, I last, T init, BinaryOp op);
+
+    // init + sum of first1[i] * first2[i]
+    template<input_iterator I1, input_iterator I2, class T>
+    T transform_reduce(I1 first1, I1 last1, I2 first2, T init);
+    template<input_iterator I1, input_iterator I2, class T, class ReduceOp, class TransformOp>
+    T transform_reduce(I1 first1, I1 last1, I2 first2, T init, ReduceOp reduce, TransformOp transform);
+    template<input_iterator I, class T, class ReduceOp, class TransformOp>
+    T transform_reduce(I first, I last, T init, ReduceOp reduce, TransformOp transform);
+
+    /// Prefix sums
+    // result may be first, for an in-place scan. Returns the end of the written range.
+    template<input_iterator I, class O>
+    O inclusive_scan(I first, I last, O result);
+    template<input_iterator I, class O, class BinaryOp>
+    O inclusive_scan(I first, I last, O result, BinaryOp op);
+    template<input_iterator I, class O, class BinaryOp, class T>
+    O inclusive_scan(I first, I last, O result, BinaryOp op, T init);
+
+    // result[i] is init combined with the elements before first[i], result[0] is init.
+    template<input_iterator I, class O, class T>
+    O exclusive_scan(I first, I last, O result, T init);
+    template<input_iterator I, class O, class T, class BinaryOp>
+    O exclusive_scan(I first, I last, O result, T init, BinaryOp op);
+
+    /// Extremes
+    // The first smallest and the last largest element, both last when the range is empty.
+    template<forward_iterator I>
+    min_max_result<I> minmax_element(I first, I last);
+    template<forward_iterator I, class Compare>
+    min_max_result<I> minmax_element(I first, I last, Compare comp);
+
+    /// Span overloads
+    template<class T>
+    remove_cv_t<T> reduce(span<T> values);
+    template<class T, class U>
+    U reduce(span<T> values, U init);
+    template<class T1, class T2, class U>
+    U transform_reduce(span<T1> lhs, span<T2> rhs, U init);
+
+    // output must be at least as long as input.
+    template<class T, class U>
+    U* inclusive_scan(span<T> input, span<U> output);
+    template<class T, class U, class V>
+    U* exclusive_scan(span<T> input, span<U> output, V init);
+
+    template<class T>
+    min_max_result<T*> minmax_element(span<T> values);
+
+
+    namespace detail
+    {
+        // Vector width in bytes, 0 when the kernels are compiled out. The kernels are written with
+        // the compiler's vector extension, which lowers to the widest registers enabled.
+#if defined(__AVX2__)
+        inline constexpr size_t simd_width = 32;
+#elif defined(__SSE2__)
+        inline constexpr size_t simd_width = 16;
+#else
+        inline constexpr size_t simd_width = 0;
+#endif
+
+        template<class T, size_t Lanes>
+        struct simd_vector
+        {
+            typedef T type __attribute__((vector_size(sizeof(T) * Lanes)));
+        };
+
+        template<class T>
+        concept simd_arithmetic = simd_width != 0 && is_arithmetic_v<T> && !is_same_v<T, bool> && sizeof(T) <= 8;
+
+        // Converting every From to To before adding gives the same result as the scalar loop,
+        // which adds From values to a To.
+        template<class From, class To>
+        concept simd_sum_exact = simd_arithmetic<From> && simd_arithmetic<To>
+                                 && (is_same_v<From, To>
+                                     || (is_integral_v<From> && is_integral_v<To> && sizeof(From) <= sizeof(To))
+                                     || (is_same_v<From, float> && is_same_v<To, double>));
+
+        // Same for products, which the scalar loop computes in the promoted type of From: only
+        // types narrower than int can be widened further without changing the result.
+        template<class From, class To>
+        concept simd_product_exact = simd_arithmetic<From> && simd_arithmetic<To>
+                                     && (is_same_v<From, To>
+                                         || (is_integral_v<From> && is_integral_v<To> && sizeof(From) < sizeof(int)
+                                             && sizeof(From) <= sizeof(To)));
+
+        template<class Op, class T>
+        concept simd_plus = is_same_v<Op, plus<>> || is_same_v<Op, plus<T>>;
+
+        template<class Op, class T>
+        concept simd_multiplies = is_same_v<Op, multiplies<>> || is_same_v<Op, multiplies<T>>;
+
+        template<class Compare, class T>
+        concept simd_less = is_same_v<Compare, less<>> || is_same_v<Compare, less<T>>;
+
+        template<class Vector, class T>
+        inline Vector simd_load(const T* source) noexcept
+        {
+            Vector value;
+            __builtin_memcpy(&value, source, sizeof(value));
+            return value;
+        }
+
+        template<class Vector, class T>
+        inline void simd_store(T* destination, Vector value) noexcept
+        {
+            __builtin_memcpy(destination, &value, sizeof(value));
+        }
+
+        // Loads Lanes values of From, widened to To.
+        template<class To, size_t Lanes, class From>
+        inline simd_vector<To, Lanes>::type simd_load_as(const From* source) noexcept
+        {
+            using narrow = simd_vector<From, Lanes>::type;
+            using wide = simd_vector<To, Lanes>::type;
+
+            return __builtin_convertvector(simd_load<narrow>(source), wide);
+        }
+
+        template<class Vector, class T>
+        inline Vector simd_broadcast(T value) noexcept
+        {
+            Vector result;
+            for (size_t lane = 0; lane < sizeof(Vector) / sizeof(T); ++lane)
+                result[lane] = value;
+
+            return result;
+        }
+
+        // One bit per byte of the mask, set for the true lanes.
+        template<class Vector>
+        inline uint32_t simd_mask_bits(Vector mask) noexcept
+        {
+#if defined(__AVX2__)
+            return static_cast<uint32_t>(_mm256_movemask_epi8(__builtin_bit_cast(__m256i, mask)));
+#else
+            return static_cast<uint32_t>(_mm_movemask_epi8(__builtin_bit_cast(__m128i, mask)));
+#endif
+        }
+
+        // Lane i receives lane i - Shift, the first Shift lanes are zeroed.
+        template<size_t Shift, class Vector, size_t... Lanes>
+        inline Vector simd_shift_lanes(Vector value, index_sequence<Lanes...>) noexcept
+        {
+            return __builtin_shufflevector(Vector{}, value, (Lanes < Shift ? Lanes : Lanes + sizeof...(Lanes) - Shift)...);
+        }
+
+        // In-register inclusive prefix sum, in log2(Lanes) shifted adds.
+        template<size_t Lanes, size_t Shift = 1, class Vector>
+        inline Vector simd_prefix_sum(Vector value) noexcept
+        {
+            if constexpr (Shift < Lanes)
+                return simd_prefix_sum<Lanes, Shift * 2>(value + simd_shift_lanes<Shift>(value, make_index_sequence<Lanes>()));
+            else
+                return value;
+        }
+
+
+        // Kernels
+        template<class T, class V>
+        T simd_sum(const V* values, size_t size, T init) noexcept
+        {
+            constexpr size_t lanes = simd_width / sizeof(T);
+            using vector = simd_vector<T, lanes>::type;
+
+            // Four independent chains: a vector add has a latency of 3 to 4 cycles and a throughput
+            // of two per cycle, a single chain would leave most of the adders idle.
+            vector sum0 = {}, sum1 = {}, sum2 = {}, sum3 = {};
+            size_t index = 0;
+
+            for (; index + 4 * lanes <= size; index += 4 * lanes)
+            {
+                sum0 += simd_load_as<T, lanes>(values + index);
+                sum1 += simd_load_as<T, lanes>(values + index + lanes);
+                sum2 += simd_load_as<T, lanes>(values + index + 2 * lanes);
+                sum3 += simd_load_as<T, lanes>(values + index + 3 * lanes);
+            }
+
+            for (; index + lanes <= size; index += lanes)
+                sum0 += simd_load_as<T, lanes>(values + index);
+
+            const vector total = (sum0 + sum1) + (sum2 + sum3);
+            for (size_t lane = 0; lane < lanes; ++lane)
+                init += total[lane];
+
+            for (; index < size; ++index)
+                init += values[index];
+
+            return init;
+        }
+
+        template<class T, class V1, class V2>
+        T simd_dot(const V1* lhs, const V2* rhs, size_t size, T init) noexcept
+        {
+            constexpr size_t lanes = simd_width / sizeof(T);
+            using vector = simd_vector<T, lanes>::type;
+
+            const auto product = [&](size_t offset) { return simd_load_as<T, lanes>(lhs + offset) * simd_load_as<T, lanes>(rhs + offset); };
+
+            vector sum0 = {}, sum1 = {}, sum2 = {}, sum3 = {};
+            size_t index = 0;
+
+            for (; index + 4 * lanes <= size; index += 4 * lanes)
+            {
+                sum0 += product(index);
+                sum1 += product(index + lanes);
+                sum2 += product(index + 2 * lanes);
+                sum3 += product(index + 3 * lanes);
+            }
+
+            for (; index + lanes <= size; index += lanes)
+                sum0 += product(index);
+
+            const vector total = (sum0 + sum1) + (sum2 + sum3);
+            for (size_t lane = 0; lane < lanes; ++lane)
+                init += total[lane];
+
+            for (; index < size; ++index)
+                init += lhs[index] * rhs[index];
+
+            return init;
+        }
+
+        // The carry from one block to the next is a single broadcast, so the blocks only depend
+        // on each other through one add.
+        template<class T, class V>
+        void simd_inclusive_scan(const V* input, size_t size, T* output, T sum) noexcept
+        {
+            constexpr size_t lanes = simd_width / sizeof(T);
+            using vector = simd_vector<T, lanes>::type;
+
+            vector carry = simd_broadcast<vector>(sum);
+            size_t index = 0;
+
+            for (; index + lanes <= size; index += lanes)
+            {
+                const vector sums = simd_prefix_sum<lanes>(simd_load_as<T, lanes>(input + index)) + carry;
+                simd_store(output + index, sums);
+                carry = simd_broadcast<vector>(static_cast<T>(sums[lanes - 1]));
+            }
+
+            sum = carry[0];
+            for (; index < size; ++index)
+            {
+                sum += input[index];
+                output[index] = sum;
+            }
+        }
+
+        template<class T, class V>
+        void simd_exclusive_scan(const V* input, size_t size, T* output, T sum) noexcept
+        {
+            constexpr size_t lanes = simd_width / sizeof(T);
+            using vector = simd_vector<T, lanes>::type;
+
+            vector carry = simd_broadcast<vector>(sum);
+            size_t index = 0;
+
+            for (; index + lanes <= size; index += lanes)
+            {
+                const vector values = simd_load_as<T, lanes>(input + index);
+                const vector sums = simd_prefix_sum<lanes>(simd_shift_lanes<1>(values, make_index_sequence<lanes>())) + carry;
+                simd_store(output + index, sums);
+                carry = simd_broadcast<vector>(static_cast<T>(sums[lanes - 1] + values[lanes - 1]));
+            }
+
+            sum = carry[0];
+            for (; index < size; ++index)
+            {
+                const V value = input[index];
+                output[index] = sum;
+                sum += value;
+            }
+        }
+
+        // Finds the extreme values first, then their positions: the second pass stops at the
+        // first match, and needs no per-lane index bookkeeping in the hot loop. Integers only: a
+        // NaN would become the extreme and then never compare equal to itself.
+        template<class T>
+        min_max_result<size_t> simd_minmax(const T* values, size_t size) noexcept
+        {
+            constexpr size_t lanes = simd_width / sizeof(T);
+            using vector = simd_vector<T, lanes>::type;
+
+            T lowest = values[0];
+            T highest = values[0];
+            size_t index = 0;
+
+            if (size >= 2 * lanes)
+            {
+                vector low0 = simd_load<vector>(values), low1 = simd_load<vector>(values + lanes);
+                vector high0 = low0, high1 = low1;
+
+                for (index = 2 * lanes; index + 2 * lanes <= size; index += 2 * lanes)
+                {
+                    const vector block0 = simd_load<vector>(values + index);
+                    const vector block1 = simd_load<vector>(values + index + lanes);
+
+                    low0 = block0 < low0 ? block0 : low0;
+                    low1 = block1 < low1 ? block1 : low1;
+                    high0 = block0 < high0 ? high0 : block0;
+                    high1 = block1 < high1 ? high1 : block1;
+                }
+
+                const vector low = low1 < low0 ? low1 : low0;
+                const vector high = high1 < high0 ? high0 : high1;
+
+                for (size_t lane = 0; lane < lanes; ++lane)
+                {
+                    if (low[lane] < lowest)
+                        lowest = low[lane];
+                    if (!(high[lane] < highest))
+                        highest = high[lane];
+                }
+            }
+
+            for (; index < size; ++index)
+            {
+                if (values[index] < lowest)
+                    lowest = values[index];
+                if (!(values[index] < highest))
+                    highest = values[index];
+            }
+
+            min_max_result<size_t> result = { size, size };
+            const vector lowest_lanes = simd_broadcast<vector>(lowest);
+            const vector highest_lanes = simd_broadcast<vector>(highest);
+
+            for (index = 0; index + lanes <= size; index += lanes)
+            {
+                if (const uint32_t bits = simd_mask_bits(simd_load<vector>(values + index) == lowest_lanes))
+                {
+                    result.min = index + countr_zero(bits) / sizeof(T);
+                    break;
+                }
+            }
+
+            for (; result.min == size && index < size; ++index)
+            {
+                if (values[index] == lowest)
+                    result.min = index;
+            }
+
+            for (index = size; index >= lanes; index -= lanes)
+            {
+                if (const uint32_t bits = simd_mask_bits(simd_load<vector>(values + index - lanes) == highest_lanes))
+                {
+                    result.max = index - lanes + (bit_width(bits) - 1) / sizeof(T);
+                    break;
+                }
+            }
+
+            for (; result.max == size && index > 0; --index)
+            {
+                if (values[index - 1] == highest)
+                    result.max = index - 1;
+            }
+
+            return result;
+        }
+
+
+        // Four scalar chains for random access ranges. op has no known identity, so the chains
+        // are seeded with the first elements instead.
+        template<class T, class ReduceOp, class Element>
+        T unrolled_reduce(ptrdiff_t size, T init, ReduceOp& reduce, Element element)
+        {
+            ptrdiff_t index = 0;
+
+            if (size >= 8)
+            {
+                T partial0 = reduce(move(init), element(0));
+                T partial1 = element(1);
+                T partial2 = element(2);
+                T partial3 = element(3);
+
+                for (index = 4; index + 4 <= size; index += 4)
+                {
+                    partial0 = reduce(move(partial0), element(index));
+                    partial1 = reduce(move(partial1), element(index + 1));
+                    partial2 = reduce(move(partial2), element(index + 2));
+                    partial3 = reduce(move(partial3), element(index + 3));
+                }
+
+                init = reduce(reduce(move(partial0), move(partial1)), reduce(move(partial2), move(partial3)));
+            }
+
+            for (; index < size; ++index)
+                init = reduce(move(init), element(index));
+
+            return init;
+        }
+    }
+
+
+    // Reductions
+    template<input_iterator I>
+    iter_value_t<I> reduce(I first, I last)
+    {
+        return reduce(first, last, iter_value_t<I>(), plus<>());
+    }
+
+    template<input_iterator I, class T>
+    T reduce(I first, I last, T init)
+    {
+        return reduce(first, last, move(init), plus<>());
+    }
+
+    template<input_iterator I, class T, class BinaryOp>
+    T reduce(I first, I last, T init, BinaryOp op)
+    {
+        if constexpr (contiguous_iterator<I> && detail::simd_plus<BinaryOp, T> && detail::simd_sum_exact<iter_value_t<I>, T>)
+        {
+            if (first == last)
+                return init;
+
+            return detail::simd_sum(&*first, static_cast<size_t>(last - first), init);
+        }
+        else if constexpr (random_access_iterator<I>)
+        {
+            return detail::unrolled_reduce(last - first, move(init), op, [&](ptrdiff_t index) -> decltype(auto) { return first[index]; });
+        }
+        else
+        {
+            for (; first != last; ++first)
+                init = op(move(init), *first);
+
+            return init;
+        }
+    }
+
+    template<input_iterator I1, input_iterator I2, class T>
+    T transform_reduce(I1 first1, I1 last1, I2 first2, T init)
+    {
+        return transform_reduce(first1, last1, first2, move(init), plus<>(), multiplies<>());
+    }
+
+    template<input_iterator I1, input_iterator I2, class T, class ReduceOp, class TransformOp>
+    T transform_reduce(I1 first1, I1 last1, I2 first2, T init, ReduceOp reduce, TransformOp transform)
+    {
+        using value1 = iter_value_t<I1>;
+        using value2 = iter_value_t<I2>;
+
+        if constexpr (contiguous_iterator<I1> && contiguous_iterator<I2> && is_same_v<value1, value2>
+                      && detail::simd_plus<ReduceOp, T> && detail::simd_multiplies<TransformOp, value1>
+                      && detail::simd_product_exact<value1, T>)
+        {
+            if (first1 == last1)
+                return init;
+
+            return detail::simd_dot(&*first1, &*first2, static_cast<size_t>(last1 - first1), init);
+        }
+        else if constexpr (random_access_iterator<I1> && random_access_iterator<I2>)
+        {
+            return detail::unrolled_reduce(last1 - first1, move(init), reduce,
+                                           [&](ptrdiff_t index) { return transform(first1[index], first2[index]); });
+        }
+        else
+        {
+            for (; first1 != last1; ++first1, ++first2)
+                init = reduce(move(init), transform(*first1, *first2));
+
+            return init;
+        }
+    }
+
+    template<input_iterator I, class T, class ReduceOp, class TransformOp>
+    T transform_reduce(I first, I last, T init, ReduceOp reduce, TransformOp transform)
+    {
+        if constexpr (random_access_iterator<I>)
+        {
+            return detail::unrolled_reduce(last - first, move(init), reduce, [&](ptrdiff_t index) { return transform(first[index]); });
+        }
+        else
+        {
+            for (; first != last; ++first)
+                init = reduce(move(init), transform(*first));
+
+            return init;
+        }
+    }
+
+
+    // Prefix sums
+    template<input_iterator I, class O>
+    O inclusive_scan(I first, I last, O result)
+    {
+        return inclusive_scan(first, last, result, plus<>());
+    }
+
+    template<input_iterator I, class O, class BinaryOp>
+    O inclusive_scan(I first, I last, O result, BinaryOp op)
+    {
+        if (first == last)
+            return result;
+
+        iter_value_t<I> sum = *first;
+        *result = sum;
+        ++result;
+
+        return inclusive_scan(++first, last, result, op, move(sum));
+    }
+
+    template<input_iterator I, class O, class BinaryOp, class T>
+    O inclusive_scan(I first, I last, O result, BinaryOp op, T init)
+    {
+        if constexpr (contiguous_iterator<I> && contiguous_iterator<O> && is_same_v<iter_value_t<O>, T>
+                      && detail::simd_plus<BinaryOp, T> && detail::simd_sum_exact<iter_value_t<I>, T>)
+        {
+            if (first == last)
+                return result;
+
+            const size_t size = static_cast<size_t>(last - first);
+            detail::simd_inclusive_scan(&*first, size, &*result, init);
+            return result + size;
+        }
+        else
+        {
+            for (; first != last; ++first, ++result)
+            {
+                init = op(move(init), *first);
+                *result = init;
+            }
+
+            return result;
+        }
+    }
+
+    template<input_iterator I, class O, class T>
+    O exclusive_scan(I first, I last, O result, T init)
+    {
+        return exclusive_scan(first, last, result, move(init), plus<>());
+    }
+
+    template<input_iterator I, class O, class T, class BinaryOp>
+    O exclusive_scan(I first, I last, O result, T init, BinaryOp op)
+    {
+        if constexpr (contiguous_iterator<I> && contiguous_iterator<O> && is_same_v<iter_value_t<O>, T>
+                      && detail::simd_plus<BinaryOp, T> && detail::simd_sum_exact<iter_value_t<I>, T>)
+        {
+            if (first == last)
+                return result;
+
+            const size_t size = static_cast<size_t>(last - first);
+            detail::simd_exclusive_scan(&*first, size, &*result, init);
+            return result + size;
+        }
+        else
+        {
+            for (; first != last; ++first, ++result)
+            {
+                // Read before writing, result may be first.
+                T next = op(init, *first);
+                *result = move(init);
+                init = move(next);
+            }
+
+            return result;
+        }
+    }
+
+
+    // Extremes
+    template<forward_iterator I>
+    min_max_result<I> minmax_element(I first, I last)
+    {
+        return minmax_element(first, last, less<>());
+    }
+
+    template<forward_iterator I, class Compare>
+    min_max_result<I> minmax_element(I first, I last, Compare comp)
+    {
+        if constexpr (contiguous_iterator<I> && detail::simd_arithmetic<iter_value_t<I>> && is_integral_v<iter_value_t<I>>
+                      && detail::simd_less<Compare, iter_value_t<I>>)
+        {
+            if (first == last)
+                return { last, last };
+
+            const min_max_result<size_t> found = detail::simd_minmax(&*first, static_cast<size_t>(last - first));
+            return { first + found.min, first + found.max };
+        }
+        else
+        {
+            min_max_result<I> result = { first, first };
+            if (first == last)
+                return result;
+
+            while (++first != last)
+            {
+                if (comp(*first, *result.min))
+                    result.min = first;
+                else if (!comp(*first, *result.max))
+                    result.max = first;
+            }
+
+            return result;
+        }
+    }
+
+
+    // Span overloads
+    template<class T>
+    remove_cv_t<T> reduce(span<T> values)
+    {
+        return reduce(values.begin(), values.end(), remove_cv_t<T>());
+    }
+
+    template<class T, class U>
+    U reduce(span<T> values, U init)
+    {
+        return reduce(values.begin(), values.end(), move(init));
+    }
+
+    template<class T1, class T2, class U>
+    U transform_reduce(span<T1> lhs, span<T2> rhs, U init)
+    {
+        return transform_reduce(lhs.begin(), lhs.end(), rhs.begin(), move(init));
+    }
+
+    template<class T, class U>
+    U* inclusive_scan(span<T> input, span<U> output)
+    {
+        return inclusive_scan(input.begin(), input.end(), output.begin());
+    }
+
+    template<class T, class U, class V>
+    U* exclusive_scan(span<T> input, span<U> output, V init)
+    {
+        return exclusive_scan(input.begin(), input.end(), output.begin(), move(init));
+    }
+
+    template<class T>
+    min_max_result<T*> minmax_element(span<T> values)
+    {
+        return minmax_element(values.begin(), values.end());
+    }
+}
+
+
+#endif //STL_NUMERIC_HPP
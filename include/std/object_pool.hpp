@@ -0,0 +1,187 @@
+#ifndef STL_OBJECT_POOL_HPP
+#define STL_OBJECT_POOL_HPP
+
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "memory.hpp"
+#include "new.hpp"
+#include "utility.hpp"
+#include "alloc_profile.hpp"
+
+namespace std
+{
+    namespace detail
+    {
+        inline constexpr size_t pool_magazine_capacity = 32;
+        inline constexpr uint32_t pool_max_threads = 64;
+        inline constexpr size_t pool_cache_line = 64;
+
+        // Fixed-capacity stack of free objects, the unit exchanged with the depot.
+        struct pool_magazine
+        {
+            pool_magazine* next; // depot link, must stay the first member
+            size_t count;
+            void* objects[pool_magazine_capacity];
+        };
+
+        // Lock-free LIFO of nodes whose first word is the link. The upper 16 bits of the head
+        // hold a counter bumped on every update, so a node popped and pushed back between a
+        // reader's load and its CAS does not go unnoticed (ABA).
+        class pool_stack
+        {
+        public:
+            void push(void* node) noexcept;
+            void* pop() noexcept;
+        private:
+            uint64_t m_head = 0;
+        };
+
+        struct alignas(pool_cache_line) pool_thread_cache
+        {
+            pool_magazine* loaded;
+            pool_magazine* previous;
+        };
+
+        // Type-erased engine behind object_pool<T> (Bonwick's magazine layer).
+        // Each thread owns two magazines and serves allocations and frees from them without any
+        // atomic operation; only when both are exhausted (or both full) does it trade a whole
+        // magazine with the shared depot, which is a pair of lock-free stacks.
+        class object_pool_base
+        {
+        public:
+            /// Constructors
+            object_pool_base(size_t object_size) noexcept;
+            object_pool_base(const object_pool_base&) = delete;
+
+            /// Destructor
+            ~object_pool_base();
+
+            /// Operators
+            object_pool_base& operator=(const object_pool_base&) = delete;
+
+            /// Member functions
+            void* allocate() noexcept;
+            void deallocate(void* object) noexcept;
+
+            // Hands the calling thread's magazines back to the depot, e.g. before it exits.
+            void flush() noexcept;
+        private:
+            pool_thread_cache* lock_cache() noexcept;
+            void unlock_cache(pool_thread_cache* cache) noexcept;
+
+            void* allocate_slow(pool_thread_cache& cache) noexcept;
+            void deallocate_slow(pool_thread_cache& cache, void* object) noexcept;
+
+            pool_magazine* fill_from_block() noexcept;
+            void* allocate_block(size_t size) noexcept;
+
+            size_t m_object_size;
+            pool_stack m_full;     // magazines holding at least one object
+            pool_stack m_empty;    // magazines holding none
+            pool_stack m_loose;    // single objects freed while no empty magazine could be made
+            void* m_blocks;        // every block this pool owns, released by the destructor
+
+            pool_thread_cache m_caches[pool_max_threads];
+            pool_thread_cache m_shared; // for the threads past pool_max_threads, behind m_shared_lock
+            bool m_shared_lock;
+        };
+    }
+
+    // Cache of fixed-size T slots for objects that are created and destroyed at a high rate.
+    // Slots are recycled through per-thread magazines and never returned to the heap before the
+    // pool itself is destroyed, which must happen after every object it produced.
+    template<class T>
+    class object_pool : private detail::object_pool_base
+    {
+    public:
+        // unique_ptr deleter returning the object to the pool it came from.
+        class deleter
+        {
+        public:
+            constexpr deleter() noexcept = default;
+            constexpr explicit deleter(object_pool& pool) noexcept;
+
+            void operator()(T* object) const noexcept;
+        private:
+            object_pool* m_pool = nullptr;
+        };
+
+        /// Member types
+        using value_type = T;
+        using unique_ptr_type = unique_ptr<T, deleter>;
+
+        /// Constructors
+        object_pool() noexcept;
+
+        /// Member functions
+        // Returns nullptr when the heap is exhausted.
+        template<class... Args>
+        T* create(Args&&... args);
+        void destroy(T* object) noexcept;
+
+        template<class... Args>
+        unique_ptr_type make_unique(Args&&... args);
+
+        using detail::object_pool_base::flush;
+    private:
+        static constexpr size_t slot_size = sizeof(T) < sizeof(void*) ? sizeof(void*) : sizeof(T);
+    };
+
+
+    // object_pool::deleter
+    template<class T>
+    constexpr object_pool<T>::deleter::deleter(object_pool& pool) noexcept : m_pool(&pool)
+    {
+    }
+
+    template<class T>
+    void object_pool<T>::deleter::operator()(T* object) const noexcept
+    {
+        STL_ALLOC_PROFILE_DEALLOCATE(object);
+        m_pool->destroy(object);
+    }
+
+
+    // object_pool
+    // Constructors implementations
+    template<class T>
+    object_pool<T>::object_pool() noexcept : detail::object_pool_base(slot_size)
+    {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned types are not supported by object_pool.");
+    }
+
+    // Member functions
+    template<class T>
+    template<class... Args>
+    T* object_pool<T>::create(Args&&... args)
+    {
+        void* slot = allocate();
+        if (!slot)
+            return nullptr;
+
+        return new (slot) T(forward<Args>(args)...);
+    }
+
+    template<class T>
+    void object_pool<T>::destroy(T* object) noexcept
+    {
+        if (!object)
+            return;
+
+        object->~T();
+        deallocate(object);
+    }
+
+    template<class T>
+    template<class... Args>
+    STL_ALLOC_PROFILE_NOINLINE object_pool<T>::unique_ptr_type object_pool<T>::make_unique(Args&&... args)
+    {
+        T* object = create(forward<Args>(args)...);
+        STL_ALLOC_PROFILE_ALLOCATE(object, sizeof(T));
+        return unique_ptr_type(object, deleter(*this));
+    }
+}
+
+
+#endif //STL_OBJECT_POOL_HPP
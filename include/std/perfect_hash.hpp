@@ -0,0 +1,247 @@
+#ifndef STL_PERFECT_HASH_HPP
+#define STL_PERFECT_HASH_HPP
+
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "string_view.hpp"
+
+namespace std
+{
+    template<class Value>
+    struct perfect_hash_entry
+    {
+        string_view key;
+        Value value;
+    };
+
+    // Collision-free table over a fixed key set, built entirely at compile time
+    // (hash-and-displace, in the CHD style): every key is hashed once, its bucket selects a
+    // displacement seed, and the seed sends it to its own slot. A lookup is one hash of the key,
+    // one probe and one key comparison, and a constexpr instance lives in .rodata.
+    template<class Value, size_t N>
+    class perfect_hash_map
+    {
+    public:
+        /// Member types
+        using value_type = perfect_hash_entry<Value>;
+        using size_type = size_t;
+        using const_iterator = const value_type*;
+
+        static constexpr size_type table_size = N < 4 ? 4 : size_type(1) << (64 - __builtin_clzll(N + N / 4));
+        static constexpr size_type bucket_count = N / 2 + 1;
+
+        /// Constructors
+        constexpr perfect_hash_map() noexcept;
+
+        /// Member functions
+        //  Lookup
+        constexpr const Value* find(string_view key) const noexcept;
+        constexpr bool contains(string_view key) const noexcept;
+
+        //  Iterators (in declaration order)
+        constexpr const_iterator begin() const noexcept;
+        constexpr const_iterator end() const noexcept;
+
+        //  Capacity
+        constexpr size_type size() const noexcept;
+    private:
+        template<class V, size_t M>
+        friend consteval perfect_hash_map<V, M> make_perfect_hash_map(const perfect_hash_entry<V> (&entries)[M]);
+
+        static constexpr uint32_t empty_slot = static_cast<uint32_t>(-1);
+
+        uint32_t m_seeds[bucket_count];
+        uint32_t m_slots[table_size];
+        value_type m_entries[N ? N : 1];
+    };
+
+    // Fails to compile on duplicate keys.
+    template<class Value, size_t N>
+    consteval perfect_hash_map<Value, N> make_perfect_hash_map(const perfect_hash_entry<Value> (&entries)[N]);
+
+    namespace detail
+    {
+        // Reads 8 bytes per step. The shifts are folded into a single load at run time, and
+        // unlike a reinterpret_cast they are allowed in constant expressions.
+        constexpr uint64_t perfect_hash_bytes(string_view key) noexcept
+        {
+            constexpr uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+
+            const size_t size = key.size();
+            uint64_t hash = size * multiplier;
+            size_t index = 0;
+
+            for (; index + 8 <= size; index += 8)
+            {
+                uint64_t word = 0;
+                for (size_t byte = 0; byte < 8; ++byte)
+                    word |= uint64_t(static_cast<unsigned char>(key[index + byte])) << (8 * byte);
+
+                hash = (hash ^ word) * multiplier;
+                hash ^= hash >> 29;
+            }
+
+            uint64_t tail = 0;
+            for (size_t byte = 0; index + byte < size; ++byte)
+                tail |= uint64_t(static_cast<unsigned char>(key[index + byte])) << (8 * byte);
+
+            hash = (hash ^ tail) * multiplier;
+            return hash ^ (hash >> 32);
+        }
+
+        constexpr uint64_t perfect_hash_displace(uint64_t hash, uint32_t seed) noexcept
+        {
+            uint64_t mixed = hash ^ (uint64_t(seed) * 0xC2B2AE3D27D4EB4Full);
+            mixed ^= mixed >> 31;
+            mixed *= 0xD6E8FEB86659FD93ull;
+            return mixed ^ (mixed >> 32);
+        }
+
+        // Not constexpr: reaching either one during constant evaluation is the compile error.
+        void perfect_hash_duplicate_key() noexcept;
+        void perfect_hash_no_displacement_found() noexcept;
+    }
+
+
+    // Constructors implementations
+    template<class Value, size_t N>
+    constexpr perfect_hash_map<Value, N>::perfect_hash_map() noexcept : m_seeds{}, m_slots{}, m_entries{}
+    {
+        for (size_type slot = 0; slot < table_size; ++slot)
+            m_slots[slot] = empty_slot;
+    }
+
+    // Member functions
+    template<class Value, size_t N>
+    constexpr const Value* perfect_hash_map<Value, N>::find(string_view key) const noexcept
+    {
+        const uint64_t hash = detail::perfect_hash_bytes(key);
+        const uint32_t seed = m_seeds[(hash >> 32) % bucket_count];
+        const uint32_t index = m_slots[detail::perfect_hash_displace(hash, seed) & (table_size - 1)];
+
+        if (index == empty_slot || !(m_entries[index].key == key))
+            return nullptr;
+
+        return &m_entries[index].value;
+    }
+
+    template<class Value, size_t N>
+    constexpr bool perfect_hash_map<Value, N>::contains(string_view key) const noexcept
+    {
+        return find(key) != nullptr;
+    }
+
+    template<class Value, size_t N>
+    constexpr perfect_hash_map<Value, N>::const_iterator perfect_hash_map<Value, N>::begin() const noexcept
+    {
+        return m_entries;
+    }
+
+    template<class Value, size_t N>
+    constexpr perfect_hash_map<Value, N>::const_iterator perfect_hash_map<Value, N>::end() const noexcept
+    {
+        return m_entries + N;
+    }
+
+    template<class Value, size_t N>
+    constexpr perfect_hash_map<Value, N>::size_type perfect_hash_map<Value, N>::size() const noexcept
+    {
+        return N;
+    }
+
+    /// Extern functions
+    template<class Value, size_t N>
+    consteval perfect_hash_map<Value, N> make_perfect_hash_map(const perfect_hash_entry<Value> (&entries)[N])
+    {
+        using map_type = perfect_hash_map<Value, N>;
+        constexpr size_t table_size = map_type::table_size;
+        constexpr size_t bucket_count = map_type::bucket_count;
+        constexpr size_t max_seed = 1u << 16;
+
+        map_type map;
+
+        uint64_t hashes[N ? N : 1] = {};
+        size_t bucket_of[N ? N : 1] = {};
+        size_t bucket_sizes[bucket_count] = {};
+
+        for (size_t i = 0; i < N; ++i)
+        {
+            map.m_entries[i] = entries[i];
+            hashes[i] = detail::perfect_hash_bytes(entries[i].key);
+            bucket_of[i] = (hashes[i] >> 32) % bucket_count;
+            ++bucket_sizes[bucket_of[i]];
+
+            for (size_t j = 0; j < i; ++j)
+            {
+                if (entries[j].key == entries[i].key)
+                    detail::perfect_hash_duplicate_key();
+            }
+        }
+
+        // Place the largest buckets first, while the table is still mostly empty.
+        size_t order[bucket_count] = {};
+        for (size_t bucket = 0; bucket < bucket_count; ++bucket)
+            order[bucket] = bucket;
+
+        for (size_t i = 1; i < bucket_count; ++i)
+        {
+            const size_t current = order[i];
+            size_t j = i;
+            for (; j > 0 && bucket_sizes[order[j - 1]] < bucket_sizes[current]; --j)
+                order[j] = order[j - 1];
+            order[j] = current;
+        }
+
+        for (size_t rank = 0; rank < bucket_count && bucket_sizes[order[rank]] > 0; ++rank)
+        {
+            const size_t bucket = order[rank];
+            bool placed = false;
+
+            for (uint32_t seed = 0; seed < max_seed && !placed; ++seed)
+            {
+                size_t slots[N ? N : 1] = {};
+                size_t count = 0;
+                placed = true;
+
+                for (size_t i = 0; i < N && placed; ++i)
+                {
+                    if (bucket_of[i] != bucket)
+                        continue;
+
+                    const size_t slot = detail::perfect_hash_displace(hashes[i], seed) & (table_size - 1);
+                    if (map.m_slots[slot] != map_type::empty_slot)
+                        placed = false;
+
+                    for (size_t k = 0; k < count && placed; ++k)
+                    {
+                        if (slots[k] == slot)
+                            placed = false;
+                    }
+
+                    slots[count++] = slot;
+                }
+
+                if (!placed)
+                    continue;
+
+                count = 0;
+                for (size_t i = 0; i < N; ++i)
+                {
+                    if (bucket_of[i] == bucket)
+                        map.m_slots[slots[count++]] = static_cast<uint32_t>(i);
+                }
+
+                map.m_seeds[bucket] = seed;
+            }
+
+            if (!placed)
+                detail::perfect_hash_no_displacement_found();
+        }
+
+        return map;
+    }
+}
+
+
+#endif //STL_PERFECT_HASH_HPP
@@ -0,0 +1,1560 @@
+#ifndef STL_PERSISTENT_HPP
+#define STL_PERSISTENT_HPP
+
+
+#include "bit.hpp"
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "new.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+// Persistent containers: every version stays valid and unchanged once made, and versions share
+// all the nodes they have in common. Copying one costs a reference count increment, so a
+// snapshot for rollback or for a reader is O(1); an update copies only the path from the root to
+// what changed, O(log32 n).
+//
+// Nodes are reference counted with atomic operations: versions can be handed to other threads
+// and read there while the writer keeps going, nobody waits for anybody. A single container
+// object is not synchronized though, like any other: threads exchange versions by copying them.
+//
+// Bulk changes go through a transient (transient_vector, transient_hash_map), which updates in
+// place every node it alone references and path-copies the others: building a container element
+// by element then allocates about as often as the mutable containers. persistent() takes an O(1)
+// snapshot of a transient, which keeps working after it, on copies of the nodes it now shares.
+namespace std
+{
+    template<class T>
+    class persistent_vector;
+
+    template<class T>
+    class transient_vector;
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    class persistent_hash_map;
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    class transient_hash_map;
+
+    namespace detail
+    {
+        inline constexpr uint32_t persistent_bits = 5;
+        inline constexpr uint32_t persistent_branching = 1u << persistent_bits;
+        inline constexpr uint32_t persistent_mask = persistent_branching - 1;
+
+        // Header of every node of the persistent containers.
+        struct persistent_node
+        {
+            uint32_t references;
+            uint32_t count;     // values, entries or children in use
+        };
+
+        void persistent_retain(persistent_node* node) noexcept;
+        // Whether that dropped the last reference, in which case the caller destroys node.
+        bool persistent_release(persistent_node* node) noexcept;
+        // Whether the caller holds the only reference, and may then change node in place.
+        bool persistent_unique(const persistent_node* node) noexcept;
+
+        // 32-way radix balanced trie, with the last (up to) 32 values kept apart in a tail leaf
+        // so that push_back and pop_back mostly touch that leaf alone. Every leaf of the trie is
+        // full; leaves are at level 0 and the root at m_shift.
+        // Shared by persistent_vector and transient_vector; the changes below update in place
+        // whatever nodes this trie alone references.
+        template<class T>
+        class vector_trie
+        {
+        public:
+            struct branch : persistent_node
+            {
+                persistent_node* children[persistent_branching];
+            };
+
+            struct leaf : persistent_node
+            {
+                alignas(T) unsigned char storage[sizeof(T) * persistent_branching];
+
+                T* values() noexcept;
+            };
+
+            /// Constructors
+            constexpr vector_trie() noexcept = default;
+            vector_trie(const vector_trie& other) noexcept;
+            vector_trie(vector_trie&& other) noexcept;
+
+            /// Destructor
+            ~vector_trie();
+
+            /// Operators
+            vector_trie& operator=(const vector_trie& other) noexcept;
+            vector_trie& operator=(vector_trie&& other) noexcept;
+
+            /// Member functions
+            const T& get(size_t index) const noexcept;
+            // The values of the leaf holding index.
+            const T* values_of(size_t index) const noexcept;
+            size_t size() const noexcept;
+
+            template<class U>
+            void push_back(U&& value);
+            void pop_back() noexcept;
+            template<class U>
+            void set(size_t index, U&& value);
+            void clear() noexcept;
+        private:
+            size_t tail_offset() const noexcept;
+            persistent_node* leaf_of(size_t index) const noexcept;
+
+            static branch* make_branch() noexcept;
+            static leaf* make_leaf() noexcept;
+            static void release(persistent_node* node, uint32_t level) noexcept;
+            // The node behind slot, copied first unless this trie alone references it.
+            static branch* own_branch(persistent_node*& slot, uint32_t level) noexcept;
+            static leaf* own_leaf(persistent_node*& slot);
+            // Branches from level down to tail, each holding the next one as its only child.
+            static persistent_node* new_path(uint32_t level, persistent_node* tail) noexcept;
+
+            void push_tail(persistent_node*& slot, uint32_t level, persistent_node* tail) noexcept;
+            void pop_tail(persistent_node*& slot, uint32_t level) noexcept;
+
+            persistent_node* m_root = nullptr;
+            persistent_node* m_tail = nullptr;    // a leaf, null only when empty
+            size_t m_size = 0;
+            uint32_t m_shift = persistent_bits;
+        };
+
+        // Hash array mapped trie: each node takes 5 bits of the hash and keeps the entries and
+        // children present for them compacted in two arrays, a position being the popcount of
+        // the bitmap below its bit (the CHAMP layout). Nodes are kept canonical, a child holding
+        // a single entry is folded back into its parent, so a version never keeps more nodes than
+        // its entries need. Keys whose hashes are equal on all their bits share a collision node
+        // past the last level, searched linearly.
+        template<class Key, class Value, class Hash, class KeyEqual>
+        class hash_trie
+        {
+        public:
+            struct entry
+            {
+                Key key;
+                Value value;
+            };
+
+            // One allocation: this header, the children, then the entries.
+            struct node : persistent_node     // count: entries
+            {
+                uint32_t datamap;       // hash fragments holding an entry here
+                uint32_t nodemap;       // hash fragments holding a child node
+                uint32_t entry_capacity;
+                uint32_t child_capacity;
+
+                node** children() noexcept;
+                entry* entries() noexcept;
+            };
+
+            /// Constructors
+            constexpr hash_trie() noexcept = default;
+            hash_trie(const hash_trie& other) noexcept;
+            hash_trie(hash_trie&& other) noexcept;
+
+            /// Destructor
+            ~hash_trie();
+
+            /// Operators
+            hash_trie& operator=(const hash_trie& other) noexcept;
+            hash_trie& operator=(hash_trie&& other) noexcept;
+
+            /// Member functions
+            const Value* find(const Key& key) const;
+            size_t size() const noexcept;
+
+            // Both return whether the number of entries changed.
+            template<class V>
+            bool set(const Key& key, V&& value);
+            bool erase(const Key& key);
+            void clear() noexcept;
+
+            template<class F>
+            void visit_all(F& f) const;
+        private:
+            static constexpr uint32_t hash_bits = sizeof(size_t) * 8;
+
+            static size_t hash_of(const Key& key);
+            static uint32_t bit_of(size_t hash, uint32_t shift) noexcept;
+            static const Value* lookup(node* current, size_t hash, const Key& key);
+
+            static node* allocate(uint32_t entry_capacity, uint32_t child_capacity) noexcept;
+            static void release(node* current) noexcept;
+            // The node behind slot, with room for extra_entries more entries and extra_children
+            // more children: copied first unless this trie alone references it.
+            static node* own(node*& slot, uint32_t extra_entries, uint32_t extra_children);
+
+            template<class V>
+            static node* make_pair(uint32_t shift, entry&& existing, size_t existing_hash, const Key& key, V&& value, size_t hash);
+            // These four need the room for what they add, and leave the bitmaps to the caller,
+            // who updates them afterwards.
+            template<class... Args>
+            static void emplace_entry(node* current, uint32_t index, Args&&... args);
+            static void remove_entry(node* current, uint32_t index) noexcept;
+            static void insert_child(node* current, uint32_t index, node* child) noexcept;
+            static void remove_child(node* current, uint32_t index) noexcept;
+
+            template<class V>
+            static bool set(node*& slot, uint32_t shift, size_t hash, const Key& key, V&& value);
+            static void erase(node*& slot, uint32_t shift, size_t hash, const Key& key);
+
+            template<class F>
+            static void visit(node* current, F& f);
+
+            node* m_root = nullptr;
+            size_t m_size = 0;
+        };
+    }
+
+    template<class T>
+    class persistent_vector
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            /// Member types
+            using iterator_category = forward_iterator_tag;
+            using value_type = T;
+            using difference_type = ptrdiff_t;
+            using reference = const T&;
+            using pointer = const T*;
+
+            /// Constructors
+            constexpr const_iterator() noexcept = default;
+
+            /// Operators
+            reference operator*() const noexcept;
+            pointer operator->() const noexcept;
+
+            const_iterator& operator++() noexcept;
+            const_iterator operator++(int) noexcept;
+
+            bool operator==(const const_iterator& other) const noexcept;
+        private:
+            friend persistent_vector;
+
+            const_iterator(const detail::vector_trie<T>* trie, size_t index) noexcept;
+
+            const detail::vector_trie<T>* m_trie = nullptr;
+            const T* m_values = nullptr;      // the leaf of m_index, walked to once per 32 values
+            size_t m_index = 0;
+        };
+
+        /// Member types
+        using value_type = T;
+        using size_type = size_t;
+        using const_reference = const T&;
+        using iterator = const_iterator;
+
+        /// Constructors
+        constexpr persistent_vector() noexcept = default;
+
+        /// Operators
+        const_reference operator[](size_type index) const noexcept;
+
+        /// Member functions
+        //  Element access
+        const_reference front() const noexcept;
+        const_reference back() const noexcept;
+
+        //  Iterators
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+
+        //  Capacity
+        bool empty() const noexcept;
+        size_type size() const noexcept;
+
+        //  Modifiers
+        // Each returns the new version and leaves this one as it is.
+        template<class U>
+        persistent_vector push_back(U&& value) const;
+        persistent_vector pop_back() const noexcept;
+        template<class U>
+        persistent_vector set(size_type index, U&& value) const;
+
+        transient_vector<T> transient() const noexcept;
+    private:
+        friend transient_vector<T>;
+
+        explicit persistent_vector(const detail::vector_trie<T>& trie) noexcept;
+
+        detail::vector_trie<T> m_trie;
+    };
+
+    template<class T>
+    class transient_vector
+    {
+    public:
+        /// Member types
+        using value_type = T;
+        using size_type = size_t;
+        using const_reference = const T&;
+
+        /// Constructors
+        constexpr transient_vector() noexcept = default;
+        explicit transient_vector(const persistent_vector<T>& source) noexcept;
+
+        /// Operators
+        const_reference operator[](size_type index) const noexcept;
+
+        /// Member functions
+        //  Element access
+        const_reference front() const noexcept;
+        const_reference back() const noexcept;
+
+        //  Capacity
+        bool empty() const noexcept;
+        size_type size() const noexcept;
+
+        //  Modifiers
+        template<class U>
+        void push_back(U&& value);
+        void pop_back() noexcept;
+        template<class U>
+        void set(size_type index, U&& value);
+        void clear() noexcept;
+
+        // Snapshot of the current contents.
+        persistent_vector<T> persistent() const noexcept;
+    private:
+        detail::vector_trie<T> m_trie;
+    };
+
+    template<class Key, class Value, class Hash = hash<Key>, class KeyEqual = equal_to<Key>>
+    class persistent_hash_map
+    {
+    public:
+        /// Member types
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        /// Constructors
+        constexpr persistent_hash_map() noexcept = default;
+
+        /// Member functions
+        //  Lookup
+        // The value of key, nullptr when key is absent; valid as long as this version.
+        const Value* find(const Key& key) const;
+        bool contains(const Key& key) const;
+
+        //  Modifiers
+        // Each returns the new version and leaves this one as it is.
+        template<class V>
+        persistent_hash_map set(const Key& key, V&& value) const;
+        persistent_hash_map erase(const Key& key) const;
+
+        transient_hash_map<Key, Value, Hash, KeyEqual> transient() const noexcept;
+
+        //  Visitors
+        // Calls f(const Key&, const Value&) on every entry, in no particular order.
+        template<class F>
+        void visit_all(F f) const;
+
+        //  Capacity
+        size_type size() const noexcept;
+        bool empty() const noexcept;
+    private:
+        friend transient_hash_map<Key, Value, Hash, KeyEqual>;
+
+        explicit persistent_hash_map(const detail::hash_trie<Key, Value, Hash, KeyEqual>& trie) noexcept;
+
+        detail::hash_trie<Key, Value, Hash, KeyEqual> m_trie;
+    };
+
+    template<class Key, class Value, class Hash = hash<Key>, class KeyEqual = equal_to<Key>>
+    class transient_hash_map
+    {
+    public:
+        /// Member types
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        /// Constructors
+        constexpr transient_hash_map() noexcept = default;
+        explicit transient_hash_map(const persistent_hash_map<Key, Value, Hash, KeyEqual>& source) noexcept;
+
+        /// Member functions
+        //  Lookup
+        // The value of key, nullptr when key is absent; valid until the next change.
+        const Value* find(const Key& key) const;
+        bool contains(const Key& key) const;
+
+        //  Modifiers
+        // Returns true when it inserted a new entry, false when it assigned an existing one.
+        template<class V>
+        bool set(const Key& key, V&& value);
+        // Returns true when key was present.
+        bool erase(const Key& key);
+        void clear() noexcept;
+
+        // Snapshot of the current contents.
+        persistent_hash_map<Key, Value, Hash, KeyEqual> persistent() const noexcept;
+
+        //  Visitors
+        // Calls f(const Key&, const Value&) on every entry, in no particular order.
+        template<class F>
+        void visit_all(F f) const;
+
+        //  Capacity
+        size_type size() const noexcept;
+        bool empty() const noexcept;
+    private:
+        detail::hash_trie<Key, Value, Hash, KeyEqual> m_trie;
+    };
+
+
+    namespace detail
+    {
+        // vector_trie::leaf
+        // Member functions
+        template<class T>
+        T* vector_trie<T>::leaf::values() noexcept
+        {
+            return reinterpret_cast<T*>(storage);
+        }
+
+
+        // vector_trie
+        // Constructors implementations
+        template<class T>
+        vector_trie<T>::vector_trie(const vector_trie& other) noexcept
+            : m_root(other.m_root), m_tail(other.m_tail), m_size(other.m_size), m_shift(other.m_shift)
+        {
+            if (m_root)
+                persistent_retain(m_root);
+            if (m_tail)
+                persistent_retain(m_tail);
+        }
+
+        template<class T>
+        vector_trie<T>::vector_trie(vector_trie&& other) noexcept
+            : m_root(other.m_root), m_tail(other.m_tail), m_size(other.m_size), m_shift(other.m_shift)
+        {
+            other.m_root = nullptr;
+            other.m_tail = nullptr;
+            other.m_size = 0;
+            other.m_shift = persistent_bits;
+        }
+
+        // Destructor implementation
+        template<class T>
+        vector_trie<T>::~vector_trie()
+        {
+            clear();
+        }
+
+        // Operators
+        template<class T>
+        vector_trie<T>& vector_trie<T>::operator=(const vector_trie& other) noexcept
+        {
+            if (this != &other)
+                *this = vector_trie(other);
+
+            return *this;
+        }
+
+        template<class T>
+        vector_trie<T>& vector_trie<T>::operator=(vector_trie&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                swap(m_root, other.m_root);
+                swap(m_tail, other.m_tail);
+                swap(m_size, other.m_size);
+                swap(m_shift, other.m_shift);
+            }
+
+            return *this;
+        }
+
+        // Member functions
+        template<class T>
+        const T& vector_trie<T>::get(size_t index) const noexcept
+        {
+            return values_of(index)[index & persistent_mask];
+        }
+
+        template<class T>
+        const T* vector_trie<T>::values_of(size_t index) const noexcept
+        {
+            return static_cast<leaf*>(leaf_of(index))->values();
+        }
+
+        template<class T>
+        size_t vector_trie<T>::size() const noexcept
+        {
+            return m_size;
+        }
+
+        template<class T>
+        template<class U>
+        void vector_trie<T>::push_back(U&& value)
+        {
+            if (!m_tail)
+            {
+                m_tail = make_leaf();
+            }
+            else if (m_tail->count == persistent_branching)
+            {
+                // The full tail becomes the last leaf of the trie, which gets a level more when
+                // its root has no room left.
+                if (!m_root)
+                {
+                    m_root = new_path(m_shift, m_tail);
+                }
+                else if ((m_size >> persistent_bits) > (static_cast<size_t>(1) << m_shift))
+                {
+                    branch* root = make_branch();
+                    root->children[0] = m_root;
+                    root->children[1] = new_path(m_shift, m_tail);
+                    root->count = 2;
+
+                    m_root = root;
+                    m_shift += persistent_bits;
+                }
+                else
+                {
+                    push_tail(m_root, m_shift, m_tail);
+                }
+
+                m_tail = make_leaf();
+            }
+
+            leaf* tail = own_leaf(m_tail);
+            new (tail->values() + tail->count) T(forward<U>(value));
+            ++tail->count;
+            ++m_size;
+        }
+
+        template<class T>
+        void vector_trie<T>::pop_back() noexcept
+        {
+            if (m_size == 1)
+            {
+                clear();
+                return;
+            }
+
+            if (m_tail->count > 1)
+            {
+                leaf* tail = own_leaf(m_tail);
+                tail->values()[--tail->count].~T();
+                --m_size;
+                return;
+            }
+
+            // The tail empties: the last leaf of the trie takes its place.
+            persistent_node* tail = leaf_of(m_size - 2);
+            persistent_retain(tail);
+            release(m_tail, 0);
+            m_tail = tail;
+
+            pop_tail(m_root, m_shift);
+            if (m_root && m_shift > persistent_bits && m_root->count == 1)
+            {
+                persistent_node* child = static_cast<branch*>(m_root)->children[0];
+                persistent_retain(child);
+                release(m_root, m_shift);
+
+                m_root = child;
+                m_shift -= persistent_bits;
+            }
+
+            --m_size;
+        }
+
+        template<class T>
+        template<class U>
+        void vector_trie<T>::set(size_t index, U&& value)
+        {
+            if (index >= tail_offset())
+            {
+                own_leaf(m_tail)->values()[index & persistent_mask] = forward<U>(value);
+                return;
+            }
+
+            persistent_node** slot = &m_root;
+            for (uint32_t level = m_shift; level > 0; level -= persistent_bits)
+                slot = &own_branch(*slot, level)->children[(index >> level) & persistent_mask];
+
+            own_leaf(*slot)->values()[index & persistent_mask] = forward<U>(value);
+        }
+
+        template<class T>
+        void vector_trie<T>::clear() noexcept
+        {
+            release(m_root, m_shift);
+            release(m_tail, 0);
+
+            m_root = nullptr;
+            m_tail = nullptr;
+            m_size = 0;
+            m_shift = persistent_bits;
+        }
+
+        // Index of the first value in the tail; the tail is never empty, so a size that is a
+        // multiple of 32 leaves a full tail.
+        template<class T>
+        size_t vector_trie<T>::tail_offset() const noexcept
+        {
+            return m_size < persistent_branching ? 0 : ((m_size - 1) >> persistent_bits) << persistent_bits;
+        }
+
+        template<class T>
+        persistent_node* vector_trie<T>::leaf_of(size_t index) const noexcept
+        {
+            if (index >= tail_offset())
+                return m_tail;
+
+            persistent_node* node = m_root;
+            for (uint32_t level = m_shift; level > 0; level -= persistent_bits)
+                node = static_cast<branch*>(node)->children[(index >> level) & persistent_mask];
+
+            return node;
+        }
+
+        template<class T>
+        vector_trie<T>::branch* vector_trie<T>::make_branch() noexcept
+        {
+            branch* created = static_cast<branch*>(::operator new(sizeof(branch)));
+            created->references = 1;
+            created->count = 0;
+            return created;
+        }
+
+        template<class T>
+        vector_trie<T>::leaf* vector_trie<T>::make_leaf() noexcept
+        {
+            static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "persistent_vector values cannot be over-aligned.");
+
+            leaf* created = static_cast<leaf*>(::operator new(sizeof(leaf)));
+            created->references = 1;
+            created->count = 0;
+            return created;
+        }
+
+        template<class T>
+        void vector_trie<T>::release(persistent_node* node, uint32_t level) noexcept
+        {
+            if (!node || !persistent_release(node))
+                return;
+
+            if (level == 0)
+            {
+                T* values = static_cast<leaf*>(node)->values();
+                for (uint32_t i = 0; i < node->count; ++i)
+                    values[i].~T();
+            }
+            else
+            {
+                branch* parent = static_cast<branch*>(node);
+                for (uint32_t i = 0; i < node->count; ++i)
+                    release(parent->children[i], level - persistent_bits);
+            }
+
+            ::operator delete(node);
+        }
+
+        template<class T>
+        vector_trie<T>::branch* vector_trie<T>::own_branch(persistent_node*& slot, uint32_t level) noexcept
+        {
+            branch* current = static_cast<branch*>(slot);
+            if (persistent_unique(current))
+                return current;
+
+            branch* copy = make_branch();
+            copy->count = current->count;
+            for (uint32_t i = 0; i < current->count; ++i)
+            {
+                copy->children[i] = current->children[i];
+                persistent_retain(copy->children[i]);
+            }
+
+            release(current, level);
+            slot = copy;
+            return copy;
+        }
+
+        template<class T>
+        vector_trie<T>::leaf* vector_trie<T>::own_leaf(persistent_node*& slot)
+        {
+            leaf* current = static_cast<leaf*>(slot);
+            if (persistent_unique(current))
+                return current;
+
+            leaf* copy = make_leaf();
+            for (; copy->count < current->count; ++copy->count)
+                new (copy->values() + copy->count) T(current->values()[copy->count]);
+
+            release(current, 0);
+            slot = copy;
+            return copy;
+        }
+
+        template<class T>
+        persistent_node* vector_trie<T>::new_path(uint32_t level, persistent_node* tail) noexcept
+        {
+            if (level == 0)
+                return tail;
+
+            branch* parent = make_branch();
+            parent->children[0] = new_path(level - persistent_bits, tail);
+            parent->count = 1;
+            return parent;
+        }
+
+        template<class T>
+        void vector_trie<T>::push_tail(persistent_node*& slot, uint32_t level, persistent_node* tail) noexcept
+        {
+            branch* parent = own_branch(slot, level);
+            const uint32_t index = ((m_size - 1) >> level) & persistent_mask;
+
+            if (level == persistent_bits)
+                parent->children[index] = tail;
+            else if (index < parent->count)
+                push_tail(parent->children[index], level - persistent_bits, tail);
+            else
+                parent->children[index] = new_path(level - persistent_bits, tail);
+
+            parent->count = index + 1;
+        }
+
+        // Drops the last leaf of the trie, which holds the value at m_size - 2; slot becomes
+        // null when nothing is left below it.
+        template<class T>
+        void vector_trie<T>::pop_tail(persistent_node*& slot, uint32_t level) noexcept
+        {
+            branch* parent = own_branch(slot, level);
+            const uint32_t index = ((m_size - 2) >> level) & persistent_mask;
+
+            if (level > persistent_bits)
+            {
+                pop_tail(parent->children[index], level - persistent_bits);
+                if (parent->children[index])
+                    return;
+            }
+            else
+            {
+                release(parent->children[index], 0);
+            }
+
+            parent->count = index;
+            if (index == 0)
+            {
+                release(parent, level);
+                slot = nullptr;
+            }
+        }
+
+
+        // hash_trie::node
+        // Member functions
+        template<class Key, class Value, class Hash, class KeyEqual>
+        hash_trie<Key, Value, Hash, KeyEqual>::node** hash_trie<Key, Value, Hash, KeyEqual>::node::children() noexcept
+        {
+            return reinterpret_cast<node**>(this + 1);
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        hash_trie<Key, Value, Hash, KeyEqual>::entry* hash_trie<Key, Value, Hash, KeyEqual>::node::entries() noexcept
+        {
+            const size_t offset = sizeof(node) + child_capacity * sizeof(node*);
+            return reinterpret_cast<entry*>(reinterpret_cast<char*>(this) + ((offset + alignof(entry) - 1) & ~(alignof(entry) - 1)));
+        }
+
+
+        // hash_trie
+        // Constructors implementations
+        template<class Key, class Value, class Hash, class KeyEqual>
+        hash_trie<Key, Value, Hash, KeyEqual>::hash_trie(const hash_trie& other) noexcept : m_root(other.m_root), m_size(other.m_size)
+        {
+            if (m_root)
+                persistent_retain(m_root);
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        hash_trie<Key, Value, Hash, KeyEqual>::hash_trie(hash_trie&& other) noexcept : m_root(other.m_root), m_size(other.m_size)
+        {
+            other.m_root = nullptr;
+            other.m_size = 0;
+        }
+
+        // Destructor implementation
+        template<class Key, class Value, class Hash, class KeyEqual>
+        hash_trie<Key, Value, Hash, KeyEqual>::~hash_trie()
+        {
+            release(m_root);
+        }
+
+        // Operators
+        template<class Key, class Value, class Hash, class KeyEqual>
+        hash_trie<Key, Value, Hash, KeyEqual>& hash_trie<Key, Value, Hash, KeyEqual>::operator=(const hash_trie& other) noexcept
+        {
+            if (this != &other)
+                *this = hash_trie(other);
+
+            return *this;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        hash_trie<Key, Value, Hash, KeyEqual>& hash_trie<Key, Value, Hash, KeyEqual>::operator=(hash_trie&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                swap(m_root, other.m_root);
+                swap(m_size, other.m_size);
+            }
+
+            return *this;
+        }
+
+        // Member functions
+        template<class Key, class Value, class Hash, class KeyEqual>
+        const Value* hash_trie<Key, Value, Hash, KeyEqual>::find(const Key& key) const
+        {
+            return m_root ? lookup(m_root, hash_of(key), key) : nullptr;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        size_t hash_trie<Key, Value, Hash, KeyEqual>::size() const noexcept
+        {
+            return m_size;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        template<class V>
+        bool hash_trie<Key, Value, Hash, KeyEqual>::set(const Key& key, V&& value)
+        {
+            if (!m_root)
+                m_root = allocate(1, 0);
+
+            const bool added = set(m_root, 0, hash_of(key), key, forward<V>(value));
+            m_size += added;
+            return added;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        bool hash_trie<Key, Value, Hash, KeyEqual>::erase(const Key& key)
+        {
+            // Checked first, so that erasing an absent key copies nothing.
+            const size_t hash = hash_of(key);
+            if (!m_root || !lookup(m_root, hash, key))
+                return false;
+
+            if (--m_size == 0)
+            {
+                clear();
+                return true;
+            }
+
+            erase(m_root, 0, hash, key);
+            return true;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        void hash_trie<Key, Value, Hash, KeyEqual>::clear() noexcept
+        {
+            release(m_root);
+            m_root = nullptr;
+            m_size = 0;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        template<class F>
+        void hash_trie<Key, Value, Hash, KeyEqual>::visit_all(F& f) const
+        {
+            if (m_root)
+                visit(m_root, f);
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        size_t hash_trie<Key, Value, Hash, KeyEqual>::hash_of(const Key& key)
+        {
+            // Each level takes the next 5 bits from the bottom: integers hash to themselves, and
+            // would otherwise crowd a few branches.
+            return hash_mix(Hash()(key));
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        uint32_t hash_trie<Key, Value, Hash, KeyEqual>::bit_of(size_t hash, uint32_t shift) noexcept
+        {
+            return 1u << ((hash >> shift) & persistent_mask);
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        const Value* hash_trie<Key, Value, Hash, KeyEqual>::lookup(node* current, size_t hash, const Key& key)
+        {
+            for (uint32_t shift = 0; shift < hash_bits; shift += persistent_bits)
+            {
+                const uint32_t bit = bit_of(hash, shift);
+                if (current->datamap & bit)
+                {
+                    entry& candidate = current->entries()[popcount(current->datamap & (bit - 1))];
+                    return KeyEqual()(candidate.key, key) ? &candidate.value : nullptr;
+                }
+
+                if (!(current->nodemap & bit))
+                    return nullptr;
+
+                current = current->children()[popcount(current->nodemap & (bit - 1))];
+            }
+
+            // Past the last level: a collision node.
+            entry* entries = current->entries();
+            for (uint32_t i = 0; i < current->count; ++i)
+            {
+                if (KeyEqual()(entries[i].key, key))
+                    return &entries[i].value;
+            }
+
+            return nullptr;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        hash_trie<Key, Value, Hash, KeyEqual>::node* hash_trie<Key, Value, Hash, KeyEqual>::allocate(uint32_t entry_capacity, uint32_t child_capacity) noexcept
+        {
+            static_assert(alignof(entry) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "persistent_hash_map entries cannot be over-aligned.");
+
+            const size_t children = (sizeof(node) + child_capacity * sizeof(node*) + alignof(entry) - 1) & ~(alignof(entry) - 1);
+            node* created = static_cast<node*>(::operator new(children + entry_capacity * sizeof(entry)));
+            created->references = 1;
+            created->count = 0;
+            created->datamap = 0;
+            created->nodemap = 0;
+            created->entry_capacity = entry_capacity;
+            created->child_capacity = child_capacity;
+            return created;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        void hash_trie<Key, Value, Hash, KeyEqual>::release(node* current) noexcept
+        {
+            if (!current || !persistent_release(current))
+                return;
+
+            entry* entries = current->entries();
+            for (uint32_t i = 0; i < current->count; ++i)
+                entries[i].~entry();
+
+            node** children = current->children();
+            for (int i = 0, count = popcount(current->nodemap); i < count; ++i)
+                release(children[i]);
+
+            ::operator delete(current);
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        hash_trie<Key, Value, Hash, KeyEqual>::node* hash_trie<Key, Value, Hash, KeyEqual>::own(node*& slot, uint32_t extra_entries, uint32_t extra_children)
+        {
+            node* current = slot;
+            const uint32_t child_count = static_cast<uint32_t>(popcount(current->nodemap));
+            const uint32_t entries = current->count + extra_entries;
+            const uint32_t children = child_count + extra_children;
+            const bool unique = persistent_unique(current);
+
+            if (unique && entries <= current->entry_capacity && children <= current->child_capacity)
+                return current;
+
+            // A node only this trie references is being filled through a transient and gets room
+            // for more; a shared one is copied to the size it needs.
+            uint32_t entry_capacity = entries;
+            uint32_t child_capacity = children;
+            if (unique)
+            {
+                const uint32_t doubled_entries = current->entry_capacity * 2 < persistent_branching ? current->entry_capacity * 2 : persistent_branching;
+                const uint32_t doubled_children = current->child_capacity * 2 < persistent_branching ? current->child_capacity * 2 : persistent_branching;
+                entry_capacity = entries > doubled_entries ? entries : doubled_entries;
+                child_capacity = children > doubled_children ? children : doubled_children;
+            }
+
+            node* copy = allocate(entry_capacity, child_capacity);
+            copy->count = current->count;
+            copy->datamap = current->datamap;
+            copy->nodemap = current->nodemap;
+
+            entry* from = current->entries();
+            entry* to = copy->entries();
+            for (uint32_t i = 0; i < current->count; ++i)
+            {
+                if (unique)
+                {
+                    new (to + i) entry(move(from[i]));
+                    from[i].~entry();
+                }
+                else
+                {
+                    new (to + i) entry(from[i]);
+                }
+            }
+
+            for (uint32_t i = 0; i < child_count; ++i)
+            {
+                copy->children()[i] = current->children()[i];
+                if (!unique)
+                    persistent_retain(copy->children()[i]);
+            }
+
+            if (unique)
+                ::operator delete(current);
+            else
+                release(current);
+
+            slot = copy;
+            return copy;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        template<class V>
+        hash_trie<Key, Value, Hash, KeyEqual>::node* hash_trie<Key, Value, Hash, KeyEqual>::make_pair(uint32_t shift, entry&& existing, size_t existing_hash, const Key& key, V&& value, size_t hash)
+        {
+            if (shift >= hash_bits)
+            {
+                node* created = allocate(2, 0);
+                emplace_entry(created, 0, move(existing));
+                emplace_entry(created, 1, key, forward<V>(value));
+                return created;
+            }
+
+            const uint32_t existing_bit = bit_of(existing_hash, shift);
+            const uint32_t bit = bit_of(hash, shift);
+
+            if (existing_bit == bit)
+            {
+                node* created = allocate(0, 1);
+                insert_child(created, 0, make_pair(shift + persistent_bits, move(existing), existing_hash, key, forward<V>(value), hash));
+                created->nodemap = bit;
+                return created;
+            }
+
+            // Entries are in the order of their bits.
+            node* created = allocate(2, 0);
+            if (existing_bit < bit)
+            {
+                emplace_entry(created, 0, move(existing));
+                emplace_entry(created, 1, key, forward<V>(value));
+            }
+            else
+            {
+                emplace_entry(created, 0, key, forward<V>(value));
+                emplace_entry(created, 1, move(existing));
+            }
+
+            created->datamap = existing_bit | bit;
+            return created;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        template<class... Args>
+        void hash_trie<Key, Value, Hash, KeyEqual>::emplace_entry(node* current, uint32_t index, Args&&... args)
+        {
+            entry* entries = current->entries();
+            for (uint32_t i = current->count; i > index; --i)
+            {
+                new (entries + i) entry(move(entries[i - 1]));
+                entries[i - 1].~entry();
+            }
+
+            new (entries + index) entry{ forward<Args>(args)... };
+            ++current->count;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        void hash_trie<Key, Value, Hash, KeyEqual>::remove_entry(node* current, uint32_t index) noexcept
+        {
+            entry* entries = current->entries();
+            entries[index].~entry();
+
+            for (uint32_t i = index + 1; i < current->count; ++i)
+            {
+                new (entries + i - 1) entry(move(entries[i]));
+                entries[i].~entry();
+            }
+
+            --current->count;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        void hash_trie<Key, Value, Hash, KeyEqual>::insert_child(node* current, uint32_t index, node* child) noexcept
+        {
+            node** children = current->children();
+            for (uint32_t i = static_cast<uint32_t>(popcount(current->nodemap)); i > index; --i)
+                children[i] = children[i - 1];
+
+            children[index] = child;
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        void hash_trie<Key, Value, Hash, KeyEqual>::remove_child(node* current, uint32_t index) noexcept
+        {
+            node** children = current->children();
+            for (uint32_t i = index + 1, count = static_cast<uint32_t>(popcount(current->nodemap)); i < count; ++i)
+                children[i - 1] = children[i];
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        template<class V>
+        bool hash_trie<Key, Value, Hash, KeyEqual>::set(node*& slot, uint32_t shift, size_t hash, const Key& key, V&& value)
+        {
+            if (shift >= hash_bits)
+            {
+                entry* entries = slot->entries();
+                for (uint32_t i = 0; i < slot->count; ++i)
+                {
+                    if (KeyEqual()(entries[i].key, key))
+                    {
+                        own(slot, 0, 0)->entries()[i].value = forward<V>(value);
+                        return false;
+                    }
+                }
+
+                node* current = own(slot, 1, 0);
+                emplace_entry(current, current->count, key, forward<V>(value));
+                return true;
+            }
+
+            const uint32_t bit = bit_of(hash, shift);
+            if (slot->datamap & bit)
+            {
+                const uint32_t index = static_cast<uint32_t>(popcount(slot->datamap & (bit - 1)));
+                if (KeyEqual()(slot->entries()[index].key, key))
+                {
+                    own(slot, 0, 0)->entries()[index].value = forward<V>(value);
+                    return false;
+                }
+
+                // Another key already has this fragment: both go one level down, to a new child.
+                node* current = own(slot, 0, 1);
+                entry& existing = current->entries()[index];
+                const size_t existing_hash = hash_of(existing.key);
+                node* child = make_pair(shift + persistent_bits, move(existing), existing_hash, key, forward<V>(value), hash);
+
+                remove_entry(current, index);
+                insert_child(current, static_cast<uint32_t>(popcount(current->nodemap & (bit - 1))), child);
+                current->datamap &= ~bit;
+                current->nodemap |= bit;
+                return true;
+            }
+
+            if (slot->nodemap & bit)
+            {
+                node* current = own(slot, 0, 0);
+                return set(current->children()[popcount(current->nodemap & (bit - 1))], shift + persistent_bits, hash, key, forward<V>(value));
+            }
+
+            node* current = own(slot, 1, 0);
+            emplace_entry(current, static_cast<uint32_t>(popcount(current->datamap & (bit - 1))), key, forward<V>(value));
+            current->datamap |= bit;
+            return true;
+        }
+
+        // key is known to be present below slot.
+        template<class Key, class Value, class Hash, class KeyEqual>
+        void hash_trie<Key, Value, Hash, KeyEqual>::erase(node*& slot, uint32_t shift, size_t hash, const Key& key)
+        {
+            node* current = own(slot, 0, 0);
+
+            if (shift >= hash_bits)
+            {
+                entry* entries = current->entries();
+                for (uint32_t i = 0; i < current->count; ++i)
+                {
+                    if (KeyEqual()(entries[i].key, key))
+                    {
+                        remove_entry(current, i);
+                        return;
+                    }
+                }
+                return;
+            }
+
+            const uint32_t bit = bit_of(hash, shift);
+            if (current->datamap & bit)
+            {
+                remove_entry(current, static_cast<uint32_t>(popcount(current->datamap & (bit - 1))));
+                current->datamap &= ~bit;
+                return;
+            }
+
+            const uint32_t index = static_cast<uint32_t>(popcount(current->nodemap & (bit - 1)));
+            erase(current->children()[index], shift + persistent_bits, hash, key);
+
+            // A child left with a single entry folds back into this node. The erase just made
+            // the child this trie's own, so its entry can be moved.
+            node* child = current->children()[index];
+            if (child->count != 1 || child->nodemap != 0)
+                return;
+
+            current = own(slot, 1, 0);
+            emplace_entry(current, static_cast<uint32_t>(popcount(current->datamap & (bit - 1))), move(child->entries()[0]));
+            remove_child(current, index);
+            current->nodemap &= ~bit;
+            current->datamap |= bit;
+            release(child);
+        }
+
+        template<class Key, class Value, class Hash, class KeyEqual>
+        template<class F>
+        void hash_trie<Key, Value, Hash, KeyEqual>::visit(node* current, F& f)
+        {
+            const entry* entries = current->entries();
+            for (uint32_t i = 0; i < current->count; ++i)
+                f(entries[i].key, entries[i].value);
+
+            node** children = current->children();
+            for (int i = 0, count = popcount(current->nodemap); i < count; ++i)
+                visit(children[i], f);
+        }
+    }
+
+
+    // persistent_vector::const_iterator
+    // Constructors implementations
+    template<class T>
+    persistent_vector<T>::const_iterator::const_iterator(const detail::vector_trie<T>* trie, size_t index) noexcept
+        : m_trie(trie), m_values(index < trie->size() ? trie->values_of(index) : nullptr), m_index(index)
+    {
+    }
+
+    // Operators
+    template<class T>
+    persistent_vector<T>::const_iterator::reference persistent_vector<T>::const_iterator::operator*() const noexcept
+    {
+        return m_values[m_index & detail::persistent_mask];
+    }
+
+    template<class T>
+    persistent_vector<T>::const_iterator::pointer persistent_vector<T>::const_iterator::operator->() const noexcept
+    {
+        return m_values + (m_index & detail::persistent_mask);
+    }
+
+    template<class T>
+    persistent_vector<T>::const_iterator& persistent_vector<T>::const_iterator::operator++() noexcept
+    {
+        // Leaves hold 32 values each, the tail included, starting on multiples of 32.
+        if ((++m_index & detail::persistent_mask) == 0)
+            m_values = m_index < m_trie->size() ? m_trie->values_of(m_index) : nullptr;
+
+        return *this;
+    }
+
+    template<class T>
+    persistent_vector<T>::const_iterator persistent_vector<T>::const_iterator::operator++(int) noexcept
+    {
+        const_iterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    template<class T>
+    bool persistent_vector<T>::const_iterator::operator==(const const_iterator& other) const noexcept
+    {
+        return m_index == other.m_index;
+    }
+
+
+    // persistent_vector
+    // Constructors implementations
+    template<class T>
+    persistent_vector<T>::persistent_vector(const detail::vector_trie<T>& trie) noexcept : m_trie(trie)
+    {
+    }
+
+    // Operators
+    template<class T>
+    persistent_vector<T>::const_reference persistent_vector<T>::operator[](size_type index) const noexcept
+    {
+        return m_trie.get(index);
+    }
+
+    // Member functions
+    template<class T>
+    persistent_vector<T>::const_reference persistent_vector<T>::front() const noexcept
+    {
+        return m_trie.get(0);
+    }
+
+    template<class T>
+    persistent_vector<T>::const_reference persistent_vector<T>::back() const noexcept
+    {
+        return m_trie.get(m_trie.size() - 1);
+    }
+
+    template<class T>
+    persistent_vector<T>::const_iterator persistent_vector<T>::begin() const noexcept
+    {
+        return const_iterator(&m_trie, 0);
+    }
+
+    template<class T>
+    persistent_vector<T>::const_iterator persistent_vector<T>::end() const noexcept
+    {
+        return const_iterator(&m_trie, m_trie.size());
+    }
+
+    template<class T>
+    bool persistent_vector<T>::empty() const noexcept
+    {
+        return m_trie.size() == 0;
+    }
+
+    template<class T>
+    persistent_vector<T>::size_type persistent_vector<T>::size() const noexcept
+    {
+        return m_trie.size();
+    }
+
+    // The copy shares every node with this version, so the change below copies the path it
+    // touches and nothing more.
+    template<class T>
+    template<class U>
+    persistent_vector<T> persistent_vector<T>::push_back(U&& value) const
+    {
+        persistent_vector result(m_trie);
+        result.m_trie.push_back(forward<U>(value));
+        return result;
+    }
+
+    template<class T>
+    persistent_vector<T> persistent_vector<T>::pop_back() const noexcept
+    {
+        persistent_vector result(m_trie);
+        result.m_trie.pop_back();
+        return result;
+    }
+
+    template<class T>
+    template<class U>
+    persistent_vector<T> persistent_vector<T>::set(size_type index, U&& value) const
+    {
+        persistent_vector result(m_trie);
+        result.m_trie.set(index, forward<U>(value));
+        return result;
+    }
+
+    template<class T>
+    transient_vector<T> persistent_vector<T>::transient() const noexcept
+    {
+        return transient_vector<T>(*this);
+    }
+
+
+    // transient_vector
+    // Constructors implementations
+    template<class T>
+    transient_vector<T>::transient_vector(const persistent_vector<T>& source) noexcept : m_trie(source.m_trie)
+    {
+    }
+
+    // Operators
+    template<class T>
+    transient_vector<T>::const_reference transient_vector<T>::operator[](size_type index) const noexcept
+    {
+        return m_trie.get(index);
+    }
+
+    // Member functions
+    template<class T>
+    transient_vector<T>::const_reference transient_vector<T>::front() const noexcept
+    {
+        return m_trie.get(0);
+    }
+
+    template<class T>
+    transient_vector<T>::const_reference transient_vector<T>::back() const noexcept
+    {
+        return m_trie.get(m_trie.size() - 1);
+    }
+
+    template<class T>
+    bool transient_vector<T>::empty() const noexcept
+    {
+        return m_trie.size() == 0;
+    }
+
+    template<class T>
+    transient_vector<T>::size_type transient_vector<T>::size() const noexcept
+    {
+        return m_trie.size();
+    }
+
+    template<class T>
+    template<class U>
+    void transient_vector<T>::push_back(U&& value)
+    {
+        m_trie.push_back(forward<U>(value));
+    }
+
+    template<class T>
+    void transient_vector<T>::pop_back() noexcept
+    {
+        m_trie.pop_back();
+    }
+
+    template<class T>
+    template<class U>
+    void transient_vector<T>::set(size_type index, U&& value)
+    {
+        m_trie.set(index, forward<U>(value));
+    }
+
+    template<class T>
+    void transient_vector<T>::clear() noexcept
+    {
+        m_trie.clear();
+    }
+
+    template<class T>
+    persistent_vector<T> transient_vector<T>::persistent() const noexcept
+    {
+        return persistent_vector<T>(m_trie);
+    }
+
+
+    // persistent_hash_map
+    // Constructors implementations
+    template<class Key, class Value, class Hash, class KeyEqual>
+    persistent_hash_map<Key, Value, Hash, KeyEqual>::persistent_hash_map(const detail::hash_trie<Key, Value, Hash, KeyEqual>& trie) noexcept
+        : m_trie(trie)
+    {
+    }
+
+    // Member functions
+    template<class Key, class Value, class Hash, class KeyEqual>
+    const Value* persistent_hash_map<Key, Value, Hash, KeyEqual>::find(const Key& key) const
+    {
+        return m_trie.find(key);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    bool persistent_hash_map<Key, Value, Hash, KeyEqual>::contains(const Key& key) const
+    {
+        return m_trie.find(key) != nullptr;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    template<class V>
+    persistent_hash_map<Key, Value, Hash, KeyEqual> persistent_hash_map<Key, Value, Hash, KeyEqual>::set(const Key& key, V&& value) const
+    {
+        persistent_hash_map result(m_trie);
+        result.m_trie.set(key, forward<V>(value));
+        return result;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    persistent_hash_map<Key, Value, Hash, KeyEqual> persistent_hash_map<Key, Value, Hash, KeyEqual>::erase(const Key& key) const
+    {
+        persistent_hash_map result(m_trie);
+        result.m_trie.erase(key);
+        return result;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    transient_hash_map<Key, Value, Hash, KeyEqual> persistent_hash_map<Key, Value, Hash, KeyEqual>::transient() const noexcept
+    {
+        return transient_hash_map<Key, Value, Hash, KeyEqual>(*this);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    template<class F>
+    void persistent_hash_map<Key, Value, Hash, KeyEqual>::visit_all(F f) const
+    {
+        m_trie.visit_all(f);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    persistent_hash_map<Key, Value, Hash, KeyEqual>::size_type persistent_hash_map<Key, Value, Hash, KeyEqual>::size() const noexcept
+    {
+        return m_trie.size();
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    bool persistent_hash_map<Key, Value, Hash, KeyEqual>::empty() const noexcept
+    {
+        return m_trie.size() == 0;
+    }
+
+
+    // transient_hash_map
+    // Constructors implementations
+    template<class Key, class Value, class Hash, class KeyEqual>
+    transient_hash_map<Key, Value, Hash, KeyEqual>::transient_hash_map(const persistent_hash_map<Key, Value, Hash, KeyEqual>& source) noexcept
+        : m_trie(source.m_trie)
+    {
+    }
+
+    // Member functions
+    template<class Key, class Value, class Hash, class KeyEqual>
+    const Value* transient_hash_map<Key, Value, Hash, KeyEqual>::find(const Key& key) const
+    {
+        return m_trie.find(key);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    bool transient_hash_map<Key, Value, Hash, KeyEqual>::contains(const Key& key) const
+    {
+        return m_trie.find(key) != nullptr;
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    template<class V>
+    bool transient_hash_map<Key, Value, Hash, KeyEqual>::set(const Key& key, V&& value)
+    {
+        return m_trie.set(key, forward<V>(value));
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    bool transient_hash_map<Key, Value, Hash, KeyEqual>::erase(const Key& key)
+    {
+        return m_trie.erase(key);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    void transient_hash_map<Key, Value, Hash, KeyEqual>::clear() noexcept
+    {
+        m_trie.clear();
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    persistent_hash_map<Key, Value, Hash, KeyEqual> transient_hash_map<Key, Value, Hash, KeyEqual>::persistent() const noexcept
+    {
+        return persistent_hash_map<Key, Value, Hash, KeyEqual>(m_trie);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    template<class F>
+    void transient_hash_map<Key, Value, Hash, KeyEqual>::visit_all(F f) const
+    {
+        m_trie.visit_all(f);
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    transient_hash_map<Key, Value, Hash, KeyEqual>::size_type transient_hash_map<Key, Value, Hash, KeyEqual>::size() const noexcept
+    {
+        return m_trie.size();
+    }
+
+    template<class Key, class Value, class Hash, class KeyEqual>
+    bool transient_hash_map<Key, Value, Hash, KeyEqual>::empty() const noexcept
+    {
+        return m_trie.size() == 0;
+    }
+}
+
+
+#endif //STL_PERSISTENT_HPP
@@ -0,0 +1,2111 @@
+#ifndef STL_RANGES_HPP
+#define STL_RANGES_HPP
+
+
+#include "cstddef.hpp"
+#include "concepts.hpp"
+#include "iterator.hpp"
+#include "new.hpp"
+#include "span.hpp"
+#include "string_view.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+namespace std
+{
+    namespace ranges
+    {
+        template<class T>
+        inline constexpr bool enable_borrowed_range = false;
+
+        // Access customization points. Only arrays and member begin/end/size are looked at, there is
+        // no argument dependent lookup.
+        namespace detail
+        {
+            template<class R>
+            concept maybe_borrowed = is_lvalue_reference_v<R> || enable_borrowed_range<remove_cvref_t<R>>;
+
+            template<class R>
+            concept member_begin = requires(R& range) { { range.begin() } -> input_or_output_iterator; };
+
+            template<class R>
+            concept member_end = requires(R& range) { { range.end() } -> sentinel_for<decltype(range.begin())>; };
+
+            template<class R>
+            concept member_size = requires(R& range) { { range.size() } -> integral; };
+
+            struct begin_fn
+            {
+                template<class R> requires maybe_borrowed<R> && (is_array_v<remove_reference_t<R>> || member_begin<R>)
+                constexpr auto operator()(R&& range) const noexcept;
+            };
+
+            struct end_fn
+            {
+                template<class R> requires maybe_borrowed<R> && (is_array_v<remove_reference_t<R>> || member_end<R>)
+                constexpr auto operator()(R&& range) const noexcept;
+            };
+        }
+
+        inline constexpr detail::begin_fn begin{};
+        inline constexpr detail::end_fn end{};
+
+        template<class T>
+        using iterator_t = decltype(ranges::begin(declval<T&>()));
+
+        template<class R>
+        concept range = requires(R& r)
+        {
+            ranges::begin(r);
+            ranges::end(r);
+        };
+
+        template<range R>
+        using sentinel_t = decltype(ranges::end(declval<R&>()));
+
+        namespace detail
+        {
+            template<class R>
+            concept size_from_iterators = range<R> && sized_sentinel_for<sentinel_t<R>, iterator_t<R>>;
+
+            struct size_fn
+            {
+                template<class R> requires is_array_v<remove_reference_t<R>> || member_size<R> || size_from_iterators<R>
+                constexpr size_t operator()(R&& range) const noexcept;
+            };
+        }
+
+        inline constexpr detail::size_fn size{};
+
+        template<range R>
+        using range_difference_t = iter_difference_t<iterator_t<R>>;
+        template<range R>
+        using range_value_t = iter_value_t<iterator_t<R>>;
+        template<range R>
+        using range_reference_t = iter_reference_t<iterator_t<R>>;
+
+        // Range concepts
+        template<class R>
+        concept borrowed_range = range<R> && detail::maybe_borrowed<R>;
+
+        template<class R>
+        concept sized_range = range<R> && requires(R& r) { ranges::size(r); };
+
+        template<class R>
+        concept input_range = range<R> && input_iterator<iterator_t<R>>;
+
+        template<class R>
+        concept forward_range = input_range<R> && forward_iterator<iterator_t<R>>;
+
+        template<class R>
+        concept bidirectional_range = forward_range<R> && bidirectional_iterator<iterator_t<R>>;
+
+        template<class R>
+        concept random_access_range = bidirectional_range<R> && random_access_iterator<iterator_t<R>>;
+
+        template<class R>
+        concept contiguous_range = random_access_range<R> && contiguous_iterator<iterator_t<R>>;
+
+        template<class R>
+        concept common_range = range<R> && same_as<iterator_t<R>, sentinel_t<R>>;
+
+        // Views: ranges that are cheap to move and do not own their elements (owning_view aside)
+        struct view_base { };
+
+        template<class T>
+        inline constexpr bool enable_view = derived_from<T, view_base>;
+
+        template<class T>
+        concept view = range<T> && movable<T> && enable_view<T>;
+
+        template<class T>
+        concept viewable_range = range<T>
+                                 && ((view<remove_cvref_t<T>> && constructible_from<remove_cvref_t<T>, T>)
+                                     || (!view<remove_cvref_t<T>> && (is_lvalue_reference_v<T> || movable<remove_reference_t<T>>)));
+
+        template<class T>
+        inline constexpr bool enable_view<span<T>> = true;
+        template<class T>
+        inline constexpr bool enable_borrowed_range<span<T>> = true;
+        template<class CharT>
+        inline constexpr bool enable_view<basic_string_view<CharT>> = true;
+        template<class CharT>
+        inline constexpr bool enable_borrowed_range<basic_string_view<CharT>> = true;
+
+        template<class Derived>
+        class view_interface : public view_base
+        {
+        public:
+            constexpr bool empty() requires forward_range<Derived>;
+            constexpr explicit operator bool() requires forward_range<Derived>;
+            constexpr decltype(auto) front() requires forward_range<Derived>;
+        private:
+            constexpr Derived& derived() noexcept;
+        };
+
+        template<input_or_output_iterator I, sentinel_for<I> S = I>
+        class subrange : public view_interface<subrange<I, S>>
+        {
+        public:
+            /// Constructors
+            constexpr subrange() requires default_initializable<I> = default;
+            constexpr subrange(I first, S last);
+
+            /// Member functions
+            constexpr I begin() const;
+            constexpr S end() const;
+            constexpr bool empty() const;
+            constexpr size_t size() const requires sized_sentinel_for<S, I>;
+        private:
+            I m_begin = I();
+            S m_end = S();
+        };
+
+        template<class I, class S>
+        inline constexpr bool enable_borrowed_range<subrange<I, S>> = true;
+
+        template<range R> requires is_object_v<R>
+        class ref_view : public view_interface<ref_view<R>>
+        {
+        public:
+            /// Constructors
+            constexpr ref_view(R& range) noexcept;
+
+            /// Member functions
+            constexpr R& base() const noexcept;
+            constexpr iterator_t<R> begin() const;
+            constexpr sentinel_t<R> end() const;
+            constexpr bool empty() const;
+            constexpr size_t size() const requires sized_range<R>;
+        private:
+            R* m_range;
+        };
+
+        template<class R>
+        inline constexpr bool enable_borrowed_range<ref_view<R>> = true;
+
+        // Keeps an rvalue range alive for as long as the pipeline built on it.
+        template<range R> requires movable<R>
+        class owning_view : public view_interface<owning_view<R>>
+        {
+        public:
+            /// Constructors
+            constexpr owning_view(R&& range);
+            owning_view(owning_view&&) = default;
+
+            /// Operators
+            owning_view& operator=(owning_view&&) = default;
+
+            /// Member functions
+            constexpr R& base() noexcept;
+            constexpr iterator_t<R> begin();
+            constexpr sentinel_t<R> end();
+            constexpr size_t size() requires sized_range<R>;
+        private:
+            R m_range;
+        };
+
+        namespace detail
+        {
+            // Wraps a function object so that the view holding it stays assignable, which
+            // lambdas with captures are not.
+            template<class T> requires is_object_v<T>
+            class movable_box
+            {
+            public:
+                /// Constructors
+                constexpr movable_box() requires default_initializable<T>;
+                constexpr movable_box(const T& value);
+                constexpr movable_box(T&& value);
+                constexpr movable_box(const movable_box& other);
+                constexpr movable_box(movable_box&& other);
+
+                /// Destructor
+                constexpr ~movable_box();
+
+                /// Operators
+                constexpr movable_box& operator=(const movable_box& other);
+                constexpr movable_box& operator=(movable_box&& other);
+
+                constexpr T& operator*() noexcept;
+                constexpr const T& operator*() const noexcept;
+            private:
+                union { T m_value; };
+            };
+
+            // Storage for a value computed on demand by a view. Copying the view starts from an
+            // empty cache, so cached iterators never point into another object.
+            template<class T> requires is_object_v<T>
+            class non_propagating_cache
+            {
+            public:
+                /// Constructors
+                constexpr non_propagating_cache() noexcept;
+                constexpr non_propagating_cache(const non_propagating_cache&) noexcept;
+                constexpr non_propagating_cache(non_propagating_cache&& other) noexcept;
+
+                /// Destructor
+                constexpr ~non_propagating_cache();
+
+                /// Operators
+                constexpr non_propagating_cache& operator=(const non_propagating_cache& other) noexcept;
+                constexpr non_propagating_cache& operator=(non_propagating_cache&& other) noexcept;
+
+                constexpr T& operator*() noexcept;
+
+                /// Member functions
+                constexpr bool has_value() const noexcept;
+                template<class... Args>
+                constexpr T& emplace(Args&&... args);
+                constexpr void reset() noexcept;
+            private:
+                union { T m_value; };
+                bool m_engaged;
+            };
+
+            template<class V>
+            using iterator_concept_of = conditional_t<random_access_range<V>, random_access_iterator_tag,
+                                        conditional_t<bidirectional_range<V>, bidirectional_iterator_tag,
+                                        conditional_t<forward_range<V>, forward_iterator_tag, input_iterator_tag>>>;
+
+            template<class V, class Pred>
+            concept filterable = view<V> && input_range<V> && is_object_v<Pred>
+                                 && indirect_unary_predicate<const Pred, iterator_t<V>>;
+
+            template<class V, class F>
+            concept transformable = view<V> && input_range<V> && is_object_v<F> && copy_constructible<F>
+                                    && regular_invocable<F&, range_reference_t<V>>;
+
+            template<class V>
+            concept splittable = view<V> && forward_range<V> && equality_comparable<range_value_t<V>>;
+
+            template<class V>
+            concept joinable = view<V> && input_range<V> && input_range<range_reference_t<V>>;
+
+            struct empty_cache { };
+        }
+
+        // Elements of base for which pred returns true.
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        class filter_view : public view_interface<filter_view<V, Pred>>
+        {
+        public:
+            class sentinel;
+
+            class iterator
+            {
+            public:
+                /// Member types
+                using iterator_concept = conditional_t<bidirectional_range<V>, bidirectional_iterator_tag,
+                                         conditional_t<forward_range<V>, forward_iterator_tag, input_iterator_tag>>;
+                using iterator_category = iterator_concept;
+                using value_type = range_value_t<V>;
+                using difference_type = range_difference_t<V>;
+
+                /// Constructors
+                iterator() = default;
+                constexpr iterator(filter_view& parent, iterator_t<V> current);
+
+                /// Operators
+                constexpr range_reference_t<V> operator*() const;
+                constexpr iterator& operator++();
+                constexpr void operator++(int);
+                constexpr iterator operator++(int) requires forward_range<V>;
+                constexpr iterator& operator--() requires bidirectional_range<V>;
+                constexpr iterator operator--(int) requires bidirectional_range<V>;
+                constexpr bool operator==(const iterator& other) const requires equality_comparable<iterator_t<V>>;
+                constexpr bool operator==(const sentinel& other) const;
+
+                /// Member functions
+                constexpr const iterator_t<V>& base() const noexcept;
+            private:
+                iterator_t<V> m_current = iterator_t<V>();
+                filter_view* m_parent = nullptr;
+            };
+
+            class sentinel
+            {
+            public:
+                sentinel() = default;
+                constexpr explicit sentinel(sentinel_t<V> end);
+
+                constexpr sentinel_t<V> base() const;
+            private:
+                sentinel_t<V> m_end = sentinel_t<V>();
+            };
+
+            /// Constructors
+            constexpr filter_view(V base, Pred pred);
+
+            /// Member functions
+            constexpr V base() const& requires copy_constructible<V>;
+            constexpr const Pred& pred() const;
+
+            // The first match is searched once and cached, as begin() must be amortized O(1).
+            constexpr iterator begin();
+            constexpr auto end();
+        private:
+            V m_base;
+            detail::movable_box<Pred> m_pred;
+            detail::non_propagating_cache<iterator_t<V>> m_begin;
+        };
+
+        // function applied to each element of base, on dereference.
+        template<class V, class F> requires detail::transformable<V, F>
+        class transform_view : public view_interface<transform_view<V, F>>
+        {
+        public:
+            class sentinel;
+
+            class iterator
+            {
+            public:
+                /// Member types
+                using iterator_concept = detail::iterator_concept_of<V>;
+                using iterator_category = iterator_concept;
+                using reference = invoke_result_t<F&, range_reference_t<V>>;
+                using value_type = remove_cvref_t<reference>;
+                using difference_type = range_difference_t<V>;
+
+                /// Constructors
+                iterator() = default;
+                constexpr iterator(transform_view& parent, iterator_t<V> current);
+
+                /// Operators
+                constexpr reference operator*() const;
+                constexpr reference operator[](difference_type offset) const requires random_access_range<V>;
+
+                constexpr iterator& operator++();
+                constexpr void operator++(int);
+                constexpr iterator operator++(int) requires forward_range<V>;
+                constexpr iterator& operator--() requires bidirectional_range<V>;
+                constexpr iterator operator--(int) requires bidirectional_range<V>;
+                constexpr iterator& operator+=(difference_type offset) requires random_access_range<V>;
+                constexpr iterator& operator-=(difference_type offset) requires random_access_range<V>;
+                constexpr iterator operator+(difference_type offset) const requires random_access_range<V>;
+                constexpr iterator operator-(difference_type offset) const requires random_access_range<V>;
+                constexpr difference_type operator-(const iterator& other) const requires random_access_range<V>;
+
+                friend constexpr iterator operator+(difference_type offset, const iterator& it) requires random_access_range<V>
+                {
+                    return it + offset;
+                }
+
+                constexpr bool operator==(const iterator& other) const requires equality_comparable<iterator_t<V>>;
+                constexpr bool operator==(const sentinel& other) const;
+                constexpr bool operator<(const iterator& other) const requires random_access_range<V>;
+                constexpr bool operator>(const iterator& other) const requires random_access_range<V>;
+                constexpr bool operator<=(const iterator& other) const requires random_access_range<V>;
+                constexpr bool operator>=(const iterator& other) const requires random_access_range<V>;
+
+                /// Member functions
+                constexpr const iterator_t<V>& base() const noexcept;
+            private:
+                iterator_t<V> m_current = iterator_t<V>();
+                transform_view* m_parent = nullptr;
+            };
+
+            class sentinel
+            {
+            public:
+                sentinel() = default;
+                constexpr explicit sentinel(sentinel_t<V> end);
+
+                constexpr sentinel_t<V> base() const;
+            private:
+                sentinel_t<V> m_end = sentinel_t<V>();
+            };
+
+            /// Constructors
+            constexpr transform_view(V base, F function);
+
+            /// Member functions
+            constexpr V base() const& requires copy_constructible<V>;
+            constexpr iterator begin();
+            constexpr auto end();
+            constexpr size_t size() requires sized_range<V>;
+        private:
+            V m_base;
+            detail::movable_box<F> m_function;
+        };
+
+        // The first count elements of base (or all of them when there are fewer).
+        template<view V>
+        class take_view : public view_interface<take_view<V>>
+        {
+        public:
+            class sentinel;
+
+            // Counts down to the end of the window, used when base is not sized random access
+            // (otherwise begin() and end() are plain base iterators).
+            class iterator
+            {
+            public:
+                /// Member types
+                using iterator_concept = conditional_t<forward_range<V>, forward_iterator_tag, input_iterator_tag>;
+                using iterator_category = iterator_concept;
+                using value_type = range_value_t<V>;
+                using difference_type = range_difference_t<V>;
+
+                /// Constructors
+                iterator() = default;
+                constexpr iterator(iterator_t<V> current, difference_type remaining);
+
+                /// Operators
+                constexpr range_reference_t<V> operator*() const;
+                constexpr iterator& operator++();
+                constexpr void operator++(int);
+                constexpr iterator operator++(int) requires forward_range<V>;
+                constexpr bool operator==(const iterator& other) const;
+                constexpr bool operator==(const sentinel& other) const;
+
+                /// Member functions
+                constexpr const iterator_t<V>& base() const noexcept;
+            private:
+                iterator_t<V> m_current = iterator_t<V>();
+                difference_type m_remaining = 0;
+            };
+
+            class sentinel
+            {
+            public:
+                sentinel() = default;
+                constexpr explicit sentinel(sentinel_t<V> end);
+
+                constexpr sentinel_t<V> base() const;
+            private:
+                sentinel_t<V> m_end = sentinel_t<V>();
+            };
+
+            /// Constructors
+            constexpr take_view(V base, range_difference_t<V> count);
+
+            /// Member functions
+            constexpr V base() const& requires copy_constructible<V>;
+            constexpr auto begin();
+            constexpr auto end();
+            constexpr size_t size() requires sized_range<V>;
+        private:
+            static constexpr bool direct = sized_range<V> && random_access_range<V>;
+
+            V m_base;
+            range_difference_t<V> m_count;
+        };
+
+        // base without its first count elements.
+        template<view V>
+        class drop_view : public view_interface<drop_view<V>>
+        {
+        public:
+            /// Constructors
+            constexpr drop_view(V base, range_difference_t<V> count);
+
+            /// Member functions
+            constexpr V base() const& requires copy_constructible<V>;
+            // O(count) on ranges that are not random access.
+            constexpr iterator_t<V> begin();
+            constexpr sentinel_t<V> end();
+            constexpr size_t size() requires sized_range<V>;
+        private:
+            V m_base;
+            range_difference_t<V> m_count;
+        };
+
+        // Subranges of base separated by a delimiter element. The delimiters are not part of the
+        // subranges, and a leading, trailing or doubled delimiter yields an empty subrange.
+        template<class V> requires detail::splittable<V>
+        class split_view : public view_interface<split_view<V>>
+        {
+        public:
+            class sentinel;
+
+            class iterator
+            {
+            public:
+                /// Member types
+                using iterator_concept = forward_iterator_tag;
+                using iterator_category = forward_iterator_tag;
+                using value_type = subrange<iterator_t<V>>;
+                using difference_type = range_difference_t<V>;
+
+                /// Constructors
+                iterator() = default;
+                constexpr iterator(split_view& parent, iterator_t<V> current, iterator_t<V> delimiter);
+
+                /// Operators
+                constexpr value_type operator*() const;
+                constexpr iterator& operator++();
+                constexpr iterator operator++(int);
+                constexpr bool operator==(const iterator& other) const;
+                constexpr bool operator==(const sentinel& other) const;
+
+                /// Member functions
+                constexpr const iterator_t<V>& base() const noexcept;
+            private:
+                split_view* m_parent = nullptr;
+                iterator_t<V> m_current = iterator_t<V>();      // start of the current subrange
+                iterator_t<V> m_delimiter = iterator_t<V>();    // its end: the next delimiter, or the end of base
+                bool m_trailing_empty = false;                  // base ends with a delimiter
+            };
+
+            class sentinel
+            {
+            public:
+                sentinel() = default;
+                constexpr explicit sentinel(sentinel_t<V> end);
+
+                constexpr sentinel_t<V> base() const;
+            private:
+                sentinel_t<V> m_end = sentinel_t<V>();
+            };
+
+            /// Constructors
+            constexpr split_view(V base, range_value_t<V> delimiter);
+
+            /// Member functions
+            constexpr V base() const& requires copy_constructible<V>;
+            constexpr iterator begin();
+            constexpr sentinel end();
+        private:
+            constexpr iterator_t<V> find_delimiter(iterator_t<V> from);
+
+            V m_base;
+            range_value_t<V> m_delimiter;
+        };
+
+        // Flattens a range of ranges.
+        template<class V> requires detail::joinable<V>
+        class join_view : public view_interface<join_view<V>>
+        {
+            using inner_range = range_reference_t<V>;
+            using inner_storage = remove_cvref_t<inner_range>;
+
+            // Inner ranges produced by value (by transform or split, say) live in the view while
+            // they are being walked, which limits the view to a single pass.
+            static constexpr bool inner_by_reference = is_reference<inner_range>;
+            using inner_cache = conditional_t<inner_by_reference, detail::empty_cache, inner_storage>;
+        public:
+            class sentinel;
+
+            class iterator
+            {
+                using inner_iterator = iterator_t<remove_reference_t<inner_range>>;
+            public:
+                /// Member types
+                using iterator_concept = conditional_t<inner_by_reference && forward_range<V> && forward_range<inner_range>,
+                                                       forward_iterator_tag, input_iterator_tag>;
+                using iterator_category = iterator_concept;
+                using value_type = range_value_t<inner_range>;
+                using difference_type = ptrdiff_t;
+
+                /// Constructors
+                iterator() = default;
+                constexpr iterator(join_view& parent, iterator_t<V> outer);
+
+                /// Operators
+                constexpr range_reference_t<inner_range> operator*() const;
+                constexpr iterator& operator++();
+                constexpr void operator++(int);
+                constexpr iterator operator++(int) requires same_as<iterator_concept, forward_iterator_tag>;
+                constexpr bool operator==(const iterator& other) const requires same_as<iterator_concept, forward_iterator_tag>;
+                constexpr bool operator==(const sentinel& other) const;
+            private:
+                constexpr void satisfy();
+
+                join_view* m_parent = nullptr;
+                iterator_t<V> m_outer = iterator_t<V>();
+                inner_iterator m_inner = inner_iterator();
+            };
+
+            class sentinel
+            {
+            public:
+                sentinel() = default;
+                constexpr explicit sentinel(sentinel_t<V> end);
+
+                constexpr sentinel_t<V> base() const;
+            private:
+                sentinel_t<V> m_end = sentinel_t<V>();
+            };
+
+            /// Constructors
+            constexpr explicit join_view(V base);
+
+            /// Member functions
+            constexpr V base() const& requires copy_constructible<V>;
+            constexpr iterator begin();
+            constexpr sentinel end();
+        private:
+            V m_base;
+            detail::non_propagating_cache<inner_cache> m_inner;
+        };
+
+        // Element of enumerate_view, made for structured bindings: auto [index, value] = *it;
+        template<class Index, class Reference>
+        struct enumerate_result
+        {
+            Index index;
+            Reference value;
+        };
+
+        // Pairs every element of base with its position.
+        template<view V> requires input_range<V>
+        class enumerate_view : public view_interface<enumerate_view<V>>
+        {
+        public:
+            class sentinel;
+
+            class iterator
+            {
+            public:
+                /// Member types
+                using iterator_concept = conditional_t<bidirectional_range<V>, bidirectional_iterator_tag,
+                                         conditional_t<forward_range<V>, forward_iterator_tag, input_iterator_tag>>;
+                using iterator_category = iterator_concept;
+                using difference_type = range_difference_t<V>;
+                using value_type = enumerate_result<difference_type, range_value_t<V>>;
+                using reference = enumerate_result<difference_type, range_reference_t<V>>;
+
+                /// Constructors
+                iterator() = default;
+                constexpr iterator(iterator_t<V> current, difference_type index);
+
+                /// Operators
+                constexpr reference operator*() const;
+                constexpr iterator& operator++();
+                constexpr void operator++(int);
+                constexpr iterator operator++(int) requires forward_range<V>;
+                constexpr iterator& operator--() requires bidirectional_range<V>;
+                constexpr iterator operator--(int) requires bidirectional_range<V>;
+                constexpr bool operator==(const iterator& other) const;
+                constexpr bool operator==(const sentinel& other) const;
+
+                /// Member functions
+                constexpr const iterator_t<V>& base() const noexcept;
+                constexpr difference_type index() const noexcept;
+            private:
+                iterator_t<V> m_current = iterator_t<V>();
+                difference_type m_index = 0;
+            };
+
+            class sentinel
+            {
+            public:
+                sentinel() = default;
+                constexpr explicit sentinel(sentinel_t<V> end);
+
+                constexpr sentinel_t<V> base() const;
+            private:
+                sentinel_t<V> m_end = sentinel_t<V>();
+            };
+
+            /// Constructors
+            constexpr explicit enumerate_view(V base);
+
+            /// Member functions
+            constexpr V base() const& requires copy_constructible<V>;
+            constexpr iterator begin();
+            constexpr sentinel end();
+            constexpr size_t size() requires sized_range<V>;
+        private:
+            V m_base;
+        };
+
+
+        // Range adaptors
+        // views::filter(r, pred) and r | views::filter(pred) are the same view, and closures
+        // compose: auto stage = views::transform(f) | views::take(8); r | stage.
+        namespace detail
+        {
+            struct range_adaptor_closure { };
+
+            template<class T>
+            concept adaptor_closure = derived_from<remove_cvref_t<T>, range_adaptor_closure>;
+
+            // An adaptor with its trailing argument bound, waiting for the range.
+            template<class Adaptor, class Argument>
+            struct bound_adaptor : range_adaptor_closure
+            {
+                Argument argument;
+
+                template<viewable_range R>
+                constexpr auto operator()(R&& range) const;
+            };
+
+            template<class First, class Second>
+            struct composed_adaptor : range_adaptor_closure
+            {
+                First first;
+                Second second;
+
+                template<viewable_range R>
+                constexpr auto operator()(R&& range) const;
+            };
+
+            template<viewable_range R, adaptor_closure Closure> requires invocable<const remove_cvref_t<Closure>&, R>
+            constexpr auto operator|(R&& range, Closure&& closure);
+
+            template<adaptor_closure First, adaptor_closure Second>
+            constexpr auto operator|(First&& first, Second&& second);
+
+            struct all_fn : range_adaptor_closure
+            {
+                template<viewable_range R>
+                constexpr auto operator()(R&& range) const;
+            };
+
+            struct filter_fn
+            {
+                template<viewable_range R, class Pred>
+                constexpr auto operator()(R&& range, Pred&& pred) const;
+                template<class Pred>
+                constexpr auto operator()(Pred&& pred) const;
+            };
+
+            struct transform_fn
+            {
+                template<viewable_range R, class F>
+                constexpr auto operator()(R&& range, F&& function) const;
+                template<class F>
+                constexpr auto operator()(F&& function) const;
+            };
+
+            struct take_fn
+            {
+                template<viewable_range R>
+                constexpr auto operator()(R&& range, ptrdiff_t count) const;
+                constexpr auto operator()(ptrdiff_t count) const;
+            };
+
+            struct drop_fn
+            {
+                template<viewable_range R>
+                constexpr auto operator()(R&& range, ptrdiff_t count) const;
+                constexpr auto operator()(ptrdiff_t count) const;
+            };
+
+            struct split_fn
+            {
+                template<viewable_range R>
+                constexpr auto operator()(R&& range, range_value_t<R> delimiter) const;
+                template<class T>
+                constexpr auto operator()(T&& delimiter) const;
+            };
+
+            struct join_fn : range_adaptor_closure
+            {
+                template<viewable_range R>
+                constexpr auto operator()(R&& range) const;
+            };
+
+            struct enumerate_fn : range_adaptor_closure
+            {
+                template<viewable_range R>
+                constexpr auto operator()(R&& range) const;
+            };
+        }
+
+        namespace views
+        {
+            inline constexpr detail::all_fn all{};
+
+            template<viewable_range R>
+            using all_t = decltype(all(declval<R>()));
+
+            inline constexpr detail::filter_fn filter{};
+            inline constexpr detail::transform_fn transform{};
+            inline constexpr detail::take_fn take{};
+            inline constexpr detail::drop_fn drop{};
+            inline constexpr detail::split_fn split{};
+            inline constexpr detail::join_fn join{};
+            inline constexpr detail::enumerate_fn enumerate{};
+        }
+
+        /// Deduction guides
+        template<class R>
+        ref_view(R&) -> ref_view<R>;
+        template<class R, class Pred>
+        filter_view(R&&, Pred) -> filter_view<views::all_t<R>, Pred>;
+        template<class R, class F>
+        transform_view(R&&, F) -> transform_view<views::all_t<R>, F>;
+        template<class R>
+        take_view(R&&, range_difference_t<R>) -> take_view<views::all_t<R>>;
+        template<class R>
+        drop_view(R&&, range_difference_t<R>) -> drop_view<views::all_t<R>>;
+        template<class R>
+        split_view(R&&, range_value_t<R>) -> split_view<views::all_t<R>>;
+        template<class R>
+        explicit join_view(R&&) -> join_view<views::all_t<R>>;
+        template<class R>
+        enumerate_view(R&&) -> enumerate_view<views::all_t<R>>;
+    }
+
+    namespace views = ranges::views;
+
+
+    namespace ranges
+    {
+        // Access customization points
+        namespace detail
+        {
+            template<class R> requires maybe_borrowed<R> && (is_array_v<remove_reference_t<R>> || member_begin<R>)
+            constexpr auto begin_fn::operator()(R&& range) const noexcept
+            {
+                if constexpr (is_array_v<remove_reference_t<R>>)
+                    return range + 0;
+                else
+                    return range.begin();
+            }
+
+            template<class R> requires maybe_borrowed<R> && (is_array_v<remove_reference_t<R>> || member_end<R>)
+            constexpr auto end_fn::operator()(R&& range) const noexcept
+            {
+                if constexpr (is_array_v<remove_reference_t<R>>)
+                    return range + sizeof(range) / sizeof(range[0]);
+                else
+                    return range.end();
+            }
+
+            template<class R> requires is_array_v<remove_reference_t<R>> || member_size<R> || size_from_iterators<R>
+            constexpr size_t size_fn::operator()(R&& range) const noexcept
+            {
+                if constexpr (is_array_v<remove_reference_t<R>>)
+                    return sizeof(range) / sizeof(range[0]);
+                else if constexpr (member_size<R>)
+                    return static_cast<size_t>(range.size());
+                else
+                    return static_cast<size_t>(ranges::end(range) - ranges::begin(range));
+            }
+        }
+
+
+        // view_interface
+        template<class Derived>
+        constexpr bool view_interface<Derived>::empty() requires forward_range<Derived>
+        {
+            return ranges::begin(derived()) == ranges::end(derived());
+        }
+
+        template<class Derived>
+        constexpr view_interface<Derived>::operator bool() requires forward_range<Derived>
+        {
+            return !empty();
+        }
+
+        template<class Derived>
+        constexpr decltype(auto) view_interface<Derived>::front() requires forward_range<Derived>
+        {
+            return *ranges::begin(derived());
+        }
+
+        template<class Derived>
+        constexpr Derived& view_interface<Derived>::derived() noexcept
+        {
+            return static_cast<Derived&>(*this);
+        }
+
+
+        // subrange
+        template<input_or_output_iterator I, sentinel_for<I> S>
+        constexpr subrange<I, S>::subrange(I first, S last) : m_begin(move(first)), m_end(move(last))
+        {
+        }
+
+        template<input_or_output_iterator I, sentinel_for<I> S>
+        constexpr I subrange<I, S>::begin() const
+        {
+            return m_begin;
+        }
+
+        template<input_or_output_iterator I, sentinel_for<I> S>
+        constexpr S subrange<I, S>::end() const
+        {
+            return m_end;
+        }
+
+        template<input_or_output_iterator I, sentinel_for<I> S>
+        constexpr bool subrange<I, S>::empty() const
+        {
+            return m_begin == m_end;
+        }
+
+        template<input_or_output_iterator I, sentinel_for<I> S>
+        constexpr size_t subrange<I, S>::size() const requires sized_sentinel_for<S, I>
+        {
+            return static_cast<size_t>(m_end - m_begin);
+        }
+
+
+        // ref_view
+        template<range R> requires is_object_v<R>
+        constexpr ref_view<R>::ref_view(R& range) noexcept : m_range(&range)
+        {
+        }
+
+        template<range R> requires is_object_v<R>
+        constexpr R& ref_view<R>::base() const noexcept
+        {
+            return *m_range;
+        }
+
+        template<range R> requires is_object_v<R>
+        constexpr iterator_t<R> ref_view<R>::begin() const
+        {
+            return ranges::begin(*m_range);
+        }
+
+        template<range R> requires is_object_v<R>
+        constexpr sentinel_t<R> ref_view<R>::end() const
+        {
+            return ranges::end(*m_range);
+        }
+
+        template<range R> requires is_object_v<R>
+        constexpr bool ref_view<R>::empty() const
+        {
+            return ranges::begin(*m_range) == ranges::end(*m_range);
+        }
+
+        template<range R> requires is_object_v<R>
+        constexpr size_t ref_view<R>::size() const requires sized_range<R>
+        {
+            return ranges::size(*m_range);
+        }
+
+
+        // owning_view
+        template<range R> requires movable<R>
+        constexpr owning_view<R>::owning_view(R&& range) : m_range(move(range))
+        {
+        }
+
+        template<range R> requires movable<R>
+        constexpr R& owning_view<R>::base() noexcept
+        {
+            return m_range;
+        }
+
+        template<range R> requires movable<R>
+        constexpr iterator_t<R> owning_view<R>::begin()
+        {
+            return ranges::begin(m_range);
+        }
+
+        template<range R> requires movable<R>
+        constexpr sentinel_t<R> owning_view<R>::end()
+        {
+            return ranges::end(m_range);
+        }
+
+        template<range R> requires movable<R>
+        constexpr size_t owning_view<R>::size() requires sized_range<R>
+        {
+            return ranges::size(m_range);
+        }
+
+
+        namespace detail
+        {
+            // movable_box
+            template<class T> requires is_object_v<T>
+            constexpr movable_box<T>::movable_box() requires default_initializable<T> : m_value()
+            {
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr movable_box<T>::movable_box(const T& value) : m_value(value)
+            {
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr movable_box<T>::movable_box(T&& value) : m_value(move(value))
+            {
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr movable_box<T>::movable_box(const movable_box& other) : m_value(other.m_value)
+            {
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr movable_box<T>::movable_box(movable_box&& other) : m_value(move(other.m_value))
+            {
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr movable_box<T>::~movable_box()
+            {
+                m_value.~T();
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr movable_box<T>& movable_box<T>::operator=(const movable_box& other)
+            {
+                if (this != &other)
+                {
+                    m_value.~T();
+                    ::new (&m_value) T(other.m_value);
+                }
+
+                return *this;
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr movable_box<T>& movable_box<T>::operator=(movable_box&& other)
+            {
+                if (this != &other)
+                {
+                    m_value.~T();
+                    ::new (&m_value) T(move(other.m_value));
+                }
+
+                return *this;
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr T& movable_box<T>::operator*() noexcept
+            {
+                return m_value;
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr const T& movable_box<T>::operator*() const noexcept
+            {
+                return m_value;
+            }
+
+
+            // non_propagating_cache
+            template<class T> requires is_object_v<T>
+            constexpr non_propagating_cache<T>::non_propagating_cache() noexcept : m_engaged(false)
+            {
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr non_propagating_cache<T>::non_propagating_cache(const non_propagating_cache&) noexcept : m_engaged(false)
+            {
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr non_propagating_cache<T>::non_propagating_cache(non_propagating_cache&& other) noexcept : m_engaged(false)
+            {
+                other.reset();
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr non_propagating_cache<T>::~non_propagating_cache()
+            {
+                reset();
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr non_propagating_cache<T>& non_propagating_cache<T>::operator=(const non_propagating_cache& other) noexcept
+            {
+                if (this != &other)
+                    reset();
+
+                return *this;
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr non_propagating_cache<T>& non_propagating_cache<T>::operator=(non_propagating_cache&& other) noexcept
+            {
+                reset();
+                other.reset();
+                return *this;
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr T& non_propagating_cache<T>::operator*() noexcept
+            {
+                return m_value;
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr bool non_propagating_cache<T>::has_value() const noexcept
+            {
+                return m_engaged;
+            }
+
+            template<class T> requires is_object_v<T>
+            template<class... Args>
+            constexpr T& non_propagating_cache<T>::emplace(Args&&... args)
+            {
+                reset();
+                ::new (&m_value) T(forward<Args>(args)...);
+                m_engaged = true;
+                return m_value;
+            }
+
+            template<class T> requires is_object_v<T>
+            constexpr void non_propagating_cache<T>::reset() noexcept
+            {
+                if (m_engaged)
+                {
+                    m_value.~T();
+                    m_engaged = false;
+                }
+            }
+        }
+
+
+        // filter_view::iterator
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr filter_view<V, Pred>::iterator::iterator(filter_view& parent, iterator_t<V> current)
+            : m_current(move(current)), m_parent(&parent)
+        {
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr range_reference_t<V> filter_view<V, Pred>::iterator::operator*() const
+        {
+            return *m_current;
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr filter_view<V, Pred>::iterator& filter_view<V, Pred>::iterator::operator++()
+        {
+            const sentinel_t<V> last = ranges::end(m_parent->m_base);
+            const Pred& pred = *m_parent->m_pred;
+
+            do
+                ++m_current;
+            while (m_current != last && !pred(*m_current));
+
+            return *this;
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr void filter_view<V, Pred>::iterator::operator++(int)
+        {
+            ++*this;
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr filter_view<V, Pred>::iterator filter_view<V, Pred>::iterator::operator++(int) requires forward_range<V>
+        {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr filter_view<V, Pred>::iterator& filter_view<V, Pred>::iterator::operator--() requires bidirectional_range<V>
+        {
+            const Pred& pred = *m_parent->m_pred;
+
+            do
+                --m_current;
+            while (!pred(*m_current));
+
+            return *this;
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr filter_view<V, Pred>::iterator filter_view<V, Pred>::iterator::operator--(int) requires bidirectional_range<V>
+        {
+            iterator previous = *this;
+            --*this;
+            return previous;
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr bool filter_view<V, Pred>::iterator::operator==(const iterator& other) const requires equality_comparable<iterator_t<V>>
+        {
+            return m_current == other.m_current;
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr bool filter_view<V, Pred>::iterator::operator==(const sentinel& other) const
+        {
+            return m_current == other.base();
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr const iterator_t<V>& filter_view<V, Pred>::iterator::base() const noexcept
+        {
+            return m_current;
+        }
+
+        // filter_view::sentinel
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr filter_view<V, Pred>::sentinel::sentinel(sentinel_t<V> end) : m_end(move(end))
+        {
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr sentinel_t<V> filter_view<V, Pred>::sentinel::base() const
+        {
+            return m_end;
+        }
+
+        // filter_view
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr filter_view<V, Pred>::filter_view(V base, Pred pred) : m_base(move(base)), m_pred(move(pred)), m_begin()
+        {
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr V filter_view<V, Pred>::base() const& requires copy_constructible<V>
+        {
+            return m_base;
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr const Pred& filter_view<V, Pred>::pred() const
+        {
+            return *m_pred;
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr filter_view<V, Pred>::iterator filter_view<V, Pred>::begin()
+        {
+            if constexpr (forward_range<V>)
+            {
+                if (m_begin.has_value())
+                    return iterator(*this, *m_begin);
+            }
+
+            iterator_t<V> first = ranges::begin(m_base);
+            const sentinel_t<V> last = ranges::end(m_base);
+            const Pred& pred = *m_pred;
+
+            while (first != last && !pred(*first))
+                ++first;
+
+            // An input range cannot be restarted, caching its position would be meaningless.
+            if constexpr (forward_range<V>)
+                m_begin.emplace(first);
+
+            return iterator(*this, move(first));
+        }
+
+        template<class V, class Pred> requires detail::filterable<V, Pred>
+        constexpr auto filter_view<V, Pred>::end()
+        {
+            if constexpr (common_range<V>)
+                return iterator(*this, ranges::end(m_base));
+            else
+                return sentinel(ranges::end(m_base));
+        }
+
+
+        // transform_view::iterator
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator::iterator(transform_view& parent, iterator_t<V> current)
+            : m_current(move(current)), m_parent(&parent)
+        {
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator::reference transform_view<V, F>::iterator::operator*() const
+        {
+            return (*m_parent->m_function)(*m_current);
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator::reference transform_view<V, F>::iterator::operator[](difference_type offset) const
+            requires random_access_range<V>
+        {
+            return (*m_parent->m_function)(m_current[offset]);
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator& transform_view<V, F>::iterator::operator++()
+        {
+            ++m_current;
+            return *this;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr void transform_view<V, F>::iterator::operator++(int)
+        {
+            ++m_current;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator transform_view<V, F>::iterator::operator++(int) requires forward_range<V>
+        {
+            iterator previous = *this;
+            ++m_current;
+            return previous;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator& transform_view<V, F>::iterator::operator--() requires bidirectional_range<V>
+        {
+            --m_current;
+            return *this;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator transform_view<V, F>::iterator::operator--(int) requires bidirectional_range<V>
+        {
+            iterator previous = *this;
+            --m_current;
+            return previous;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator& transform_view<V, F>::iterator::operator+=(difference_type offset)
+            requires random_access_range<V>
+        {
+            m_current += offset;
+            return *this;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator& transform_view<V, F>::iterator::operator-=(difference_type offset)
+            requires random_access_range<V>
+        {
+            m_current -= offset;
+            return *this;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator transform_view<V, F>::iterator::operator+(difference_type offset) const
+            requires random_access_range<V>
+        {
+            iterator result = *this;
+            result.m_current += offset;
+            return result;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator transform_view<V, F>::iterator::operator-(difference_type offset) const
+            requires random_access_range<V>
+        {
+            iterator result = *this;
+            result.m_current -= offset;
+            return result;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator::difference_type transform_view<V, F>::iterator::operator-(const iterator& other) const
+            requires random_access_range<V>
+        {
+            return m_current - other.m_current;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr bool transform_view<V, F>::iterator::operator==(const iterator& other) const requires equality_comparable<iterator_t<V>>
+        {
+            return m_current == other.m_current;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr bool transform_view<V, F>::iterator::operator==(const sentinel& other) const
+        {
+            return m_current == other.base();
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr bool transform_view<V, F>::iterator::operator<(const iterator& other) const requires random_access_range<V>
+        {
+            return m_current < other.m_current;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr bool transform_view<V, F>::iterator::operator>(const iterator& other) const requires random_access_range<V>
+        {
+            return other.m_current < m_current;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr bool transform_view<V, F>::iterator::operator<=(const iterator& other) const requires random_access_range<V>
+        {
+            return !(other.m_current < m_current);
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr bool transform_view<V, F>::iterator::operator>=(const iterator& other) const requires random_access_range<V>
+        {
+            return !(m_current < other.m_current);
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr const iterator_t<V>& transform_view<V, F>::iterator::base() const noexcept
+        {
+            return m_current;
+        }
+
+        // transform_view::sentinel
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::sentinel::sentinel(sentinel_t<V> end) : m_end(move(end))
+        {
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr sentinel_t<V> transform_view<V, F>::sentinel::base() const
+        {
+            return m_end;
+        }
+
+        // transform_view
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::transform_view(V base, F function) : m_base(move(base)), m_function(move(function))
+        {
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr V transform_view<V, F>::base() const& requires copy_constructible<V>
+        {
+            return m_base;
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr transform_view<V, F>::iterator transform_view<V, F>::begin()
+        {
+            return iterator(*this, ranges::begin(m_base));
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr auto transform_view<V, F>::end()
+        {
+            if constexpr (common_range<V>)
+                return iterator(*this, ranges::end(m_base));
+            else
+                return sentinel(ranges::end(m_base));
+        }
+
+        template<class V, class F> requires detail::transformable<V, F>
+        constexpr size_t transform_view<V, F>::size() requires sized_range<V>
+        {
+            return ranges::size(m_base);
+        }
+
+
+        // take_view::iterator
+        template<view V>
+        constexpr take_view<V>::iterator::iterator(iterator_t<V> current, difference_type remaining)
+            : m_current(move(current)), m_remaining(remaining)
+        {
+        }
+
+        template<view V>
+        constexpr range_reference_t<V> take_view<V>::iterator::operator*() const
+        {
+            return *m_current;
+        }
+
+        template<view V>
+        constexpr take_view<V>::iterator& take_view<V>::iterator::operator++()
+        {
+            ++m_current;
+            --m_remaining;
+            return *this;
+        }
+
+        template<view V>
+        constexpr void take_view<V>::iterator::operator++(int)
+        {
+            ++*this;
+        }
+
+        template<view V>
+        constexpr take_view<V>::iterator take_view<V>::iterator::operator++(int) requires forward_range<V>
+        {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        template<view V>
+        constexpr bool take_view<V>::iterator::operator==(const iterator& other) const
+        {
+            return m_remaining == other.m_remaining;
+        }
+
+        template<view V>
+        constexpr bool take_view<V>::iterator::operator==(const sentinel& other) const
+        {
+            return m_remaining == 0 || m_current == other.base();
+        }
+
+        template<view V>
+        constexpr const iterator_t<V>& take_view<V>::iterator::base() const noexcept
+        {
+            return m_current;
+        }
+
+        // take_view::sentinel
+        template<view V>
+        constexpr take_view<V>::sentinel::sentinel(sentinel_t<V> end) : m_end(move(end))
+        {
+        }
+
+        template<view V>
+        constexpr sentinel_t<V> take_view<V>::sentinel::base() const
+        {
+            return m_end;
+        }
+
+        // take_view
+        template<view V>
+        constexpr take_view<V>::take_view(V base, range_difference_t<V> count) : m_base(move(base)), m_count(count)
+        {
+        }
+
+        template<view V>
+        constexpr V take_view<V>::base() const& requires copy_constructible<V>
+        {
+            return m_base;
+        }
+
+        template<view V>
+        constexpr auto take_view<V>::begin()
+        {
+            if constexpr (direct)
+                return ranges::begin(m_base);
+            else
+                return iterator(ranges::begin(m_base), m_count);
+        }
+
+        template<view V>
+        constexpr auto take_view<V>::end()
+        {
+            if constexpr (direct)
+                return ranges::begin(m_base) + static_cast<range_difference_t<V>>(size());
+            else
+                return sentinel(ranges::end(m_base));
+        }
+
+        template<view V>
+        constexpr size_t take_view<V>::size() requires sized_range<V>
+        {
+            const size_t available = ranges::size(m_base);
+            return available < static_cast<size_t>(m_count) ? available : static_cast<size_t>(m_count);
+        }
+
+
+        // drop_view
+        template<view V>
+        constexpr drop_view<V>::drop_view(V base, range_difference_t<V> count) : m_base(move(base)), m_count(count)
+        {
+        }
+
+        template<view V>
+        constexpr V drop_view<V>::base() const& requires copy_constructible<V>
+        {
+            return m_base;
+        }
+
+        template<view V>
+        constexpr iterator_t<V> drop_view<V>::begin()
+        {
+            iterator_t<V> first = ranges::begin(m_base);
+            const sentinel_t<V> last = ranges::end(m_base);
+
+            if constexpr (sized_sentinel_for<sentinel_t<V>, iterator_t<V>> && random_access_range<V>)
+            {
+                const range_difference_t<V> available = last - first;
+                return first + (available < m_count ? available : m_count);
+            }
+            else
+            {
+                for (range_difference_t<V> skipped = 0; skipped < m_count && first != last; ++skipped)
+                    ++first;
+
+                return first;
+            }
+        }
+
+        template<view V>
+        constexpr sentinel_t<V> drop_view<V>::end()
+        {
+            return ranges::end(m_base);
+        }
+
+        template<view V>
+        constexpr size_t drop_view<V>::size() requires sized_range<V>
+        {
+            const size_t available = ranges::size(m_base);
+            return available < static_cast<size_t>(m_count) ? 0 : available - static_cast<size_t>(m_count);
+        }
+
+
+        // split_view::iterator
+        template<class V> requires detail::splittable<V>
+        constexpr split_view<V>::iterator::iterator(split_view& parent, iterator_t<V> current, iterator_t<V> delimiter)
+            : m_parent(&parent), m_current(move(current)), m_delimiter(move(delimiter))
+        {
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr split_view<V>::iterator::value_type split_view<V>::iterator::operator*() const
+        {
+            return value_type(m_current, m_delimiter);
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr split_view<V>::iterator& split_view<V>::iterator::operator++()
+        {
+            const sentinel_t<V> last = ranges::end(m_parent->m_base);
+
+            if (m_delimiter == last)
+            {
+                // The last subrange was just consumed, this is now the end iterator.
+                m_current = m_delimiter;
+                m_trailing_empty = false;
+                return *this;
+            }
+
+            m_current = m_delimiter;
+            ++m_current;
+
+            if (m_current == last)
+            {
+                // The base ended on a delimiter: one empty subrange is still to come.
+                m_delimiter = m_current;
+                m_trailing_empty = true;
+            }
+            else
+            {
+                m_delimiter = m_parent->find_delimiter(m_current);
+            }
+
+            return *this;
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr split_view<V>::iterator split_view<V>::iterator::operator++(int)
+        {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr bool split_view<V>::iterator::operator==(const iterator& other) const
+        {
+            return m_current == other.m_current && m_trailing_empty == other.m_trailing_empty;
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr bool split_view<V>::iterator::operator==(const sentinel& other) const
+        {
+            return m_current == other.base() && m_delimiter == other.base() && !m_trailing_empty;
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr const iterator_t<V>& split_view<V>::iterator::base() const noexcept
+        {
+            return m_current;
+        }
+
+        // split_view::sentinel
+        template<class V> requires detail::splittable<V>
+        constexpr split_view<V>::sentinel::sentinel(sentinel_t<V> end) : m_end(move(end))
+        {
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr sentinel_t<V> split_view<V>::sentinel::base() const
+        {
+            return m_end;
+        }
+
+        // split_view
+        template<class V> requires detail::splittable<V>
+        constexpr split_view<V>::split_view(V base, range_value_t<V> delimiter) : m_base(move(base)), m_delimiter(move(delimiter))
+        {
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr V split_view<V>::base() const& requires copy_constructible<V>
+        {
+            return m_base;
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr split_view<V>::iterator split_view<V>::begin()
+        {
+            iterator_t<V> first = ranges::begin(m_base);
+
+            // An empty base has no subrange at all, not a single empty one.
+            if (first == ranges::end(m_base))
+                return iterator(*this, first, first);
+
+            iterator_t<V> delimiter = find_delimiter(first);
+            return iterator(*this, move(first), move(delimiter));
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr split_view<V>::sentinel split_view<V>::end()
+        {
+            return sentinel(ranges::end(m_base));
+        }
+
+        template<class V> requires detail::splittable<V>
+        constexpr iterator_t<V> split_view<V>::find_delimiter(iterator_t<V> from)
+        {
+            const sentinel_t<V> last = ranges::end(m_base);
+
+            while (from != last && !(*from == m_delimiter))
+                ++from;
+
+            return from;
+        }
+
+
+        // join_view::iterator
+        template<class V> requires detail::joinable<V>
+        constexpr join_view<V>::iterator::iterator(join_view& parent, iterator_t<V> outer)
+            : m_parent(&parent), m_outer(move(outer))
+        {
+            satisfy();
+        }
+
+        template<class V> requires detail::joinable<V>
+        constexpr range_reference_t<typename join_view<V>::inner_range> join_view<V>::iterator::operator*() const
+        {
+            return *m_inner;
+        }
+
+        template<class V> requires detail::joinable<V>
+        constexpr join_view<V>::iterator& join_view<V>::iterator::operator++()
+        {
+            ++m_inner;
+
+            bool exhausted;
+            if constexpr (inner_by_reference)
+                exhausted = m_inner == ranges::end(*m_outer);
+            else
+                exhausted = m_inner == ranges::end(*m_parent->m_inner);
+
+            if (exhausted)
+            {
+                ++m_outer;
+                satisfy();
+            }
+
+            return *this;
+        }
+
+        template<class V> requires detail::joinable<V>
+        constexpr void join_view<V>::iterator::operator++(int)
+        {
+            ++*this;
+        }
+
+        template<class V> requires detail::joinable<V>
+        constexpr join_view<V>::iterator join_view<V>::iterator::operator++(int)
+            requires same_as<iterator_concept, forward_iterator_tag>
+        {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        template<class V> requires detail::joinable<V>
+        constexpr bool join_view<V>::iterator::operator==(const iterator& other) const
+            requires same_as<iterator_concept, forward_iterator_tag>
+        {
+            // The inner iterator is meaningless once the outer range is exhausted.
+            if (!(m_outer == other.m_outer))
+                return false;
+
+            return m_outer == ranges::end(m_parent->m_base) || m_inner == other.m_inner;
+        }
+
+        template<class V> requires detail::joinable<V>
+        constexpr bool join_view<V>::iterator::operator==(const sentinel& other) const
+        {
+            return m_outer == other.base();
+        }
+
+        // Skips the empty inner ranges until an element is found or the outer range ends.
+        template<class V> requires detail::joinable<V>
+        constexpr void join_view<V>::iterator::satisfy()
+        {
+            const sentinel_t<V> last = ranges::end(m_parent->m_base);
+
+            for (; m_outer != last; ++m_outer)
+            {
+                if constexpr (inner_by_reference)
+                {
+                    auto&& inner = *m_outer;
+                    m_inner = ranges::begin(inner);
+                    if (m_inner != ranges::end(inner))
+                        return;
+                }
+                else
+                {
+                    inner_storage& inner = m_parent->m_inner.emplace(*m_outer);
+                    m_inner = ranges::begin(inner);
+                    if (m_inner != ranges::end(inner))
+                        return;
+                }
+            }
+        }
+
+        // join_view::sentinel
+        template<class V> requires detail::joinable<V>
+        constexpr join_view<V>::sentinel::sentinel(sentinel_t<V> end) : m_end(move(end))
+        {
+        }
+
+        template<class V> requires detail::joinable<V>
+        constexpr sentinel_t<V> join_view<V>::sentinel::base() const
+        {
+            return m_end;
+        }
+
+        // join_view
+        template<class V> requires detail::joinable<V>
+        constexpr join_view<V>::join_view(V base) : m_base(move(base)), m_inner()
+        {
+        }
+
+        template<class V> requires detail::joinable<V>
+        constexpr V join_view<V>::base() const& requires copy_constructible<V>
+        {
+            return m_base;
+        }
+
+        template<class V> requires detail::joinable<V>
+        constexpr join_view<V>::iterator join_view<V>::begin()
+        {
+            return iterator(*this, ranges::begin(m_base));
+        }
+
+        template<class V> requires detail::joinable<V>
+        constexpr join_view<V>::sentinel join_view<V>::end()
+        {
+            return sentinel(ranges::end(m_base));
+        }
+
+
+        // enumerate_view::iterator
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::iterator::iterator(iterator_t<V> current, difference_type index)
+            : m_current(move(current)), m_index(index)
+        {
+        }
+
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::iterator::reference enumerate_view<V>::iterator::operator*() const
+        {
+            return reference{ m_index, *m_current };
+        }
+
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::iterator& enumerate_view<V>::iterator::operator++()
+        {
+            ++m_current;
+            ++m_index;
+            return *this;
+        }
+
+        template<view V> requires input_range<V>
+        constexpr void enumerate_view<V>::iterator::operator++(int)
+        {
+            ++*this;
+        }
+
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::iterator enumerate_view<V>::iterator::operator++(int) requires forward_range<V>
+        {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::iterator& enumerate_view<V>::iterator::operator--() requires bidirectional_range<V>
+        {
+            --m_current;
+            --m_index;
+            return *this;
+        }
+
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::iterator enumerate_view<V>::iterator::operator--(int) requires bidirectional_range<V>
+        {
+            iterator previous = *this;
+            --*this;
+            return previous;
+        }
+
+        template<view V> requires input_range<V>
+        constexpr bool enumerate_view<V>::iterator::operator==(const iterator& other) const
+        {
+            return m_index == other.m_index;
+        }
+
+        template<view V> requires input_range<V>
+        constexpr bool enumerate_view<V>::iterator::operator==(const sentinel& other) const
+        {
+            return m_current == other.base();
+        }
+
+        template<view V> requires input_range<V>
+        constexpr const iterator_t<V>& enumerate_view<V>::iterator::base() const noexcept
+        {
+            return m_current;
+        }
+
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::iterator::difference_type enumerate_view<V>::iterator::index() const noexcept
+        {
+            return m_index;
+        }
+
+        // enumerate_view::sentinel
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::sentinel::sentinel(sentinel_t<V> end) : m_end(move(end))
+        {
+        }
+
+        template<view V> requires input_range<V>
+        constexpr sentinel_t<V> enumerate_view<V>::sentinel::base() const
+        {
+            return m_end;
+        }
+
+        // enumerate_view
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::enumerate_view(V base) : m_base(move(base))
+        {
+        }
+
+        template<view V> requires input_range<V>
+        constexpr V enumerate_view<V>::base() const& requires copy_constructible<V>
+        {
+            return m_base;
+        }
+
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::iterator enumerate_view<V>::begin()
+        {
+            return iterator(ranges::begin(m_base), 0);
+        }
+
+        template<view V> requires input_range<V>
+        constexpr enumerate_view<V>::sentinel enumerate_view<V>::end()
+        {
+            return sentinel(ranges::end(m_base));
+        }
+
+        template<view V> requires input_range<V>
+        constexpr size_t enumerate_view<V>::size() requires sized_range<V>
+        {
+            return ranges::size(m_base);
+        }
+
+
+        // Range adaptors
+        namespace detail
+        {
+            template<class Adaptor, class Argument>
+            template<viewable_range R>
+            constexpr auto bound_adaptor<Adaptor, Argument>::operator()(R&& range) const
+            {
+                return Adaptor{}(forward<R>(range), argument);
+            }
+
+            template<class First, class Second>
+            template<viewable_range R>
+            constexpr auto composed_adaptor<First, Second>::operator()(R&& range) const
+            {
+                return second(first(forward<R>(range)));
+            }
+
+            template<viewable_range R, adaptor_closure Closure> requires invocable<const remove_cvref_t<Closure>&, R>
+            constexpr auto operator|(R&& range, Closure&& closure)
+            {
+                return static_cast<const remove_cvref_t<Closure>&>(closure)(forward<R>(range));
+            }
+
+            template<adaptor_closure First, adaptor_closure Second>
+            constexpr auto operator|(First&& first, Second&& second)
+            {
+                return composed_adaptor<remove_cvref_t<First>, remove_cvref_t<Second>>{ {}, forward<First>(first), forward<Second>(second) };
+            }
+
+            template<viewable_range R>
+            constexpr auto all_fn::operator()(R&& range) const
+            {
+                if constexpr (view<remove_cvref_t<R>>)
+                    return remove_cvref_t<R>(forward<R>(range));
+                else if constexpr (is_lvalue_reference_v<R>)
+                    return ref_view<remove_reference_t<R>>(range);
+                else
+                    return owning_view<remove_reference_t<R>>(move(range));
+            }
+
+            template<viewable_range R, class Pred>
+            constexpr auto filter_fn::operator()(R&& range, Pred&& pred) const
+            {
+                return filter_view<views::all_t<R>, decay_t<Pred>>(views::all(forward<R>(range)), forward<Pred>(pred));
+            }
+
+            template<class Pred>
+            constexpr auto filter_fn::operator()(Pred&& pred) const
+            {
+                return bound_adaptor<filter_fn, decay_t<Pred>>{ {}, forward<Pred>(pred) };
+            }
+
+            template<viewable_range R, class F>
+            constexpr auto transform_fn::operator()(R&& range, F&& function) const
+            {
+                return transform_view<views::all_t<R>, decay_t<F>>(views::all(forward<R>(range)), forward<F>(function));
+            }
+
+            template<class F>
+            constexpr auto transform_fn::operator()(F&& function) const
+            {
+                return bound_adaptor<transform_fn, decay_t<F>>{ {}, forward<F>(function) };
+            }
+
+            template<viewable_range R>
+            constexpr auto take_fn::operator()(R&& range, ptrdiff_t count) const
+            {
+                return take_view<views::all_t<R>>(views::all(forward<R>(range)), count);
+            }
+
+            constexpr auto take_fn::operator()(ptrdiff_t count) const
+            {
+                return bound_adaptor<take_fn, ptrdiff_t>{ {}, count };
+            }
+
+            template<viewable_range R>
+            constexpr auto drop_fn::operator()(R&& range, ptrdiff_t count) const
+            {
+                return drop_view<views::all_t<R>>(views::all(forward<R>(range)), count);
+            }
+
+            constexpr auto drop_fn::operator()(ptrdiff_t count) const
+            {
+                return bound_adaptor<drop_fn, ptrdiff_t>{ {}, count };
+            }
+
+            template<viewable_range R>
+            constexpr auto split_fn::operator()(R&& range, range_value_t<R> delimiter) const
+            {
+                return split_view<views::all_t<R>>(views::all(forward<R>(range)), move(delimiter));
+            }
+
+            template<class T>
+            constexpr auto split_fn::operator()(T&& delimiter) const
+            {
+                return bound_adaptor<split_fn, decay_t<T>>{ {}, forward<T>(delimiter) };
+            }
+
+            template<viewable_range R>
+            constexpr auto join_fn::operator()(R&& range) const
+            {
+                return join_view<views::all_t<R>>(views::all(forward<R>(range)));
+            }
+
+            template<viewable_range R>
+            constexpr auto enumerate_fn::operator()(R&& range) const
+            {
+                return enumerate_view<views::all_t<R>>(views::all(forward<R>(range)));
+            }
+        }
+    }
+}
+
+
+#endif //STL_RANGES_HPP
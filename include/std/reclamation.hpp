@@ -0,0 +1,268 @@
+#ifndef STL_RECLAMATION_HPP
+#define STL_RECLAMATION_HPP
+
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "memory.hpp"
+#include "utility.hpp"
+
+// Deferred freeing of the nodes of lock-free structures: a node unlinked by one thread is only
+// freed once no other thread can still be reading it.
+//
+// Two schemes, chosen per node type by the base class it derives from:
+//  - Epoch based (epoch_obj_base, epoch_guard): readers only announce that they are reading,
+//    which makes reads nearly free, but one stalled reader holds back every retired node.
+//  - Hazard pointers (hazard_pointer_obj_base, hazard_pointer): readers publish each node they
+//    are about to dereference, so at most a bounded number of retired nodes per thread and per
+//    hazard pointer stay unreclaimed, whatever the readers do.
+// Retired nodes are freed by their deleter, as unique_ptr<T, D> frees its pointer. Both schemes
+// keep a record per thread, for the first reclaim_max_threads threads using them; the threads
+// beyond share one more record behind a lock.
+
+namespace std
+{
+    namespace detail
+    {
+        inline constexpr uint32_t reclaim_max_threads = 64;
+        inline constexpr size_t reclaim_cache_line = 64;
+
+        struct retired_node
+        {
+            retired_node* next;
+            const void* object;     // the address hazard pointers protect
+            void (*reclaim)(retired_node* node) noexcept;
+        };
+
+        void epoch_retire(retired_node* node) noexcept;
+        void hazard_retire(retired_node* node) noexcept;
+    }
+
+
+    /// Epoch based reclamation
+    // Base of the nodes retired through epochs: struct node : epoch_obj_base<node> { ... };
+    template<class T, class D = default_delete<T>>
+    class epoch_obj_base : private detail::retired_node
+    {
+    public:
+        /// Member functions
+        // Frees the object with deleter once every epoch_guard alive at this point is gone. The
+        // object must already be unreachable for new readers.
+        void retire(D deleter = D()) noexcept;
+    protected:
+        /// Constructors
+        epoch_obj_base() noexcept = default;
+        epoch_obj_base(const epoch_obj_base&) noexcept;
+
+        /// Destructor
+        ~epoch_obj_base() = default;
+
+        /// Operators
+        epoch_obj_base& operator=(const epoch_obj_base&) noexcept;
+    private:
+        static void reclaim_object(detail::retired_node* node) noexcept;
+
+        [[no_unique_address]] D m_deleter;
+    };
+
+    // Read-side critical section: the nodes reachable while it is alive stay allocated until it
+    // ends. Guards nest. Readers need no other synchronization.
+    class epoch_guard
+    {
+    public:
+        /// Constructors
+        epoch_guard() noexcept;
+        epoch_guard(const epoch_guard&) = delete;
+
+        /// Destructor
+        ~epoch_guard();
+
+        /// Operators
+        epoch_guard& operator=(const epoch_guard&) = delete;
+    private:
+        uint64_t* m_state;
+    };
+
+    // Waits until every guard alive on entry has ended, then frees everything the calling
+    // thread retired. Must not be called while the calling thread holds a guard.
+    void epoch_synchronize() noexcept;
+
+
+    /// Hazard pointers
+    // Base of the nodes retired through hazard pointers: struct node : hazard_pointer_obj_base<node> { ... };
+    template<class T, class D = default_delete<T>>
+    class hazard_pointer_obj_base : private detail::retired_node
+    {
+    public:
+        /// Member functions
+        // Frees the object with deleter once no hazard pointer protects it. The object must
+        // already be unreachable for new readers.
+        void retire(D deleter = D()) noexcept;
+    protected:
+        /// Constructors
+        hazard_pointer_obj_base() noexcept = default;
+        hazard_pointer_obj_base(const hazard_pointer_obj_base&) noexcept;
+
+        /// Destructor
+        ~hazard_pointer_obj_base() = default;
+
+        /// Operators
+        hazard_pointer_obj_base& operator=(const hazard_pointer_obj_base&) noexcept;
+    private:
+        static void reclaim_object(detail::retired_node* node) noexcept;
+
+        [[no_unique_address]] D m_deleter;
+    };
+
+    // One published pointer. Only a T* that was retired as T is protected (compare addresses,
+    // not types: protect the pointer type the structure stores).
+    class hazard_pointer
+    {
+    public:
+        /// Constructors
+        hazard_pointer() noexcept;
+        hazard_pointer(const hazard_pointer&) = delete;
+        hazard_pointer(hazard_pointer&& other) noexcept;
+
+        /// Destructor
+        ~hazard_pointer();
+
+        /// Operators
+        hazard_pointer& operator=(const hazard_pointer&) = delete;
+        hazard_pointer& operator=(hazard_pointer&& other) noexcept;
+
+        /// Member functions
+        // A default constructed hazard pointer, or one moved from, owns no slot.
+        bool empty() const noexcept;
+
+        // Loads src until the value loaded is protected, and returns it. src is only ever
+        // accessed atomically.
+        template<class T>
+        T* protect(T* const& src) noexcept;
+        // Protects ptr if src still holds it; otherwise stores src's new value in ptr and
+        // returns false.
+        template<class T>
+        bool try_protect(T*& ptr, T* const& src) noexcept;
+
+        template<class T>
+        void reset_protection(const T* ptr) noexcept;
+        void reset_protection(nullptr_t = nullptr) noexcept;
+    private:
+        friend hazard_pointer make_hazard_pointer() noexcept;
+
+        explicit hazard_pointer(const void** slot) noexcept;
+
+        const void** m_slot;
+    };
+
+    // A hazard pointer owning one of the process' slots, empty when they are all taken.
+    hazard_pointer make_hazard_pointer() noexcept;
+
+    // Frees every node the calling thread retired that no hazard pointer protects.
+    void hazard_pointer_clean_up() noexcept;
+
+
+    // epoch_obj_base
+    // Constructors implementations
+    template<class T, class D>
+    epoch_obj_base<T, D>::epoch_obj_base(const epoch_obj_base&) noexcept : detail::retired_node(), m_deleter()
+    {
+    }
+
+    // Operators
+    template<class T, class D>
+    epoch_obj_base<T, D>& epoch_obj_base<T, D>::operator=(const epoch_obj_base&) noexcept
+    {
+        return *this;
+    }
+
+    // Member functions
+    template<class T, class D>
+    void epoch_obj_base<T, D>::retire(D deleter) noexcept
+    {
+        m_deleter = move(deleter);
+        this->object = static_cast<T*>(this);
+        this->reclaim = &epoch_obj_base::reclaim_object;
+        detail::epoch_retire(this);
+    }
+
+    template<class T, class D>
+    void epoch_obj_base<T, D>::reclaim_object(detail::retired_node* node) noexcept
+    {
+        epoch_obj_base* const base = static_cast<epoch_obj_base*>(node);
+        D deleter = move(base->m_deleter);
+        deleter(static_cast<T*>(base));
+    }
+
+
+    // hazard_pointer_obj_base
+    // Constructors implementations
+    template<class T, class D>
+    hazard_pointer_obj_base<T, D>::hazard_pointer_obj_base(const hazard_pointer_obj_base&) noexcept : detail::retired_node(), m_deleter()
+    {
+    }
+
+    // Operators
+    template<class T, class D>
+    hazard_pointer_obj_base<T, D>& hazard_pointer_obj_base<T, D>::operator=(const hazard_pointer_obj_base&) noexcept
+    {
+        return *this;
+    }
+
+    // Member functions
+    template<class T, class D>
+    void hazard_pointer_obj_base<T, D>::retire(D deleter) noexcept
+    {
+        m_deleter = move(deleter);
+        this->object = static_cast<T*>(this);
+        this->reclaim = &hazard_pointer_obj_base::reclaim_object;
+        detail::hazard_retire(this);
+    }
+
+    template<class T, class D>
+    void hazard_pointer_obj_base<T, D>::reclaim_object(detail::retired_node* node) noexcept
+    {
+        hazard_pointer_obj_base* const base = static_cast<hazard_pointer_obj_base*>(node);
+        D deleter = move(base->m_deleter);
+        deleter(static_cast<T*>(base));
+    }
+
+
+    // hazard_pointer
+    // Member functions
+    template<class T>
+    T* hazard_pointer::protect(T* const& src) noexcept
+    {
+        T* pointer = __atomic_load_n(&src, __ATOMIC_RELAXED);
+        while (!try_protect(pointer, src))
+        {
+        }
+        return pointer;
+    }
+
+    template<class T>
+    bool hazard_pointer::try_protect(T*& ptr, T* const& src) noexcept
+    {
+        T* const expected = ptr;
+        // Publish, then check that src was not changed (and the node possibly retired and
+        // scanned) in between. The store must be visible before the load: sequentially
+        // consistent, paired with the fence in the scan.
+        __atomic_store_n(m_slot, static_cast<const void*>(expected), __ATOMIC_SEQ_CST);
+
+        ptr = __atomic_load_n(&src, __ATOMIC_ACQUIRE);
+        if (ptr == expected)
+            return true;
+
+        reset_protection();
+        return false;
+    }
+
+    template<class T>
+    void hazard_pointer::reset_protection(const T* ptr) noexcept
+    {
+        __atomic_store_n(m_slot, static_cast<const void*>(ptr), __ATOMIC_RELEASE);
+    }
+}
+
+
+#endif //STL_RECLAMATION_HPP
@@ -0,0 +1,957 @@
+#ifndef STL_REGEX_HPP
+#define STL_REGEX_HPP
+
+
+#include "concepts.hpp"
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "ranges.hpp"
+#include "string_view.hpp"
+#include "type_traits.hpp"
+
+namespace std
+{
+    // Pattern text passed as a template argument: static_regex<"[a-z_][a-z0-9_]*">.
+    template<size_t N>
+    struct regex_pattern
+    {
+        /// Constructors
+        consteval regex_pattern(const char (&str)[N]) noexcept;
+
+        /// Member functions
+        constexpr string_view view() const noexcept;
+
+        char text[N];
+    };
+
+    struct regex_result
+    {
+        size_t position;    // string_view::npos when nothing matched
+        size_t length;
+    };
+
+    namespace detail
+    {
+        struct regex_dfa_size
+        {
+            size_t states;
+            size_t classes;
+        };
+
+        // Tables of a minimized DFA over byte classes. State 0 is the dead state, which no
+        // transition leaves.
+        template<size_t States, size_t Classes>
+        struct regex_dfa
+        {
+            using state_type = conditional_t<(States <= 256), uint8_t, uint16_t>;
+
+            uint8_t classes[256];
+            state_type transitions[States * Classes];
+            bool accepting[States];
+            state_type start;
+        };
+
+        // Called on invalid patterns; not constexpr, so reaching one of them during constant
+        // evaluation is the compile error.
+        void regex_unbalanced_parenthesis() noexcept;
+        void regex_invalid_escape() noexcept;
+        void regex_invalid_class() noexcept;
+        void regex_invalid_quantifier() noexcept;
+        void regex_unsupported_syntax() noexcept;
+        void regex_too_many_states() noexcept;
+
+        consteval regex_dfa_size regex_measure(string_view pattern);
+
+        template<size_t States, size_t Classes>
+        consteval regex_dfa<States, Classes> regex_compile(string_view pattern);
+
+        template<class R>
+        concept regex_char_range = ranges::contiguous_range<R> && ranges::sized_range<R> && !is_array_v<remove_reference_t<R>>
+                                   && same_as<remove_cv_t<ranges::range_value_t<R>>, char>;
+
+        template<regex_char_range R>
+        constexpr string_view regex_view(R& range) noexcept;
+    }
+
+    // Regular expression compiled during constant evaluation: the pattern is parsed into an NFA,
+    // turned into a DFA by subset construction and minimized, and only the DFA's tables reach
+    // the program. Matching is one table lookup per byte, with no allocation, and is constexpr
+    // itself. An invalid pattern fails to compile.
+    //
+    // Patterns work on bytes (UTF-8 sequences are matched as such):
+    //  - literals, '.' (anything but '\n'), classes "[a-z_]" and "[^...]";
+    //  - escapes \d \w \s \D \W \S, \n \r \t \f \v \0, \xHH, and any escaped punctuation;
+    //  - groups "(...)" and "(?:...)" (neither captures), alternation '|';
+    //  - quantifiers * + ? {m} {m,} {m,n}.
+    // Anchors, back references and lazy quantifiers are rejected: match is anchored at both
+    // ends, match_prefix at the start.
+    template<regex_pattern Pattern>
+    class static_regex
+    {
+    public:
+        static constexpr detail::regex_dfa_size size = detail::regex_measure(Pattern.view());
+        static constexpr detail::regex_dfa<size.states, size.classes> dfa = detail::regex_compile<size.states, size.classes>(Pattern.view());
+
+        /// Member functions
+        // Whether the whole text matches.
+        static constexpr bool match(string_view text) noexcept;
+        // Length of the longest matching prefix of text, string_view::npos when there is none
+        // (an empty match is a match of length 0). This is the tokenizer's primitive.
+        static constexpr size_t match_prefix(string_view text) noexcept;
+        // Leftmost match, the longest one from there. Tries every start position in turn.
+        static constexpr regex_result search(string_view text) noexcept;
+
+        template<detail::regex_char_range R>
+        static constexpr bool match(R&& text) noexcept;
+        template<detail::regex_char_range R>
+        static constexpr size_t match_prefix(R&& text) noexcept;
+        template<detail::regex_char_range R>
+        static constexpr regex_result search(R&& text) noexcept;
+    };
+
+
+    // regex_pattern
+    // Constructors implementations
+    template<size_t N>
+    consteval regex_pattern<N>::regex_pattern(const char (&str)[N]) noexcept : text{}
+    {
+        for (size_t i = 0; i < N; ++i)
+            text[i] = str[i];
+    }
+
+    // Member functions
+    template<size_t N>
+    constexpr string_view regex_pattern<N>::view() const noexcept
+    {
+        return string_view(text, N - 1);
+    }
+
+
+    namespace detail
+    {
+        inline constexpr size_t regex_none = static_cast<size_t>(-1);
+        inline constexpr size_t regex_max_repetition = 1000;
+        inline constexpr size_t regex_max_states = 65536;
+
+        // Growable array for the compiler, which only runs in constant evaluation: the memory
+        // never outlives it.
+        template<class T>
+        class regex_buffer
+        {
+        public:
+            /// Constructors
+            constexpr regex_buffer() noexcept = default;
+            regex_buffer(const regex_buffer&) = delete;
+
+            /// Destructor
+            constexpr ~regex_buffer()
+            {
+                delete[] m_data;
+            }
+
+            /// Operators
+            regex_buffer& operator=(const regex_buffer&) = delete;
+
+            constexpr T& operator[](size_t index)
+            {
+                return m_data[index];
+            }
+
+            constexpr const T& operator[](size_t index) const
+            {
+                return m_data[index];
+            }
+
+            /// Member functions
+            constexpr size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            constexpr void push_back(const T& value)
+            {
+                if (m_size == m_capacity)
+                    reserve(m_capacity ? m_capacity * 2 : 16);
+                m_data[m_size++] = value;
+            }
+
+            constexpr void resize(size_t count, const T& value)
+            {
+                reserve(count);
+                for (size_t i = m_size; i < count; ++i)
+                    m_data[i] = value;
+                m_size = count;
+            }
+
+            constexpr void clear() noexcept
+            {
+                m_size = 0;
+            }
+        private:
+            constexpr void reserve(size_t capacity)
+            {
+                if (capacity <= m_capacity)
+                    return;
+
+                T* data = new T[capacity];
+                for (size_t i = 0; i < m_size; ++i)
+                    data[i] = m_data[i];
+                delete[] m_data;
+                m_data = data;
+                m_capacity = capacity;
+            }
+
+            T* m_data = nullptr;
+            size_t m_size = 0;
+            size_t m_capacity = 0;
+        };
+
+        struct regex_byte_set
+        {
+            uint64_t words[4] = {};
+
+            constexpr void add(uint8_t byte) noexcept
+            {
+                words[byte / 64] |= uint64_t(1) << (byte % 64);
+            }
+
+            constexpr void add_range(uint8_t first, uint8_t last) noexcept
+            {
+                for (uint32_t byte = first; byte <= last; ++byte)
+                    add(static_cast<uint8_t>(byte));
+            }
+
+            constexpr void add_set(const regex_byte_set& other) noexcept
+            {
+                for (size_t i = 0; i < 4; ++i)
+                    words[i] |= other.words[i];
+            }
+
+            constexpr void invert() noexcept
+            {
+                for (uint64_t& word : words)
+                    word = ~word;
+            }
+
+            constexpr bool contains(uint8_t byte) const noexcept
+            {
+                return (words[byte / 64] >> (byte % 64)) & 1;
+            }
+        };
+
+        // Thompson construction: a consuming state has one transition on its byte set, an
+        // epsilon state up to two empty ones. A fragment's end state has no transition yet.
+        struct regex_nfa_state
+        {
+            regex_byte_set bytes;
+            size_t out = regex_none;
+            size_t out2 = regex_none;
+            bool consumes = false;
+        };
+
+        struct regex_fragment
+        {
+            size_t start;
+            size_t end;
+        };
+
+        class regex_parser
+        {
+        public:
+            /// Constructors
+            constexpr regex_parser(string_view pattern) noexcept : m_pattern(pattern)
+            {
+            }
+
+            /// Member functions
+            // The whole pattern, whose end state is the accepting one.
+            constexpr regex_fragment parse()
+            {
+                size_t position = 0;
+                const regex_fragment fragment = parse_alternation(position);
+                if (position != m_pattern.size())
+                    regex_unbalanced_parenthesis();
+                return fragment;
+            }
+
+            constexpr regex_buffer<regex_nfa_state>& states() noexcept
+            {
+                return m_states;
+            }
+        private:
+            constexpr size_t add_state()
+            {
+                m_states.push_back(regex_nfa_state());
+                return m_states.size() - 1;
+            }
+
+            constexpr regex_fragment empty()
+            {
+                const size_t state = add_state();
+                return { state, state };
+            }
+
+            constexpr regex_fragment bytes(const regex_byte_set& set)
+            {
+                const size_t start = add_state();
+                const size_t end = add_state();
+                m_states[start].bytes = set;
+                m_states[start].consumes = true;
+                m_states[start].out = end;
+                return { start, end };
+            }
+
+            constexpr regex_fragment concatenate(regex_fragment first, regex_fragment second)
+            {
+                m_states[first.end].out = second.start;
+                return { first.start, second.end };
+            }
+
+            constexpr regex_fragment alternate(regex_fragment first, regex_fragment second)
+            {
+                const size_t start = add_state();
+                const size_t end = add_state();
+                m_states[start].out = first.start;
+                m_states[start].out2 = second.start;
+                m_states[first.end].out = end;
+                m_states[second.end].out = end;
+                return { start, end };
+            }
+
+            constexpr regex_fragment optional(regex_fragment fragment)
+            {
+                const size_t start = add_state();
+                const size_t end = add_state();
+                m_states[start].out = fragment.start;
+                m_states[start].out2 = end;
+                m_states[fragment.end].out = end;
+                return { start, end };
+            }
+
+            constexpr regex_fragment star(regex_fragment fragment)
+            {
+                const size_t start = add_state();
+                const size_t end = add_state();
+                m_states[start].out = fragment.start;
+                m_states[start].out2 = end;
+                m_states[fragment.end].out = fragment.start;
+                m_states[fragment.end].out2 = end;
+                return { start, end };
+            }
+
+            constexpr regex_fragment plus(regex_fragment fragment)
+            {
+                const size_t end = add_state();
+                m_states[fragment.end].out = fragment.start;
+                m_states[fragment.end].out2 = end;
+                return { fragment.start, end };
+            }
+
+            constexpr bool at_end(size_t position) const noexcept
+            {
+                return position >= m_pattern.size();
+            }
+
+            constexpr regex_fragment parse_alternation(size_t& position)
+            {
+                regex_fragment fragment = parse_concatenation(position);
+                while (!at_end(position) && m_pattern[position] == '|')
+                {
+                    ++position;
+                    fragment = alternate(fragment, parse_concatenation(position));
+                }
+                return fragment;
+            }
+
+            constexpr regex_fragment parse_concatenation(size_t& position)
+            {
+                regex_fragment fragment = empty();
+                while (!at_end(position) && m_pattern[position] != '|' && m_pattern[position] != ')')
+                    fragment = concatenate(fragment, parse_repetition(position));
+                return fragment;
+            }
+
+            constexpr size_t parse_count(size_t& position)
+            {
+                if (at_end(position) || m_pattern[position] < '0' || m_pattern[position] > '9')
+                    regex_invalid_quantifier();
+
+                size_t count = 0;
+                while (!at_end(position) && m_pattern[position] >= '0' && m_pattern[position] <= '9')
+                {
+                    count = count * 10 + static_cast<size_t>(m_pattern[position++] - '0');
+                    if (count > regex_max_repetition)
+                        regex_invalid_quantifier();
+                }
+                return count;
+            }
+
+            // An atom and its quantifier. A counted repetition needs copies of the atom, made by
+            // parsing its text again.
+            constexpr regex_fragment parse_repetition(size_t& position)
+            {
+                const size_t atom_position = position;
+                regex_fragment fragment = parse_atom(position);
+                if (at_end(position))
+                    return fragment;
+
+                const char quantifier = m_pattern[position];
+                if (quantifier == '*')
+                    fragment = star(fragment);
+                else if (quantifier == '+')
+                    fragment = plus(fragment);
+                else if (quantifier == '?')
+                    fragment = optional(fragment);
+                else if (quantifier != '{')
+                    return fragment;
+                ++position;
+
+                if (quantifier == '{')
+                {
+                    const size_t minimum = parse_count(position);
+                    size_t maximum = minimum;
+                    if (!at_end(position) && m_pattern[position] == ',')
+                    {
+                        ++position;
+                        maximum = !at_end(position) && m_pattern[position] == '}' ? regex_none : parse_count(position);
+                    }
+                    if (at_end(position) || m_pattern[position] != '}' || maximum < minimum)
+                        regex_invalid_quantifier();
+                    ++position;
+
+                    regex_fragment repeated = empty();
+                    regex_fragment copy = fragment;
+                    for (size_t i = 0; i < minimum; ++i)
+                    {
+                        if (i != 0)
+                            copy = parse_copy(atom_position);
+                        repeated = concatenate(repeated, copy);
+                    }
+
+                    if (maximum == regex_none)
+                    {
+                        repeated = concatenate(repeated, star(minimum == 0 ? fragment : parse_copy(atom_position)));
+                    }
+                    else
+                    {
+                        for (size_t i = minimum; i < maximum; ++i)
+                            repeated = concatenate(repeated, optional(i == 0 ? fragment : parse_copy(atom_position)));
+                    }
+                    fragment = repeated;
+                }
+
+                // Lazy (+?) and possessive (++) forms, or a quantifier stacked on another.
+                if (!at_end(position))
+                {
+                    const char next = m_pattern[position];
+                    if (next == '*' || next == '+' || next == '?' || next == '{')
+                        regex_invalid_quantifier();
+                }
+                return fragment;
+            }
+
+            constexpr regex_fragment parse_copy(size_t atom_position)
+            {
+                return parse_atom(atom_position);
+            }
+
+            constexpr regex_fragment parse_atom(size_t& position)
+            {
+                const char ch = m_pattern[position++];
+                switch (ch)
+                {
+                    case '(':
+                    {
+                        if (!at_end(position) && m_pattern[position] == '?')
+                        {
+                            if (position + 1 >= m_pattern.size() || m_pattern[position + 1] != ':')
+                                regex_unsupported_syntax();
+                            position += 2;
+                        }
+
+                        const regex_fragment fragment = parse_alternation(position);
+                        if (at_end(position) || m_pattern[position] != ')')
+                            regex_unbalanced_parenthesis();
+                        ++position;
+                        return fragment;
+                    }
+                    case '[':
+                        return bytes(parse_class(position));
+                    case '.':
+                    {
+                        regex_byte_set set;
+                        set.add('\n');
+                        set.invert();
+                        return bytes(set);
+                    }
+                    case '\\':
+                        return bytes(parse_escape(position));
+                    case '*':
+                    case '+':
+                    case '?':
+                    case '{':
+                        regex_invalid_quantifier();
+                        return empty();
+                    case '^':
+                    case '$':
+                        regex_unsupported_syntax();
+                        return empty();
+                    default:
+                    {
+                        regex_byte_set set;
+                        set.add(static_cast<uint8_t>(ch));
+                        return bytes(set);
+                    }
+                }
+            }
+
+            static constexpr int hex_digit(char ch) noexcept
+            {
+                if (ch >= '0' && ch <= '9')
+                    return ch - '0';
+                if (ch >= 'a' && ch <= 'f')
+                    return ch - 'a' + 10;
+                if (ch >= 'A' && ch <= 'F')
+                    return ch - 'A' + 10;
+                return -1;
+            }
+
+            // The escape after a backslash, as the set of bytes it stands for.
+            constexpr regex_byte_set parse_escape(size_t& position)
+            {
+                if (at_end(position))
+                    regex_invalid_escape();
+
+                const char ch = m_pattern[position++];
+                regex_byte_set set;
+                switch (ch)
+                {
+                    case 'd': case 'D':
+                        set.add_range('0', '9');
+                        break;
+                    case 'w': case 'W':
+                        set.add_range('a', 'z');
+                        set.add_range('A', 'Z');
+                        set.add_range('0', '9');
+                        set.add('_');
+                        break;
+                    case 's': case 'S':
+                        set.add(' ');
+                        set.add_range('\t', '\r');
+                        break;
+                    case 'n': set.add('\n'); return set;
+                    case 'r': set.add('\r'); return set;
+                    case 't': set.add('\t'); return set;
+                    case 'f': set.add('\f'); return set;
+                    case 'v': set.add('\v'); return set;
+                    case '0': set.add('\0'); return set;
+                    case 'x':
+                    {
+                        const int high = position < m_pattern.size() ? hex_digit(m_pattern[position]) : -1;
+                        const int low = position + 1 < m_pattern.size() ? hex_digit(m_pattern[position + 1]) : -1;
+                        if (high < 0 || low < 0)
+                            regex_invalid_escape();
+                        position += 2;
+                        set.add(static_cast<uint8_t>(high * 16 + low));
+                        return set;
+                    }
+                    default:
+                        // Escaped punctuation stands for itself, escaped letters and digits are
+                        // reserved.
+                        if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9'))
+                            regex_invalid_escape();
+                        set.add(static_cast<uint8_t>(ch));
+                        return set;
+                }
+
+                if (ch >= 'A' && ch <= 'Z')
+                    set.invert();
+                return set;
+            }
+
+            static constexpr bool is_set_escape(char ch) noexcept
+            {
+                return ch == 'd' || ch == 'D' || ch == 'w' || ch == 'W' || ch == 's' || ch == 'S';
+            }
+
+            // An escape standing for a single byte, such as a range bound.
+            constexpr uint8_t parse_byte_escape(size_t& position)
+            {
+                const regex_byte_set escaped = parse_escape(position);
+                uint32_t byte = 0;
+                while (!escaped.contains(static_cast<uint8_t>(byte)))
+                    ++byte;
+                return static_cast<uint8_t>(byte);
+            }
+
+            // A bracket expression, from just after its '['.
+            constexpr regex_byte_set parse_class(size_t& position)
+            {
+                regex_byte_set set;
+                const bool negated = !at_end(position) && m_pattern[position] == '^';
+                if (negated)
+                    ++position;
+
+                bool first = true;
+                while (true)
+                {
+                    if (at_end(position))
+                        regex_invalid_class();
+
+                    char ch = m_pattern[position];
+                    if (ch == ']' && !first)
+                    {
+                        ++position;
+                        break;
+                    }
+                    first = false;
+                    ++position;
+
+                    // A class escape (\d...) cannot start a range.
+                    uint8_t low = static_cast<uint8_t>(ch);
+                    if (ch == '\\')
+                    {
+                        if (!at_end(position) && is_set_escape(m_pattern[position]))
+                        {
+                            set.add_set(parse_escape(position));
+                            continue;
+                        }
+                        low = parse_byte_escape(position);
+                    }
+
+                    if (position + 1 < m_pattern.size() && m_pattern[position] == '-' && m_pattern[position + 1] != ']')
+                    {
+                        ++position;
+                        ch = m_pattern[position++];
+                        uint8_t high = static_cast<uint8_t>(ch);
+                        if (ch == '\\')
+                        {
+                            if (!at_end(position) && is_set_escape(m_pattern[position]))
+                                regex_invalid_class();
+                            high = parse_byte_escape(position);
+                        }
+                        if (high < low)
+                            regex_invalid_class();
+                        set.add_range(low, high);
+                    }
+                    else
+                    {
+                        set.add(low);
+                    }
+                }
+
+                if (negated)
+                    set.invert();
+                return set;
+            }
+
+            string_view m_pattern;
+            regex_buffer<regex_nfa_state> m_states;
+        };
+
+        // Minimized DFA in growable buffers, before it is copied into fixed-size tables.
+        struct regex_automaton
+        {
+            uint8_t classes[256] = {};
+            size_t class_count = 0;
+            size_t state_count = 0;
+            size_t start = 0;
+            regex_buffer<size_t> transitions;
+            regex_buffer<bool> accepting;
+        };
+
+        // Bytes that no consuming state tells apart share a class.
+        constexpr size_t regex_byte_classes(const regex_buffer<regex_nfa_state>& states, uint8_t (&classes)[256])
+        {
+            size_t class_count = 1;
+            for (size_t s = 0; s < states.size(); ++s)
+            {
+                if (!states[s].consumes)
+                    continue;
+
+                // Split every class into its bytes inside and outside the set.
+                size_t split[256 * 2];
+                for (size_t& id : split)
+                    id = regex_none;
+
+                size_t next_count = 0;
+                for (size_t byte = 0; byte < 256; ++byte)
+                {
+                    size_t& id = split[classes[byte] * 2 + states[s].bytes.contains(static_cast<uint8_t>(byte))];
+                    if (id == regex_none)
+                        id = next_count++;
+                    classes[byte] = static_cast<uint8_t>(id);
+                }
+                class_count = next_count;
+            }
+            return class_count;
+        }
+
+        constexpr void regex_closure(const regex_buffer<regex_nfa_state>& states, uint64_t* set, regex_buffer<size_t>& stack)
+        {
+            stack.clear();
+            const size_t words = (states.size() + 63) / 64;
+            for (size_t w = 0; w < words; ++w)
+            {
+                for (size_t bit = 0; bit < 64; ++bit)
+                {
+                    if ((set[w] >> bit) & 1)
+                        stack.push_back(w * 64 + bit);
+                }
+            }
+
+            while (stack.size() != 0)
+            {
+                const size_t state = stack[stack.size() - 1];
+                stack.resize(stack.size() - 1, 0);
+                if (states[state].consumes)
+                    continue;
+
+                const size_t targets[2] = { states[state].out, states[state].out2 };
+                for (const size_t next : targets)
+                {
+                    if (next == regex_none || ((set[next / 64] >> (next % 64)) & 1))
+                        continue;
+                    set[next / 64] |= uint64_t(1) << (next % 64);
+                    stack.push_back(next);
+                }
+            }
+        }
+
+        consteval void regex_build(string_view pattern, regex_automaton& automaton)
+        {
+            regex_parser parser(pattern);
+            const regex_fragment whole = parser.parse();
+            const regex_buffer<regex_nfa_state>& states = parser.states();
+
+            const size_t class_count = regex_byte_classes(states, automaton.classes);
+            uint8_t representative[256] = {};
+            for (size_t byte = 256; byte-- > 0;)
+                representative[automaton.classes[byte]] = static_cast<uint8_t>(byte);
+
+            // Subset construction. DFA state 0 is the empty set, the dead state.
+            const size_t words = (states.size() + 63) / 64;
+            regex_buffer<uint64_t> sets;
+            regex_buffer<size_t> transitions;
+            regex_buffer<bool> accepting;
+            regex_buffer<size_t> stack;
+            regex_buffer<uint64_t> next;
+
+            sets.resize(words * 2, 0);
+            sets[words + whole.start / 64] |= uint64_t(1) << (whole.start % 64);
+            {
+                next.resize(words, 0);
+                for (size_t w = 0; w < words; ++w)
+                    next[w] = sets[words + w];
+                regex_closure(states, &next[0], stack);
+                for (size_t w = 0; w < words; ++w)
+                    sets[words + w] = next[w];
+            }
+
+            for (size_t dfa_state = 0; dfa_state * words < sets.size(); ++dfa_state)
+            {
+                accepting.push_back(((sets[dfa_state * words + whole.end / 64] >> (whole.end % 64)) & 1) != 0);
+
+                for (size_t c = 0; c < class_count; ++c)
+                {
+                    for (size_t w = 0; w < words; ++w)
+                        next[w] = 0;
+
+                    for (size_t s = 0; s < states.size(); ++s)
+                    {
+                        if (((sets[dfa_state * words + s / 64] >> (s % 64)) & 1) && states[s].consumes && states[s].bytes.contains(representative[c]))
+                            next[states[s].out / 64] |= uint64_t(1) << (states[s].out % 64);
+                    }
+                    regex_closure(states, &next[0], stack);
+
+                    size_t target = 0;
+                    const size_t known = sets.size() / words;
+                    for (; target < known; ++target)
+                    {
+                        bool same = true;
+                        for (size_t w = 0; w < words && same; ++w)
+                            same = sets[target * words + w] == next[w];
+                        if (same)
+                            break;
+                    }
+                    if (target == known)
+                    {
+                        if (known == regex_max_states)
+                            regex_too_many_states();
+                        for (size_t w = 0; w < words; ++w)
+                            sets.push_back(next[w]);
+                    }
+                    transitions.push_back(target);
+                }
+            }
+
+            // Moore's partition refinement: states stay together while they agree on accepting
+            // and their transitions lead to the same blocks.
+            const size_t dfa_states = accepting.size();
+            regex_buffer<size_t> block;
+            regex_buffer<size_t> refined;
+            regex_buffer<size_t> representatives;
+            block.resize(dfa_states, 0);
+            refined.resize(dfa_states, 0);
+            for (size_t s = 0; s < dfa_states; ++s)
+                block[s] = accepting[s] ? 1 : 0;
+
+            size_t block_count = 0;
+            while (true)
+            {
+                representatives.clear();
+                for (size_t s = 0; s < dfa_states; ++s)
+                {
+                    size_t b = 0;
+                    for (; b < representatives.size(); ++b)
+                    {
+                        const size_t other = representatives[b];
+                        bool same = block[s] == block[other];
+                        for (size_t c = 0; c < class_count && same; ++c)
+                            same = block[transitions[s * class_count + c]] == block[transitions[other * class_count + c]];
+                        if (same)
+                            break;
+                    }
+                    if (b == representatives.size())
+                        representatives.push_back(s);
+                    refined[s] = b;
+                }
+
+                for (size_t s = 0; s < dfa_states; ++s)
+                    block[s] = refined[s];
+                if (representatives.size() == block_count)
+                    break;
+                block_count = representatives.size();
+            }
+
+            // Renumbered so that the dead state's block is 0 and the start state's comes next.
+            regex_buffer<size_t> order;
+            order.resize(block_count, regex_none);
+            size_t numbered = 0;
+            order[block[0]] = numbered++;
+            if (order[block[1]] == regex_none)
+                order[block[1]] = numbered++;
+            for (size_t s = 0; s < dfa_states; ++s)
+            {
+                if (order[block[s]] == regex_none)
+                    order[block[s]] = numbered++;
+            }
+
+            automaton.class_count = class_count;
+            automaton.state_count = block_count;
+            automaton.start = order[block[1]];
+            automaton.transitions.resize(block_count * class_count, 0);
+            automaton.accepting.resize(block_count, false);
+            for (size_t b = 0; b < block_count; ++b)
+            {
+                const size_t s = representatives[b];
+                const size_t row = order[b];
+                automaton.accepting[row] = accepting[s];
+                for (size_t c = 0; c < class_count; ++c)
+                    automaton.transitions[row * class_count + c] = order[block[transitions[s * class_count + c]]];
+            }
+        }
+
+        consteval regex_dfa_size regex_measure(string_view pattern)
+        {
+            regex_automaton automaton;
+            regex_build(pattern, automaton);
+            return { automaton.state_count, automaton.class_count };
+        }
+
+        template<size_t States, size_t Classes>
+        consteval regex_dfa<States, Classes> regex_compile(string_view pattern)
+        {
+            using state_type = regex_dfa<States, Classes>::state_type;
+
+            regex_automaton automaton;
+            regex_build(pattern, automaton);
+
+            regex_dfa<States, Classes> dfa{};
+            for (size_t byte = 0; byte < 256; ++byte)
+                dfa.classes[byte] = automaton.classes[byte];
+            for (size_t i = 0; i < States * Classes; ++i)
+                dfa.transitions[i] = static_cast<state_type>(automaton.transitions[i]);
+            for (size_t s = 0; s < States; ++s)
+                dfa.accepting[s] = automaton.accepting[s];
+            dfa.start = static_cast<state_type>(automaton.start);
+            return dfa;
+        }
+
+        template<regex_char_range R>
+        constexpr string_view regex_view(R& range) noexcept
+        {
+            const size_t size = ranges::size(range);
+            return size ? string_view(&*ranges::begin(range), size) : string_view();
+        }
+    }
+
+
+
+    // static_regex
+    // Member functions
+    template<regex_pattern Pattern>
+    constexpr bool static_regex<Pattern>::match(string_view text) noexcept
+    {
+        size_t state = dfa.start;
+        for (const char ch : text)
+        {
+            state = dfa.transitions[state * size.classes + dfa.classes[static_cast<uint8_t>(ch)]];
+            if (state == 0)
+                return false;
+        }
+        return dfa.accepting[state];
+    }
+
+    template<regex_pattern Pattern>
+    constexpr size_t static_regex<Pattern>::match_prefix(string_view text) noexcept
+    {
+        size_t state = dfa.start;
+        size_t longest = dfa.accepting[state] ? 0 : string_view::npos;
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            state = dfa.transitions[state * size.classes + dfa.classes[static_cast<uint8_t>(text[i])]];
+            if (state == 0)
+                break;
+            if (dfa.accepting[state])
+                longest = i + 1;
+        }
+        return longest;
+    }
+
+    template<regex_pattern Pattern>
+    constexpr regex_result static_regex<Pattern>::search(string_view text) noexcept
+    {
+        for (size_t position = 0; position <= text.size(); ++position)
+        {
+            const size_t length = match_prefix(text.substr(position));
+            if (length != string_view::npos)
+                return { position, length };
+        }
+        return { string_view::npos, 0 };
+    }
+
+    template<regex_pattern Pattern>
+    template<detail::regex_char_range R>
+    constexpr bool static_regex<Pattern>::match(R&& text) noexcept
+    {
+        return match(detail::regex_view(text));
+    }
+
+    template<regex_pattern Pattern>
+    template<detail::regex_char_range R>
+    constexpr size_t static_regex<Pattern>::match_prefix(R&& text) noexcept
+    {
+        return match_prefix(detail::regex_view(text));
+    }
+
+    template<regex_pattern Pattern>
+    template<detail::regex_char_range R>
+    constexpr regex_result static_regex<Pattern>::search(R&& text) noexcept
+    {
+        return search(detail::regex_view(text));
+    }
+}
+
+
+#endif //STL_REGEX_HPP
@@ -0,0 +1,129 @@
+#ifndef STL_SEARCHER_HPP
+#define STL_SEARCHER_HPP
+
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "span.hpp"
+#include "string_view.hpp"
+
+namespace std
+{
+    // Position of the first needle in haystack at or after from, string_view::npos when there is
+    // none. An empty needle matches at from.
+    size_t find_substring(string_view haystack, string_view needle, size_t from = 0) noexcept;
+
+    // A needle prepared once for many haystacks.
+    // Short needles are found by comparing the needle's first and last byte against a whole vector
+    // of candidate positions at once (AVX2 or SSE2, picked at run time), the rest of the needle
+    // only being compared where both match. Needles of horspool_threshold bytes and more use
+    // Boyer-Moore-Horspool instead, whose skips grow with the needle.
+    class substring_searcher
+    {
+    public:
+        static constexpr size_t horspool_threshold = 64;
+
+        /// Constructors
+        explicit substring_searcher(string_view needle) noexcept;
+
+        /// Member functions
+        size_t find(string_view haystack, size_t from = 0) const noexcept;
+        string_view needle() const noexcept;
+    private:
+        string_view m_needle;
+        uint32_t m_shift[256];  // Horspool shift per byte, only filled for long needles
+    };
+
+    // Finds every occurrence of a fixed set of patterns in a single pass over the text, whatever
+    // the number of patterns.
+    // The automaton is a complete transition table (no failure links to follow while scanning),
+    // kept small by mapping the bytes that appear in no pattern to one shared column. States
+    // that report a match are numbered last, so the scan loop tests for a match with a single
+    // comparison and no extra load.
+    class aho_corasick
+    {
+    public:
+        struct match
+        {
+            size_t pattern;     // index in the list given to the constructor
+            size_t position;    // offset of the first character of the match
+        };
+
+        /// Constructors
+        // Empty patterns are ignored, a pattern listed twice is reported under its first index.
+        // When memory runs out the automaton is left empty and matches nothing.
+        explicit aho_corasick(span<const string_view> patterns);
+        aho_corasick(const aho_corasick&) = delete;
+        aho_corasick(aho_corasick&& other) noexcept;
+
+        /// Destructor
+        ~aho_corasick();
+
+        /// Operators
+        aho_corasick& operator=(const aho_corasick&) = delete;
+        aho_corasick& operator=(aho_corasick&& other) noexcept;
+
+        /// Member functions
+        // Calls on_match(match) for every occurrence, overlapping ones included, in the order they
+        // end in the text. on_match returns false to stop the scan.
+        template<class F>
+        void find_all(string_view text, F on_match) const;
+
+        // The occurrence that ends first, { npos, npos } when there is none.
+        match find_first(string_view text) const noexcept;
+
+        size_t pattern_count() const noexcept;
+        size_t state_count() const noexcept;
+    private:
+        void release() noexcept;
+
+        void* m_block;
+        uint32_t* m_transitions;    // state_count rows of class_count entries, each a row offset
+        uint32_t* m_outputs;        // per state: 1 + the pattern ending there, or 0
+        uint32_t* m_output_links;   // per state: next shorter suffix state with an output, or 0
+        uint32_t* m_lengths;        // per pattern
+        uint32_t m_state_count;
+        uint32_t m_class_count;
+        uint32_t m_first_output_row;
+        size_t m_pattern_count;
+        uint8_t m_classes[256];
+    };
+
+
+    // aho_corasick
+    template<class F>
+    void aho_corasick::find_all(string_view text, F on_match) const
+    {
+        if (!m_transitions)
+            return;
+
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(text.data());
+        const size_t size = text.size();
+        const uint32_t* transitions = m_transitions;
+        const uint32_t first_output_row = m_first_output_row;
+
+        uint32_t row = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            row = transitions[row + m_classes[bytes[i]]];
+            if (row < first_output_row) [[likely]]
+                continue;
+
+            // The state's own pattern, then those ending at its shorter suffixes.
+            uint32_t state = row / m_class_count;
+            do
+            {
+                if (m_outputs[state] != 0)
+                {
+                    const size_t pattern = m_outputs[state] - 1;
+                    if (!on_match(match{ pattern, i + 1 - m_lengths[pattern] }))
+                        return;
+                }
+                state = m_output_links[state];
+            } while (state != 0);
+        }
+    }
+}
+
+
+#endif //STL_SEARCHER_HPP
@@ -0,0 +1,15 @@
+#ifndef STL_SECTION_HPP
+#define STL_SECTION_HPP
+
+
+// Section placement attributes, matched by parser.ld.
+// STL_HOT / STL_STARTUP code is linked contiguously, STL_COLD code is moved out of its way.
+#define STL_HOT [[gnu::hot, gnu::section(".text.stl.hot")]]
+#define STL_COLD [[gnu::cold, gnu::section(".text.stl.cold")]]
+#define STL_STARTUP [[gnu::section(".text.stl.startup")]]
+
+// Data only written during static initialization, see std::seal_ro_after_init.
+#define STL_RO_AFTER_INIT [[gnu::section(".data.ro_after_init")]]
+
+
+#endif //STL_SECTION_HPP
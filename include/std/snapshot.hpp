@@ -0,0 +1,460 @@
+#ifndef STL_SNAPSHOT_HPP
+#define STL_SNAPSHOT_HPP
+
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "memory.hpp"
+#include "new.hpp"
+#include "span.hpp"
+#include "string_view.hpp"
+#include "type_traits.hpp"
+
+// Position-independent images of parsed data, used in place from wherever they are loaded or
+// mapped: no pointer is fixed up and nothing is deserialized, so a mapped image stays shared
+// and clean.
+//
+// An image holds image types: trivially copyable records, snapshot_string, snapshot_array and
+// offset_ptr, whose targets are stored as distances from themselves. snapshot_writer lays the
+// image out, with every object at its alignment, and snapshot_root validates one (magic, format,
+// caller version, root type size, bounds, checksum) before handing out its root object.
+//
+// snapshot_traits<T> maps a source type to its image type. Trivially copyable types are their
+// own image, string_view, span and unique_ptr map to the snapshot containers; other types
+// specialize it:
+//
+//     template<> struct snapshot_traits<option>
+//     {
+//         using image_type = option_image;
+//         static void write(snapshot_writer& writer, const option& value, snapshot_ref<option_image> out) noexcept
+//         {
+//             writer.write(out, &option_image::name, value.name);
+//             writer.write(out, &option_image::children, span<const option>(value.children, value.count));
+//             writer.write(out, &option_image::fallback, value.fallback);    // unique_ptr<option>
+//         }
+//     };
+//
+// where option_image::fallback is an offset_ptr<const option_image>: owned trees and lists are
+// written depth first, a null unique_ptr staying a null offset_ptr.
+//
+// Images are meant to be read back by the build that wrote them: they use the native byte order
+// and layout, and the caller's version number must change with the image types.
+namespace std
+{
+    inline constexpr uint32_t snapshot_magic = 0x50414E53;     // "SNAP"
+    inline constexpr uint32_t snapshot_format = 1;
+    inline constexpr size_t snapshot_alignment = 16;          // of the image buffer, and its largest object alignment
+
+    struct snapshot_header
+    {
+        uint32_t magic;
+        uint32_t format;
+        uint32_t version;       // chosen by the caller
+        uint32_t root_size;     // sizeof the root object's type
+        uint64_t size;          // of the whole image, this header included
+        uint64_t root;          // offset of the root object
+        uint64_t checksum;      // detail::hash_bytes of everything after the header
+        uint64_t reserved;
+    };
+
+    // Pointer stored as the distance from itself to its target, valid wherever the image that
+    // holds both is. It cannot be copied: a copy outside the image would point elsewhere.
+    template<class T>
+    class offset_ptr
+    {
+    public:
+        /// Member types
+        using element_type = T;
+
+        /// Constructors
+        constexpr offset_ptr() noexcept = default;
+        offset_ptr(const offset_ptr&) = delete;
+
+        /// Operators
+        offset_ptr& operator=(const offset_ptr&) = delete;
+        // target must be nullptr or live in the same image.
+        offset_ptr& operator=(T* target) noexcept;
+
+        T& operator*() const noexcept;
+        T* operator->() const noexcept;
+        explicit operator bool() const noexcept;
+
+        /// Member functions
+        T* get() const noexcept;
+    private:
+        int64_t m_offset = 0;   // 0 is null: an object never points to itself
+    };
+
+    template<class T>
+    class snapshot_array
+    {
+    public:
+        /// Member types
+        using value_type = T;
+        using size_type = size_t;
+        using const_iterator = const T*;
+
+        /// Operators
+        const T& operator[](size_t index) const noexcept;
+
+        /// Member functions
+        void assign(const T* data, size_t size) noexcept;
+
+        span<const T> view() const noexcept;
+        const T* data() const noexcept;
+        size_t size() const noexcept;
+        bool empty() const noexcept;
+
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+    private:
+        offset_ptr<const T> m_data;
+        uint64_t m_size = 0;
+    };
+
+    // NUL terminated in the image, so c_str() needs no copy.
+    class snapshot_string
+    {
+    public:
+        /// Member functions
+        void assign(const char* data, size_t size) noexcept;
+
+        string_view view() const noexcept;
+        const char* c_str() const noexcept;
+        size_t size() const noexcept;
+        bool empty() const noexcept;
+    private:
+        offset_ptr<const char> m_data;
+        uint64_t m_size = 0;
+    };
+
+    // Object of an image under construction, as an offset: the writer's buffer moves as it
+    // grows. Offset 0 is the header, which no object uses: a null reference, returned when the
+    // writer ran out of memory.
+    template<class T>
+    struct snapshot_ref
+    {
+        uint64_t offset = 0;
+
+        explicit operator bool() const noexcept
+        {
+            return offset != 0;
+        }
+    };
+
+    class snapshot_writer;
+
+    template<class T>
+    struct snapshot_traits
+    {
+        static_assert(is_trivially_copyable_v<T> && !is_pointer_v<T>, "T has no image type: specialize snapshot_traits for it.");
+
+        using image_type = T;
+
+        static void write(snapshot_writer& writer, const T& value, snapshot_ref<T> out) noexcept;
+    };
+
+    template<class T>
+    using snapshot_image_t = snapshot_traits<T>::image_type;
+
+    template<>
+    struct snapshot_traits<string_view>
+    {
+        using image_type = snapshot_string;
+
+        static void write(snapshot_writer& writer, string_view value, snapshot_ref<snapshot_string> out) noexcept;
+    };
+
+    template<class T>
+    struct snapshot_traits<span<T>>
+    {
+        using image_type = snapshot_array<snapshot_image_t<remove_cv_t<T>>>;
+
+        static void write(snapshot_writer& writer, span<T> value, snapshot_ref<image_type> out) noexcept;
+    };
+
+    // A unique_ptr-owned tree becomes a tree of offset_ptr, null pointers included.
+    template<class T, class D>
+    struct snapshot_traits<unique_ptr<T, D>>
+    {
+        using image_type = offset_ptr<const snapshot_image_t<T>>;
+
+        static void write(snapshot_writer& writer, const unique_ptr<T, D>& value, snapshot_ref<image_type> out) noexcept;
+    };
+
+    class snapshot_writer
+    {
+    public:
+        /// Constructors
+        snapshot_writer() noexcept;
+        snapshot_writer(const snapshot_writer&) = delete;
+
+        /// Destructor
+        ~snapshot_writer();
+
+        /// Operators
+        snapshot_writer& operator=(const snapshot_writer&) = delete;
+
+        /// Member functions
+        // count default constructed objects, contiguous and aligned for T.
+        template<class T>
+        snapshot_ref<T> allocate(size_t count = 1) noexcept;
+
+        // The object behind ref, valid until the next allocation; nullptr for a null reference.
+        template<class T>
+        T* get(snapshot_ref<T> ref) noexcept;
+
+        // The member of an object, as a reference of its own.
+        template<class Image, class Member>
+        snapshot_ref<Member> member(snapshot_ref<Image> object, Member Image::* pointer) noexcept;
+
+        // Writes the image of value into a new object.
+        template<class T>
+        snapshot_ref<snapshot_image_t<T>> write(const T& value) noexcept;
+        // Writes the image of value into out.
+        template<class T>
+        void write(snapshot_ref<snapshot_image_t<T>> out, const T& value) noexcept;
+        // Writes the image of value into a member of out.
+        template<class Image, class Member, class T>
+        void write(snapshot_ref<Image> out, Member Image::* pointer, const T& value) noexcept;
+
+        // Completes the header and returns the image, empty when the writer ran out of memory.
+        // The image stays owned by the writer.
+        template<class T>
+        span<const char> finish(snapshot_ref<T> root, uint32_t version) noexcept;
+
+        bool failed() const noexcept;
+    private:
+        // Offset of size new zeroed bytes at alignment, 0 when out of memory.
+        uint64_t reserve(size_t size, size_t alignment) noexcept;
+        span<const char> seal(uint64_t root, size_t root_size, uint32_t version) noexcept;
+
+        char* m_data;
+        size_t m_size;
+        size_t m_capacity;
+        bool m_failed;
+    };
+
+    // The root object of image, after checking its header and checksum against the version and
+    // type the caller expects; nullptr for a stale, truncated, misaligned or corrupted image.
+    template<class T>
+    const T* snapshot_root(span<const char> image, uint32_t version) noexcept;
+
+    namespace detail
+    {
+        const void* snapshot_validate(span<const char> image, uint32_t version, size_t root_size, size_t root_alignment) noexcept;
+    }
+
+
+    // offset_ptr
+    // Operators
+    template<class T>
+    offset_ptr<T>& offset_ptr<T>::operator=(T* target) noexcept
+    {
+        m_offset = target ? reinterpret_cast<const char*>(target) - reinterpret_cast<const char*>(this) : 0;
+        return *this;
+    }
+
+    template<class T>
+    T& offset_ptr<T>::operator*() const noexcept
+    {
+        return *get();
+    }
+
+    template<class T>
+    T* offset_ptr<T>::operator->() const noexcept
+    {
+        return get();
+    }
+
+    template<class T>
+    offset_ptr<T>::operator bool() const noexcept
+    {
+        return m_offset != 0;
+    }
+
+    // Member functions
+    template<class T>
+    T* offset_ptr<T>::get() const noexcept
+    {
+        if (!m_offset)
+            return nullptr;
+
+        return reinterpret_cast<T*>(const_cast<char*>(reinterpret_cast<const char*>(this)) + m_offset);
+    }
+
+
+    // snapshot_array
+    // Operators
+    template<class T>
+    const T& snapshot_array<T>::operator[](size_t index) const noexcept
+    {
+        return m_data.get()[index];
+    }
+
+    // Member functions
+    template<class T>
+    void snapshot_array<T>::assign(const T* data, size_t size) noexcept
+    {
+        m_data = size ? data : nullptr;
+        m_size = size;
+    }
+
+    template<class T>
+    span<const T> snapshot_array<T>::view() const noexcept
+    {
+        return span<const T>(m_data.get(), static_cast<size_t>(m_size));
+    }
+
+    template<class T>
+    const T* snapshot_array<T>::data() const noexcept
+    {
+        return m_data.get();
+    }
+
+    template<class T>
+    size_t snapshot_array<T>::size() const noexcept
+    {
+        return static_cast<size_t>(m_size);
+    }
+
+    template<class T>
+    bool snapshot_array<T>::empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    template<class T>
+    snapshot_array<T>::const_iterator snapshot_array<T>::begin() const noexcept
+    {
+        return m_data.get();
+    }
+
+    template<class T>
+    snapshot_array<T>::const_iterator snapshot_array<T>::end() const noexcept
+    {
+        return m_data.get() + m_size;
+    }
+
+
+    // snapshot_traits
+    // Functions
+    template<class T>
+    void snapshot_traits<T>::write(snapshot_writer& writer, const T& value, snapshot_ref<T> out) noexcept
+    {
+        if (T* image = writer.get(out))
+            __builtin_memcpy(image, &value, sizeof(T));
+    }
+
+    template<class T>
+    void snapshot_traits<span<T>>::write(snapshot_writer& writer, span<T> value, snapshot_ref<image_type> out) noexcept
+    {
+        using element_image = snapshot_image_t<remove_cv_t<T>>;
+
+        if (value.empty())
+            return;
+
+        const snapshot_ref<element_image> elements = writer.allocate<element_image>(value.size());
+        if (!elements)
+            return;
+
+        for (size_t i = 0; i < value.size(); ++i)
+            writer.write(snapshot_ref<element_image>{ elements.offset + i * sizeof(element_image) }, value[i]);
+
+        if (image_type* image = writer.get(out))
+            image->assign(writer.get(elements), value.size());
+    }
+
+    template<class T, class D>
+    void snapshot_traits<unique_ptr<T, D>>::write(snapshot_writer& writer, const unique_ptr<T, D>& value, snapshot_ref<image_type> out) noexcept
+    {
+        if (!value.get())
+            return;
+
+        const snapshot_ref<snapshot_image_t<T>> child = writer.write(*value.get());
+        if (!child)
+            return;
+
+        if (image_type* image = writer.get(out))
+            *image = writer.get(child);
+    }
+
+
+    // snapshot_writer
+    // Member functions
+    template<class T>
+    snapshot_ref<T> snapshot_writer::allocate(size_t count) noexcept
+    {
+        static_assert(alignof(T) <= snapshot_alignment, "Image types cannot be more aligned than the image.");
+
+        if (count > (static_cast<size_t>(-1) - m_size) / sizeof(T))
+        {
+            m_failed = true;
+            return {};
+        }
+
+        const uint64_t offset = reserve(count * sizeof(T), alignof(T));
+        if (!offset)
+            return {};
+
+        for (size_t i = 0; i < count; ++i)
+            new (m_data + offset + i * sizeof(T)) T();
+
+        return { offset };
+    }
+
+    template<class T>
+    T* snapshot_writer::get(snapshot_ref<T> ref) noexcept
+    {
+        return ref ? reinterpret_cast<T*>(m_data + ref.offset) : nullptr;
+    }
+
+    template<class Image, class Member>
+    snapshot_ref<Member> snapshot_writer::member(snapshot_ref<Image> object, Member Image::* pointer) noexcept
+    {
+        Image* image = get(object);
+        if (!image)
+            return {};
+
+        return { static_cast<uint64_t>(reinterpret_cast<char*>(&(image->*pointer)) - m_data) };
+    }
+
+    template<class T>
+    snapshot_ref<snapshot_image_t<T>> snapshot_writer::write(const T& value) noexcept
+    {
+        const snapshot_ref<snapshot_image_t<T>> out = allocate<snapshot_image_t<T>>();
+        if (out)
+            write(out, value);
+        return out;
+    }
+
+    template<class T>
+    void snapshot_writer::write(snapshot_ref<snapshot_image_t<T>> out, const T& value) noexcept
+    {
+        snapshot_traits<T>::write(*this, value, out);
+    }
+
+    template<class Image, class Member, class T>
+    void snapshot_writer::write(snapshot_ref<Image> out, Member Image::* pointer, const T& value) noexcept
+    {
+        static_assert(is_same_v<Member, snapshot_image_t<T>>, "The member is not the image type of the value.");
+        write(member(out, pointer), value);
+    }
+
+    template<class T>
+    span<const char> snapshot_writer::finish(snapshot_ref<T> root, uint32_t version) noexcept
+    {
+        return seal(root.offset, sizeof(T), version);
+    }
+
+
+    // Functions
+    template<class T>
+    const T* snapshot_root(span<const char> image, uint32_t version) noexcept
+    {
+        return static_cast<const T*>(detail::snapshot_validate(image, version, sizeof(T), alignof(T)));
+    }
+}
+
+
+#endif //STL_SNAPSHOT_HPP
@@ -0,0 +1,607 @@
+#ifndef STL_SOA_VECTOR_HPP
+#define STL_SOA_VECTOR_HPP
+
+
+#include "cstddef.hpp"
+#include "iterator.hpp"
+#include "span.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+namespace std
+{
+    namespace detail
+    {
+        // Every column starts on its own cache line, which also satisfies any vector load width.
+        inline constexpr size_t soa_column_alignment = 64;
+
+        template<size_t I, class Head, class... Tail>
+        struct soa_field : soa_field<I - 1, Tail...> {};
+
+        template<class Head, class... Tail>
+        struct soa_field<0, Head, Tail...> { using type = Head; };
+
+        template<bool Const, class T>
+        struct soa_qualified { using type = T; };
+
+        template<class T>
+        struct soa_qualified<true, T> { using type = const T; };
+
+        // Places count columns of capacity elements back to back in one block. Writes each
+        // column's byte offset and returns the block size.
+        size_t soa_layout(size_t capacity, const size_t* element_sizes, size_t count, size_t* offsets) noexcept;
+    }
+
+    // Vector of records stored as one array per field (structure of arrays).
+    // Scanning a single field touches only that field's column, and column<I>() exposes it as a
+    // plain contiguous span for vectorized loops. All the columns share a single allocation and
+    // grow together. Fields must be trivially copyable.
+    template<class... Fields>
+    class soa_vector
+    {
+    public:
+        static constexpr size_t field_count = sizeof...(Fields);
+
+        template<size_t I>
+        using field_type = detail::soa_field<I, Fields...>::type;
+
+        // Proxy for the element at one index: the fields are not adjacent in memory, so there is
+        // no Record& to hand out.
+        template<bool Const>
+        class basic_reference
+        {
+        public:
+            template<size_t I>
+            using field_reference = detail::soa_qualified<Const, field_type<I>>::type&;
+
+            // Mutable to const only; a template, so that it never stands in for the copy constructor.
+            template<bool OtherConst> requires (Const && !OtherConst)
+            constexpr basic_reference(const basic_reference<OtherConst>& other) noexcept;
+
+            template<size_t I>
+            field_reference<I> get() const noexcept;
+
+            void assign(const Fields&... values) const noexcept requires (!Const);
+        private:
+            friend soa_vector;
+            friend basic_reference<true>;
+
+            using owner_pointer = detail::soa_qualified<Const, soa_vector>::type*;
+
+            constexpr basic_reference(owner_pointer owner, size_t index) noexcept;
+
+            owner_pointer m_owner;
+            size_t m_index;
+        };
+
+        template<bool Const>
+        class basic_iterator
+        {
+        public:
+            /// Member types
+            using iterator_category = random_access_iterator_tag;
+            using difference_type = ptrdiff_t;
+            // The fields have no record type of their own, so the proxy doubles as the value.
+            using value_type = basic_reference<Const>;
+            using reference = basic_reference<Const>;
+
+            /// Constructors
+            constexpr basic_iterator() noexcept = default;
+            template<bool OtherConst> requires (Const && !OtherConst)
+            constexpr basic_iterator(const basic_iterator<OtherConst>& other) noexcept;
+
+            /// Operators
+            reference operator*() const noexcept;
+            reference operator[](difference_type offset) const noexcept;
+
+            basic_iterator& operator++() noexcept;
+            basic_iterator operator++(int) noexcept;
+            basic_iterator& operator--() noexcept;
+            basic_iterator operator--(int) noexcept;
+            basic_iterator& operator+=(difference_type offset) noexcept;
+            basic_iterator& operator-=(difference_type offset) noexcept;
+            basic_iterator operator+(difference_type offset) const noexcept;
+            basic_iterator operator-(difference_type offset) const noexcept;
+            difference_type operator-(const basic_iterator& other) const noexcept;
+
+            bool operator==(const basic_iterator& other) const noexcept;
+            bool operator<(const basic_iterator& other) const noexcept;
+            bool operator>(const basic_iterator& other) const noexcept;
+            bool operator<=(const basic_iterator& other) const noexcept;
+            bool operator>=(const basic_iterator& other) const noexcept;
+
+            friend basic_iterator operator+(difference_type offset, const basic_iterator& iterator) noexcept
+            {
+                return iterator + offset;
+            }
+        private:
+            friend soa_vector;
+            friend basic_iterator<true>;
+
+            using owner_pointer = detail::soa_qualified<Const, soa_vector>::type*;
+
+            constexpr basic_iterator(owner_pointer owner, size_t index) noexcept;
+
+            owner_pointer m_owner = nullptr;
+            size_t m_index = 0;
+        };
+
+        /// Member types
+        using size_type = size_t;
+        using reference = basic_reference<false>;
+        using const_reference = basic_reference<true>;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        /// Constructors
+        constexpr soa_vector() noexcept;
+        soa_vector(const soa_vector& other);
+        soa_vector(soa_vector&& other) noexcept;
+
+        /// Destructor
+        ~soa_vector();
+
+        /// Operators
+        soa_vector& operator=(const soa_vector& other);
+        soa_vector& operator=(soa_vector&& other) noexcept;
+
+        reference operator[](size_type index) noexcept;
+        const_reference operator[](size_type index) const noexcept;
+
+        /// Member functions
+        //  Column access
+        template<size_t I>
+        span<field_type<I>> column() noexcept;
+        template<size_t I>
+        span<const field_type<I>> column() const noexcept;
+
+        template<size_t I>
+        field_type<I>* data() noexcept;
+        template<size_t I>
+        const field_type<I>* data() const noexcept;
+
+        //  Iterators
+        iterator begin() noexcept;
+        const_iterator begin() const noexcept;
+        iterator end() noexcept;
+        const_iterator end() const noexcept;
+
+        //  Capacity
+        bool empty() const noexcept;
+        size_type size() const noexcept;
+        size_type capacity() const noexcept;
+        void reserve(size_type new_capacity);
+
+        //  Modifiers
+        void push_back(const Fields&... values);
+        void pop_back() noexcept;
+        void resize(size_type new_size);
+        void clear() noexcept;
+        void swap(soa_vector& other) noexcept;
+    private:
+        static constexpr size_t element_sizes[field_count] = { sizeof(Fields)... };
+
+        void reallocate(size_type new_capacity);
+        void release() noexcept;
+
+        void* m_block;
+        char* m_columns[field_count];
+        size_type m_size;
+        size_type m_capacity;
+    };
+
+
+    // soa_vector::basic_reference
+    template<class... Fields>
+    template<bool Const>
+    constexpr soa_vector<Fields...>::basic_reference<Const>::basic_reference(owner_pointer owner, size_t index) noexcept
+        : m_owner(owner), m_index(index)
+    {
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    template<bool OtherConst> requires (Const && !OtherConst)
+    constexpr soa_vector<Fields...>::basic_reference<Const>::basic_reference(const basic_reference<OtherConst>& other) noexcept
+        : m_owner(other.m_owner), m_index(other.m_index)
+    {
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    template<size_t I>
+    soa_vector<Fields...>::basic_reference<Const>::field_reference<I> soa_vector<Fields...>::basic_reference<Const>::get() const noexcept
+    {
+        return m_owner->template data<I>()[m_index];
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    void soa_vector<Fields...>::basic_reference<Const>::assign(const Fields&... values) const noexcept requires (!Const)
+    {
+        size_t column = 0;
+        ((reinterpret_cast<Fields*>(m_owner->m_columns[column++])[m_index] = values), ...);
+    }
+
+
+    // soa_vector::basic_iterator
+    template<class... Fields>
+    template<bool Const>
+    constexpr soa_vector<Fields...>::basic_iterator<Const>::basic_iterator(owner_pointer owner, size_t index) noexcept
+        : m_owner(owner), m_index(index)
+    {
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    template<bool OtherConst> requires (Const && !OtherConst)
+    constexpr soa_vector<Fields...>::basic_iterator<Const>::basic_iterator(const basic_iterator<OtherConst>& other) noexcept
+        : m_owner(other.m_owner), m_index(other.m_index)
+    {
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const>::reference soa_vector<Fields...>::basic_iterator<Const>::operator*() const noexcept
+    {
+        return reference(m_owner, m_index);
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const>::reference soa_vector<Fields...>::basic_iterator<Const>::operator[](difference_type offset) const noexcept
+    {
+        return reference(m_owner, m_index + offset);
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const>& soa_vector<Fields...>::basic_iterator<Const>::operator++() noexcept
+    {
+        ++m_index;
+        return *this;
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const> soa_vector<Fields...>::basic_iterator<Const>::operator++(int) noexcept
+    {
+        basic_iterator previous = *this;
+        ++m_index;
+        return previous;
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const>& soa_vector<Fields...>::basic_iterator<Const>::operator--() noexcept
+    {
+        --m_index;
+        return *this;
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const> soa_vector<Fields...>::basic_iterator<Const>::operator--(int) noexcept
+    {
+        basic_iterator previous = *this;
+        --m_index;
+        return previous;
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const>& soa_vector<Fields...>::basic_iterator<Const>::operator+=(difference_type offset) noexcept
+    {
+        m_index += offset;
+        return *this;
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const>& soa_vector<Fields...>::basic_iterator<Const>::operator-=(difference_type offset) noexcept
+    {
+        m_index -= offset;
+        return *this;
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const> soa_vector<Fields...>::basic_iterator<Const>::operator+(difference_type offset) const noexcept
+    {
+        return basic_iterator(m_owner, m_index + offset);
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const> soa_vector<Fields...>::basic_iterator<Const>::operator-(difference_type offset) const noexcept
+    {
+        return basic_iterator(m_owner, m_index - offset);
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    soa_vector<Fields...>::basic_iterator<Const>::difference_type soa_vector<Fields...>::basic_iterator<Const>::operator-(const basic_iterator& other) const noexcept
+    {
+        return static_cast<difference_type>(m_index - other.m_index);
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    bool soa_vector<Fields...>::basic_iterator<Const>::operator==(const basic_iterator& other) const noexcept
+    {
+        return m_index == other.m_index;
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    bool soa_vector<Fields...>::basic_iterator<Const>::operator<(const basic_iterator& other) const noexcept
+    {
+        return m_index < other.m_index;
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    bool soa_vector<Fields...>::basic_iterator<Const>::operator>(const basic_iterator& other) const noexcept
+    {
+        return m_index > other.m_index;
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    bool soa_vector<Fields...>::basic_iterator<Const>::operator<=(const basic_iterator& other) const noexcept
+    {
+        return m_index <= other.m_index;
+    }
+
+    template<class... Fields>
+    template<bool Const>
+    bool soa_vector<Fields...>::basic_iterator<Const>::operator>=(const basic_iterator& other) const noexcept
+    {
+        return m_index >= other.m_index;
+    }
+
+
+    // soa_vector
+    // Constructors implementations
+    template<class... Fields>
+    constexpr soa_vector<Fields...>::soa_vector() noexcept : m_block(nullptr), m_columns{}, m_size(0), m_capacity(0)
+    {
+        static_assert(field_count > 0, "soa_vector needs at least one field.");
+        static_assert((is_trivially_copyable_v<Fields> && ...), "soa_vector fields must be trivially copyable.");
+        static_assert(((alignof(Fields) <= detail::soa_column_alignment) && ...), "soa_vector fields cannot be over-aligned.");
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>::soa_vector(const soa_vector& other) : soa_vector()
+    {
+        reallocate(other.m_size);
+
+        for (size_t column = 0; column < field_count; ++column)
+            __builtin_memcpy(m_columns[column], other.m_columns[column], other.m_size * element_sizes[column]);
+
+        m_size = other.m_size;
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>::soa_vector(soa_vector&& other) noexcept : soa_vector()
+    {
+        swap(other);
+    }
+
+    // Destructor
+    template<class... Fields>
+    soa_vector<Fields...>::~soa_vector()
+    {
+        release();
+    }
+
+    // Operators
+    template<class... Fields>
+    soa_vector<Fields...>& soa_vector<Fields...>::operator=(const soa_vector& other)
+    {
+        if (this != &other)
+        {
+            soa_vector copy(other);
+            swap(copy);
+        }
+
+        return *this;
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>& soa_vector<Fields...>::operator=(soa_vector&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            swap(other);
+        }
+
+        return *this;
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>::reference soa_vector<Fields...>::operator[](size_type index) noexcept
+    {
+        return reference(this, index);
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>::const_reference soa_vector<Fields...>::operator[](size_type index) const noexcept
+    {
+        return const_reference(this, index);
+    }
+
+    // Member functions
+    template<class... Fields>
+    template<size_t I>
+    span<typename soa_vector<Fields...>::template field_type<I>> soa_vector<Fields...>::column() noexcept
+    {
+        return span<field_type<I>>(data<I>(), m_size);
+    }
+
+    template<class... Fields>
+    template<size_t I>
+    span<const typename soa_vector<Fields...>::template field_type<I>> soa_vector<Fields...>::column() const noexcept
+    {
+        return span<const field_type<I>>(data<I>(), m_size);
+    }
+
+    template<class... Fields>
+    template<size_t I>
+    soa_vector<Fields...>::field_type<I>* soa_vector<Fields...>::data() noexcept
+    {
+        return reinterpret_cast<field_type<I>*>(m_columns[I]);
+    }
+
+    template<class... Fields>
+    template<size_t I>
+    const typename soa_vector<Fields...>::template field_type<I>* soa_vector<Fields...>::data() const noexcept
+    {
+        return reinterpret_cast<const field_type<I>*>(m_columns[I]);
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>::iterator soa_vector<Fields...>::begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>::const_iterator soa_vector<Fields...>::begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>::iterator soa_vector<Fields...>::end() noexcept
+    {
+        return iterator(this, m_size);
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>::const_iterator soa_vector<Fields...>::end() const noexcept
+    {
+        return const_iterator(this, m_size);
+    }
+
+    template<class... Fields>
+    bool soa_vector<Fields...>::empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>::size_type soa_vector<Fields...>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    template<class... Fields>
+    soa_vector<Fields...>::size_type soa_vector<Fields...>::capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    template<class... Fields>
+    void soa_vector<Fields...>::reserve(size_type new_capacity)
+    {
+        if (new_capacity > m_capacity)
+            reallocate(new_capacity);
+    }
+
+    template<class... Fields>
+    void soa_vector<Fields...>::push_back(const Fields&... values)
+    {
+        if (m_size == m_capacity)
+            reallocate(m_capacity ? m_capacity * 2 : 16);
+
+        size_t column = 0;
+        ((reinterpret_cast<Fields*>(m_columns[column++])[m_size] = values), ...);
+        ++m_size;
+    }
+
+    template<class... Fields>
+    void soa_vector<Fields...>::pop_back() noexcept
+    {
+        --m_size;
+    }
+
+    template<class... Fields>
+    void soa_vector<Fields...>::resize(size_type new_size)
+    {
+        reserve(new_size);
+
+        size_t column = 0;
+        ([&]
+        {
+            Fields* values = reinterpret_cast<Fields*>(m_columns[column++]);
+            for (size_type index = m_size; index < new_size; ++index)
+                values[index] = Fields{};
+        }(), ...);
+
+        m_size = new_size;
+    }
+
+    template<class... Fields>
+    void soa_vector<Fields...>::clear() noexcept
+    {
+        m_size = 0;
+    }
+
+    template<class... Fields>
+    void soa_vector<Fields...>::swap(soa_vector& other) noexcept
+    {
+        std::swap(m_block, other.m_block);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+
+        for (size_t column = 0; column < field_count; ++column)
+            std::swap(m_columns[column], other.m_columns[column]);
+    }
+
+    // Every column moves to the new block at once; the block is over-allocated so that its first
+    // column can start on an aligned address.
+    template<class... Fields>
+    void soa_vector<Fields...>::reallocate(size_type new_capacity)
+    {
+        size_t offsets[field_count];
+        const size_t bytes = detail::soa_layout(new_capacity, element_sizes, field_count, offsets);
+
+        void* block = ::operator new(bytes + detail::soa_column_alignment - 1);
+        const size_t base = (reinterpret_cast<size_t>(block) + detail::soa_column_alignment - 1) & ~(detail::soa_column_alignment - 1);
+
+        for (size_t column = 0; column < field_count; ++column)
+        {
+            char* destination = reinterpret_cast<char*>(base) + offsets[column];
+            if (m_size)
+                __builtin_memcpy(destination, m_columns[column], m_size * element_sizes[column]);
+
+            m_columns[column] = destination;
+        }
+
+        ::operator delete(m_block);
+        m_block = block;
+        m_capacity = new_capacity;
+    }
+
+    template<class... Fields>
+    void soa_vector<Fields...>::release() noexcept
+    {
+        ::operator delete(m_block);
+
+        m_block = nullptr;
+        m_size = 0;
+        m_capacity = 0;
+
+        for (size_t column = 0; column < field_count; ++column)
+            m_columns[column] = nullptr;
+    }
+
+
+    static_assert(random_access_iterator<soa_vector<int, char>::iterator>);
+    static_assert(random_access_iterator<soa_vector<int, char>::const_iterator>);
+}
+
+
+#endif //STL_SOA_VECTOR_HPP
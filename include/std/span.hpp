@@ -0,0 +1,165 @@
+#ifndef STL_SPAN_HPP
+#define STL_SPAN_HPP
+
+
+#include "cstddef.hpp"
+#include "type_traits.hpp"
+
+namespace std
+{
+    inline constexpr size_t dynamic_extent = static_cast<size_t>(-1);
+
+    // Only the dynamic extent is supported for now.
+    template<class T>
+    class span
+    {
+    public:
+        /// Member types
+        using element_type = T;
+        using size_type = size_t;
+        using pointer = T*;
+        using reference = T&;
+        using iterator = T*;
+
+        /// Constructors
+        constexpr span() noexcept;
+        constexpr span(pointer data, size_type size) noexcept;
+        constexpr span(pointer first, pointer last) noexcept;
+        template<size_t N>
+        constexpr span(element_type (&array)[N]) noexcept;
+        template<class U> requires is_convertible_v<U(*)[], T(*)[]>
+        constexpr span(const span<U>& other) noexcept;
+
+        /// Operators
+        constexpr reference operator[](size_type index) const;
+
+        /// Member functions
+        //  Iterators
+        constexpr iterator begin() const noexcept;
+        constexpr iterator end() const noexcept;
+
+        //  Element access
+        constexpr reference front() const;
+        constexpr reference back() const;
+        constexpr pointer data() const noexcept;
+
+        //  Observers
+        constexpr size_type size() const noexcept;
+        constexpr size_type size_bytes() const noexcept;
+        constexpr bool empty() const noexcept;
+
+        //  Subviews
+        constexpr span first(size_type count) const;
+        constexpr span last(size_type count) const;
+        constexpr span subspan(size_type offset, size_type count = dynamic_extent) const;
+    private:
+        pointer m_data;
+        size_type m_size;
+    };
+
+
+    // Constructors implementations
+    template<class T>
+    constexpr span<T>::span() noexcept : m_data(nullptr), m_size(0)
+    {
+    }
+
+    template<class T>
+    constexpr span<T>::span(pointer data, size_type size) noexcept : m_data(data), m_size(size)
+    {
+    }
+
+    template<class T>
+    constexpr span<T>::span(pointer first, pointer last) noexcept : m_data(first), m_size(static_cast<size_type>(last - first))
+    {
+    }
+
+    template<class T>
+    template<size_t N>
+    constexpr span<T>::span(element_type (&array)[N]) noexcept : m_data(array), m_size(N)
+    {
+    }
+
+    template<class T>
+    template<class U> requires is_convertible_v<U(*)[], T(*)[]>
+    constexpr span<T>::span(const span<U>& other) noexcept : m_data(other.data()), m_size(other.size())
+    {
+    }
+
+    // Operators
+    template<class T>
+    constexpr span<T>::reference span<T>::operator[](size_type index) const
+    {
+        return m_data[index];
+    }
+
+    // Member functions
+    template<class T>
+    constexpr span<T>::iterator span<T>::begin() const noexcept
+    {
+        return m_data;
+    }
+
+    template<class T>
+    constexpr span<T>::iterator span<T>::end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+    template<class T>
+    constexpr span<T>::reference span<T>::front() const
+    {
+        return m_data[0];
+    }
+
+    template<class T>
+    constexpr span<T>::reference span<T>::back() const
+    {
+        return m_data[m_size - 1];
+    }
+
+    template<class T>
+    constexpr span<T>::pointer span<T>::data() const noexcept
+    {
+        return m_data;
+    }
+
+    template<class T>
+    constexpr span<T>::size_type span<T>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    template<class T>
+    constexpr span<T>::size_type span<T>::size_bytes() const noexcept
+    {
+        return m_size * sizeof(T);
+    }
+
+    template<class T>
+    constexpr bool span<T>::empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    template<class T>
+    constexpr span<T> span<T>::first(size_type count) const
+    {
+        return span(m_data, count);
+    }
+
+    template<class T>
+    constexpr span<T> span<T>::last(size_type count) const
+    {
+        return span(m_data + (m_size - count), count);
+    }
+
+    template<class T>
+    constexpr span<T> span<T>::subspan(size_type offset, size_type count) const
+    {
+        return span(m_data + offset, count == dynamic_extent ? m_size - offset : count);
+    }
+}
+
+
+#endif //STL_SPAN_HPP
@@ -0,0 +1,28 @@
+#ifndef STL_STARTUP_HPP
+#define STL_STARTUP_HPP
+
+
+#include "section.hpp"
+#include "span.hpp"
+
+namespace std
+{
+    // Runs the static constructors collected by parser.ld: the legacy .ctors list, the COFF
+    // .CRT$XC* list, then .init_array in priority order (an image only has the lists of its object
+    // format). Must be called once by the entry point, before any global object is used (the
+    // -nostdlib entry point has no C runtime doing it).
+    void run_static_constructors() noexcept;
+
+    // Runs .fini_array in reverse order, then the COFF .CRT$XT* list.
+    void run_static_destructors() noexcept;
+
+    // Page aligned range holding every STL_RO_AFTER_INIT object.
+    span<char> ro_after_init_region() noexcept;
+
+    // Hands that range to the platform once initialization is over; protect is expected to
+    // remap the pages read-only (page attributes in firmware, mprotect on a host).
+    void seal_ro_after_init(void (*protect)(span<char> region)) noexcept;
+}
+
+
+#endif //STL_STARTUP_HPP
@@ -0,0 +1,265 @@
+#ifndef STL_STRING_VIEW_HPP
+#define STL_STRING_VIEW_HPP
+
+
+#include "cstddef.hpp"
+#include "type_traits.hpp"
+
+namespace std
+{
+    template<class CharT>
+    class basic_string_view
+    {
+    public:
+        /// Member types
+        using value_type = CharT;
+        using size_type = size_t;
+        using pointer = const CharT*;
+        using const_reference = const CharT&;
+        using const_iterator = const CharT*;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        /// Constructors
+        constexpr basic_string_view() noexcept;
+        constexpr basic_string_view(const CharT* str, size_type count) noexcept;
+        constexpr basic_string_view(const CharT* str) noexcept;
+        constexpr basic_string_view(const CharT* first, const CharT* last) noexcept;
+
+        /// Operators
+        constexpr const_reference operator[](size_type pos) const;
+
+        /// Member functions
+        //  Iterators
+        constexpr const_iterator begin() const noexcept;
+        constexpr const_iterator end() const noexcept;
+
+        //  Element access
+        constexpr const_reference front() const;
+        constexpr const_reference back() const;
+        constexpr pointer data() const noexcept;
+
+        //  Capacity
+        constexpr size_type size() const noexcept;
+        constexpr size_type length() const noexcept;
+        constexpr bool empty() const noexcept;
+
+        //  Modifiers
+        constexpr void remove_prefix(size_type count);
+        constexpr void remove_suffix(size_type count);
+
+        //  Operations
+        constexpr basic_string_view substr(size_type pos = 0, size_type count = npos) const;
+        constexpr int compare(basic_string_view other) const noexcept;
+        constexpr bool starts_with(basic_string_view prefix) const noexcept;
+        constexpr bool ends_with(basic_string_view suffix) const noexcept;
+        constexpr size_type find(CharT ch, size_type pos = 0) const noexcept;
+        constexpr size_type find(basic_string_view needle, size_type pos = 0) const noexcept;
+    private:
+        pointer m_data;
+        size_type m_size;
+    };
+
+    using string_view = basic_string_view<char>;
+    using u16string_view = basic_string_view<char16_t>;
+    using wstring_view = basic_string_view<wchar_t>;
+
+    /// Extern operators
+    template<class CharT>
+    constexpr bool operator==(basic_string_view<CharT> lhs, type_identity_t<basic_string_view<CharT>> rhs) noexcept;
+
+    // Vectorized search behind find(basic_string_view) at run time, see searcher.hpp.
+    size_t find_substring(string_view haystack, string_view needle, size_t from) noexcept;
+
+
+    // Functions
+    template<class CharT>
+    constexpr size_t string_length(const CharT* str) noexcept
+    {
+        size_t length = 0;
+        while (str[length] != CharT())
+            ++length;
+        return length;
+    }
+
+    template<class CharT>
+    constexpr int compare_chars(const CharT* lhs, const CharT* rhs, size_t count) noexcept
+    {
+        if constexpr (sizeof(CharT) == 1)
+        {
+            return __builtin_memcmp(lhs, rhs, count);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (lhs[i] != rhs[i])
+                    return lhs[i] < rhs[i] ? -1 : 1;
+            }
+            return 0;
+        }
+    }
+
+    // Constructors implementations
+    template<class CharT>
+    constexpr basic_string_view<CharT>::basic_string_view() noexcept : m_data(nullptr), m_size(0)
+    {
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::basic_string_view(const CharT* str, size_type count) noexcept : m_data(str), m_size(count)
+    {
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::basic_string_view(const CharT* str) noexcept : m_data(str), m_size(string_length(str))
+    {
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::basic_string_view(const CharT* first, const CharT* last) noexcept
+        : m_data(first), m_size(static_cast<size_type>(last - first))
+    {
+    }
+
+    // Operators
+    template<class CharT>
+    constexpr basic_string_view<CharT>::const_reference basic_string_view<CharT>::operator[](size_type pos) const
+    {
+        return m_data[pos];
+    }
+
+    // Member functions
+    template<class CharT>
+    constexpr basic_string_view<CharT>::const_iterator basic_string_view<CharT>::begin() const noexcept
+    {
+        return m_data;
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::const_iterator basic_string_view<CharT>::end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::const_reference basic_string_view<CharT>::front() const
+    {
+        return m_data[0];
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::const_reference basic_string_view<CharT>::back() const
+    {
+        return m_data[m_size - 1];
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::pointer basic_string_view<CharT>::data() const noexcept
+    {
+        return m_data;
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::size_type basic_string_view<CharT>::size() const noexcept
+    {
+        return m_size;
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::size_type basic_string_view<CharT>::length() const noexcept
+    {
+        return m_size;
+    }
+
+    template<class CharT>
+    constexpr bool basic_string_view<CharT>::empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    template<class CharT>
+    constexpr void basic_string_view<CharT>::remove_prefix(size_type count)
+    {
+        m_data += count;
+        m_size -= count;
+    }
+
+    template<class CharT>
+    constexpr void basic_string_view<CharT>::remove_suffix(size_type count)
+    {
+        m_size -= count;
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT> basic_string_view<CharT>::substr(size_type pos, size_type count) const
+    {
+        const size_type available = m_size - pos;
+        return basic_string_view(m_data + pos, count < available ? count : available);
+    }
+
+    template<class CharT>
+    constexpr int basic_string_view<CharT>::compare(basic_string_view other) const noexcept
+    {
+        const size_type common = m_size < other.m_size ? m_size : other.m_size;
+        const int result = common ? compare_chars(m_data, other.m_data, common) : 0;
+
+        if (result != 0)
+            return result;
+
+        return m_size == other.m_size ? 0 : (m_size < other.m_size ? -1 : 1);
+    }
+
+    template<class CharT>
+    constexpr bool basic_string_view<CharT>::starts_with(basic_string_view prefix) const noexcept
+    {
+        return m_size >= prefix.m_size && substr(0, prefix.m_size) == prefix;
+    }
+
+    template<class CharT>
+    constexpr bool basic_string_view<CharT>::ends_with(basic_string_view suffix) const noexcept
+    {
+        return m_size >= suffix.m_size && substr(m_size - suffix.m_size) == suffix;
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::size_type basic_string_view<CharT>::find(CharT ch, size_type pos) const noexcept
+    {
+        for (size_type i = pos; i < m_size; ++i)
+        {
+            if (m_data[i] == ch)
+                return i;
+        }
+        return npos;
+    }
+
+    template<class CharT>
+    constexpr basic_string_view<CharT>::size_type basic_string_view<CharT>::find(basic_string_view needle, size_type pos) const noexcept
+    {
+        if constexpr (sizeof(CharT) == 1)
+        {
+            if (!__builtin_is_constant_evaluated())
+                return find_substring(string_view(reinterpret_cast<const char*>(m_data), m_size), string_view(reinterpret_cast<const char*>(needle.m_data), needle.m_size), pos);
+        }
+
+        if (pos > m_size || needle.m_size > m_size - pos)
+            return npos;
+
+        for (size_type i = pos; i + needle.m_size <= m_size; ++i)
+        {
+            if (needle.m_size == 0 || compare_chars(m_data + i, needle.m_data, needle.m_size) == 0)
+                return i;
+        }
+        return npos;
+    }
+
+    /// Extern operators
+    template<class CharT>
+    constexpr bool operator==(basic_string_view<CharT> lhs, type_identity_t<basic_string_view<CharT>> rhs) noexcept
+    {
+        return lhs.size() == rhs.size() && (lhs.empty() || compare_chars(lhs.data(), rhs.data(), lhs.size()) == 0);
+    }
+}
+
+
+#endif //STL_STRING_VIEW_HPP
@@ -0,0 +1,281 @@
+#ifndef STL_TASK_HPP
+#define STL_TASK_HPP
+
+
+#include "coroutine.hpp"
+#include "new.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+namespace std
+{
+    template<class T = void>
+    class task;
+
+    namespace detail
+    {
+        // Result storage of the task promise, the value is only constructed by co_return.
+        template<class T>
+        class task_result
+        {
+        public:
+            /// Constructors
+            task_result() noexcept;
+            task_result(const task_result&) = delete;
+
+            /// Destructor
+            ~task_result();
+
+            /// Member functions
+            template<class U>
+            void return_value(U&& value);
+
+            T& value() noexcept;
+        private:
+            union
+            {
+                T m_value;
+            };
+            bool m_has_value;
+        };
+
+        template<>
+        class task_result<void>
+        {
+        public:
+            /// Member functions
+            void return_void() noexcept;
+            void value() noexcept;
+        };
+    }
+
+    // Lazily started coroutine: the body only runs once the task is co_awaited (or resumed by a
+    // driver), and finishing it resumes the awaiter through symmetric transfer, so chains of
+    // awaited tasks run in constant stack space.
+    template<class T>
+    class task
+    {
+    public:
+        class promise_type : public detail::promise_allocator, public detail::task_result<T>
+        {
+        public:
+            /// Member functions
+            task get_return_object() noexcept;
+            suspend_always initial_suspend() const noexcept;
+            auto final_suspend() const noexcept;
+            void unhandled_exception() const;
+
+        private:
+            friend class task;
+
+            coroutine_handle<> m_continuation;
+        };
+
+        /// Constructors
+        task() noexcept;
+        task(const task&) = delete;
+        task(task&& other) noexcept;
+
+        /// Destructor
+        ~task();
+
+        /// Operators
+        task& operator=(const task&) = delete;
+        task& operator=(task&& other) noexcept;
+
+        auto operator co_await() && noexcept;
+
+        /// Member functions
+        // Drivers for a top-level task (an I/O loop or the entry point), awaiting tasks never need them.
+        bool done() const noexcept;
+        void resume() const;
+        add_lvalue_reference_t<T> result();
+    private:
+        explicit task(coroutine_handle<promise_type> handle) noexcept;
+
+        coroutine_handle<promise_type> m_handle;
+    };
+
+
+    // task_result
+    namespace detail
+    {
+        template<class T>
+        task_result<T>::task_result() noexcept : m_has_value(false)
+        {
+        }
+
+        template<class T>
+        task_result<T>::~task_result()
+        {
+            if (m_has_value)
+                m_value.~T();
+        }
+
+        template<class T>
+        template<class U>
+        void task_result<T>::return_value(U&& value)
+        {
+            ::new (static_cast<void*>(&m_value)) T(forward<U>(value));
+            m_has_value = true;
+        }
+
+        template<class T>
+        T& task_result<T>::value() noexcept
+        {
+            return m_value;
+        }
+
+        inline void task_result<void>::return_void() noexcept
+        {
+        }
+
+        inline void task_result<void>::value() noexcept
+        {
+        }
+    }
+
+
+    // task::promise_type
+    template<class T>
+    task<T> task<T>::promise_type::get_return_object() noexcept
+    {
+        return task(coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    template<class T>
+    suspend_always task<T>::promise_type::initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    template<class T>
+    auto task<T>::promise_type::final_suspend() const noexcept
+    {
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            // Symmetric transfer: the awaiter is resumed as a tail call instead of a nested resume().
+            coroutine_handle<> await_suspend(coroutine_handle<promise_type> handle) const noexcept
+            {
+                coroutine_handle<> continuation = handle.promise().m_continuation;
+                return continuation ? continuation : coroutine_handle<>(noop_coroutine());
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+        };
+
+        return final_awaiter{};
+    }
+
+    template<class T>
+    void task<T>::promise_type::unhandled_exception() const
+    {
+#if defined(__cpp_exceptions)
+        throw;
+#else
+        __builtin_trap();
+#endif
+    }
+
+
+    // task
+    // Constructors implementations
+    template<class T>
+    task<T>::task() noexcept : m_handle(nullptr)
+    {
+    }
+
+    template<class T>
+    task<T>::task(coroutine_handle<promise_type> handle) noexcept : m_handle(handle)
+    {
+    }
+
+    template<class T>
+    task<T>::task(task&& other) noexcept : m_handle(other.m_handle)
+    {
+        other.m_handle = nullptr;
+    }
+
+    // Destructor
+    template<class T>
+    task<T>::~task()
+    {
+        // Destroying the frame in the owner's destructor is what lets Clang bound the frame's
+        // lifetime to the caller and elide its allocation.
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    // Operators
+    template<class T>
+    task<T>& task<T>::operator=(task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_handle)
+                m_handle.destroy();
+
+            m_handle = other.m_handle;
+            other.m_handle = nullptr;
+        }
+
+        return *this;
+    }
+
+    template<class T>
+    auto task<T>::operator co_await() && noexcept
+    {
+        struct awaiter
+        {
+            coroutine_handle<promise_type> m_handle;
+
+            bool await_ready() const noexcept
+            {
+                return !m_handle || m_handle.done();
+            }
+
+            coroutine_handle<> await_suspend(coroutine_handle<> awaiting) const noexcept
+            {
+                m_handle.promise().m_continuation = awaiting;
+                return m_handle;
+            }
+
+            T await_resume() const
+            {
+                if constexpr (!is_same_v<T, void>)
+                    return move(m_handle.promise().value());
+            }
+        };
+
+        return awaiter{ m_handle };
+    }
+
+    // Member functions
+    template<class T>
+    bool task<T>::done() const noexcept
+    {
+        return !m_handle || m_handle.done();
+    }
+
+    template<class T>
+    void task<T>::resume() const
+    {
+        m_handle.resume();
+    }
+
+    template<class T>
+    add_lvalue_reference_t<T> task<T>::result()
+    {
+        return m_handle.promise().value();
+    }
+}
+
+
+#endif //STL_TASK_HPP
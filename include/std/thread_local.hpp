@@ -0,0 +1,16 @@
+#ifndef STL_THREAD_LOCAL_HPP
+#define STL_THREAD_LOCAL_HPP
+
+
+// Storage class of the per-thread state (thread indices, profiler and trace slots).
+// Host builds use real TLS. The firmware target (x86_64-unknown-windows) has no TLS runtime: no
+// _tls_index and no TEB to find it through. It also runs everything on the boot processor, since
+// the boot services are not MP-safe, so there the state is plain static storage.
+#if defined(__linux__)
+#define STL_THREAD_LOCAL thread_local
+#else
+#define STL_THREAD_LOCAL
+#endif
+
+
+#endif //STL_THREAD_LOCAL_HPP
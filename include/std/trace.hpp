@@ -0,0 +1,148 @@
+#ifndef STL_TRACE_HPP
+#define STL_TRACE_HPP
+
+
+// Scoped timing zones recorded into per-thread rings and exported as Chrome trace events.
+// Build with -DSTL_TRACING=1 to enable it. When disabled (the default) STL_TRACE_ZONE expands to
+// nothing and none of the tracer's code or storage is compiled in. STL_TRACE_CATEGORIES narrows
+// an enabled build to a mask of trace_category bits: zones of the other categories compile to
+// nothing as well.
+//
+// The library records boot zones around run_static_constructors and seal_ro_after_init, and
+// memory zones in make_unique, make_unique_for_overwrite, unique_ptr::reset and default_delete.
+#ifndef STL_TRACING
+#define STL_TRACING 0
+#endif
+
+#ifndef STL_TRACE_CATEGORIES
+#define STL_TRACE_CATEGORIES 0xFFFFFFFFu
+#endif
+
+#if STL_TRACING
+
+#include "cstddef.hpp"
+#include "cstdint.hpp"
+#include "span.hpp"
+#include "string_view.hpp"
+
+namespace std
+{
+    enum class trace_category : uint32_t
+    {
+        boot = 1u << 0,
+        memory = 1u << 1,
+        io = 1u << 2,
+        parser = 1u << 3,
+        user = 1u << 4
+    };
+
+    struct trace_event
+    {
+        const char* name;           // the zone's string literal
+        uint64_t begin;             // timestamp counter (TSC cycles on x86)
+        uint64_t end;
+        trace_category category;
+        uint32_t thread;            // index of the thread's ring
+    };
+
+    constexpr bool trace_enabled(trace_category category) noexcept
+    {
+        return (static_cast<uint32_t>(category) & (STL_TRACE_CATEGORIES)) != 0;
+    }
+
+    // Times its own lifetime. Recording takes two timestamp reads and one store into the
+    // calling thread's ring, with no lock and no atomic read-modify-write. A zone of a category
+    // left out of STL_TRACE_CATEGORIES is an empty type that does nothing.
+    template<trace_category Category, bool Enabled = trace_enabled(Category)>
+    class trace_zone
+    {
+    public:
+        /// Constructors
+        explicit trace_zone(const char* name) noexcept;
+        trace_zone(const trace_zone&) = delete;
+
+        /// Destructor
+        ~trace_zone();
+
+        /// Operators
+        trace_zone& operator=(const trace_zone&) = delete;
+    private:
+        const char* m_name;
+        uint64_t m_begin;
+    };
+
+    template<trace_category Category>
+    class trace_zone<Category, false>
+    {
+    public:
+        /// Constructors
+        explicit trace_zone(const char*) noexcept
+        {
+        }
+        trace_zone(const trace_zone&) = delete;
+
+        /// Operators
+        trace_zone& operator=(const trace_zone&) = delete;
+    };
+
+    // Copies the recorded events of every thread into output and returns the number written.
+    // dropped receives the number of events lost: overwritten in a full ring, or recorded by a
+    // thread beyond the ring count. Meant to be called once the traced threads are quiescent;
+    // events overwritten while they are being copied are left out.
+    size_t trace_collect(span<trace_event> output, uint64_t* dropped = nullptr) noexcept;
+
+    // Writes every recorded event as Chrome trace-event JSON (chrome://tracing, Perfetto), one
+    // chunk per event. Timestamps are converted with ticks_per_microsecond and start at the
+    // earliest event. The sink writes a file on a host, a serial port or a buffer on firmware.
+    void trace_export_chrome(void (*sink)(string_view chunk), uint64_t ticks_per_microsecond) noexcept;
+
+    void trace_reset() noexcept;
+
+    namespace detail
+    {
+        inline uint64_t trace_timestamp() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+            uint64_t value;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+            return value;
+#else
+            return 0;
+#endif
+        }
+
+        void trace_record(const char* name, trace_category category, uint64_t begin, uint64_t end) noexcept;
+    }
+
+
+    // trace_zone
+    // Constructors implementations
+    template<trace_category Category, bool Enabled>
+    trace_zone<Category, Enabled>::trace_zone(const char* name) noexcept : m_name(name), m_begin(detail::trace_timestamp())
+    {
+    }
+
+    // Destructor implementation
+    template<trace_category Category, bool Enabled>
+    trace_zone<Category, Enabled>::~trace_zone()
+    {
+        detail::trace_record(m_name, Category, m_begin, detail::trace_timestamp());
+    }
+}
+
+#define STL_TRACE_CONCAT_IMPL(a, b) a##b
+#define STL_TRACE_CONCAT(a, b) STL_TRACE_CONCAT_IMPL(a, b)
+// Times the rest of the enclosing scope: STL_TRACE_ZONE(boot, "load configuration");
+#define STL_TRACE_ZONE(category, name) \
+    ::std::trace_zone<::std::trace_category::category> STL_TRACE_CONCAT(stl_trace_zone_, __COUNTER__)(name)
+
+#else
+
+#define STL_TRACE_ZONE(category, name) ((void)0)
+
+#endif
+
+
+#endif //STL_TRACE_HPP
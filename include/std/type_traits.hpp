@@ -220,11 +220,8 @@ namespace std
 
 
     // is_nothrow_assignable
-    template<class T, class U, typename = void>
-    struct is_nothrow_assignable : false_type {};
-
     template<class T, class U>
-    struct is_nothrow_assignable<T, U, decltype(noexcept(declval<T>() = declval<U>()) ? declval<T>() = declval<U>() : void(), void())> : true_type {};
+    struct is_nothrow_assignable : bool_constant<requires { { declval<T>() = declval<U>() } noexcept; }> {};
 
     template<typename T, typename U>
     inline constexpr bool is_nothrow_assignable_v = is_nothrow_assignable<T, U>::value;
@@ -238,6 +235,26 @@ namespace std
     inline constexpr bool is_copy_assignable_v = is_copy_assignable<T>::value;
 
 
+    // is_trivially_copyable
+    template<class T>
+    struct is_trivially_copyable : bool_constant<__is_trivially_copyable(T)> {};
+
+    template<class T>
+    inline constexpr bool is_trivially_copyable_v = is_trivially_copyable<T>::value;
+
+
+    // is_trivially_destructible
+    template<class T>
+#if __has_builtin(__is_trivially_destructible)
+    struct is_trivially_destructible : bool_constant<__is_trivially_destructible(T)> {};
+#else
+    struct is_trivially_destructible : bool_constant<__has_trivial_destructor(T)> {};
+#endif
+
+    template<class T>
+    inline constexpr bool is_trivially_destructible_v = is_trivially_destructible<T>::value;
+
+
     // is_trivially_copy_assignable
     template<class T>
     struct is_trivially_copy_assignable : is_trivially_assignable<add_lvalue_reference<T>, add_lvalue_reference<const T>> {};
@@ -287,11 +304,8 @@ namespace std
 
 
     // is_nothrow_constructible
-    template<class T, typename = void, class... Args>
-    struct is_nothrow_constructible : false_type {};
-
     template<class T, class... Args>
-    struct is_nothrow_constructible<T, decltype(noexcept(T{ declval<Args>()... }) ? T{ declval<Args>()... } : void(), void()), Args...> : true_type {};
+    struct is_nothrow_constructible : bool_constant<requires { { T{ declval<Args>()... } } noexcept; }> {};
 
     template<class T, class... Args>
     inline constexpr bool is_nothrow_constructible_v = is_nothrow_constructible<T, Args...>::value;
@@ -413,6 +427,160 @@ namespace std
 
     template<Referenceable T>
     inline constexpr bool is_nothrow_swappable_v = is_nothrow_swappable<T>::type::value;
+
+
+    // remove_cv / remove_cvref
+    template<class T> struct remove_cv { using type = T; };
+    template<class T> struct remove_cv<const T> { using type = T; };
+    template<class T> struct remove_cv<volatile T> { using type = T; };
+    template<class T> struct remove_cv<const volatile T> { using type = T; };
+
+    template<class T>
+    using remove_cv_t = remove_cv<T>::type;
+
+    template<class T>
+    struct remove_cvref { using type = remove_cv_t<remove_reference_t<T>>; };
+
+    template<class T>
+    using remove_cvref_t = remove_cvref<T>::type;
+
+
+    // conditional
+    template<bool B, class T, class F>
+    struct conditional { using type = T; };
+
+    template<class T, class F>
+    struct conditional<false, T, F> { using type = F; };
+
+    template<bool B, class T, class F>
+    using conditional_t = conditional<B, T, F>::type;
+
+
+    // is_const / is_void / is_function / is_object
+    template<class T> struct is_const : false_type {};
+    template<class T> struct is_const<const T> : true_type {};
+
+    template<class T>
+    inline constexpr bool is_const_v = is_const<T>::value;
+
+    template<class T>
+    struct is_void : is_same<remove_cv_t<T>, void> {};
+
+    template<class T>
+    inline constexpr bool is_void_v = is_void<T>::value;
+
+    // Only function types and references cannot be const qualified.
+    template<class T>
+    struct is_function : bool_constant<!is_const_v<const T> && !is_reference<T>> {};
+
+    template<class T>
+    inline constexpr bool is_function_v = is_function<T>::value;
+
+    template<class T>
+    struct is_object : bool_constant<!is_function_v<T> && !is_reference<T> && !is_void_v<T>> {};
+
+    template<class T>
+    inline constexpr bool is_object_v = is_object<T>::value;
+
+
+    // is_integral / is_signed
+    namespace detail
+    {
+        template<class T> struct is_integral_base : false_type {};
+        template<> struct is_integral_base<bool> : true_type {};
+        template<> struct is_integral_base<char> : true_type {};
+        template<> struct is_integral_base<signed char> : true_type {};
+        template<> struct is_integral_base<unsigned char> : true_type {};
+        template<> struct is_integral_base<wchar_t> : true_type {};
+        template<> struct is_integral_base<char8_t> : true_type {};
+        template<> struct is_integral_base<char16_t> : true_type {};
+        template<> struct is_integral_base<char32_t> : true_type {};
+        template<> struct is_integral_base<short> : true_type {};
+        template<> struct is_integral_base<unsigned short> : true_type {};
+        template<> struct is_integral_base<int> : true_type {};
+        template<> struct is_integral_base<unsigned int> : true_type {};
+        template<> struct is_integral_base<long> : true_type {};
+        template<> struct is_integral_base<unsigned long> : true_type {};
+        template<> struct is_integral_base<long long> : true_type {};
+        template<> struct is_integral_base<unsigned long long> : true_type {};
+    }
+
+    template<class T>
+    struct is_integral : detail::is_integral_base<remove_cv_t<T>> {};
+
+    template<class T>
+    inline constexpr bool is_integral_v = is_integral<T>::value;
+
+    template<class T>
+    struct is_signed : false_type {};
+
+    template<class T> requires is_integral_v<T>
+    struct is_signed<T> : bool_constant<T(-1) < T(0)> {};
+
+    template<class T>
+    inline constexpr bool is_signed_v = is_signed<T>::value;
+
+
+    // is_floating_point / is_arithmetic
+    template<class T>
+    struct is_floating_point : bool_constant<is_same_v<remove_cv_t<T>, float> || is_same_v<remove_cv_t<T>, double>
+                                             || is_same_v<remove_cv_t<T>, long double>> {};
+
+    template<class T>
+    inline constexpr bool is_floating_point_v = is_floating_point<T>::value;
+
+    template<class T>
+    struct is_arithmetic : bool_constant<is_integral_v<T> || is_floating_point_v<T>> {};
+
+    template<class T>
+    inline constexpr bool is_arithmetic_v = is_arithmetic<T>::value;
+
+
+    // is_enum
+    template<class T>
+    struct is_enum : bool_constant<__is_enum(T)> {};
+
+    template<class T>
+    inline constexpr bool is_enum_v = is_enum<T>::value;
+
+
+    // is_base_of
+    template<class Base, class Derived>
+    struct is_base_of : bool_constant<__is_base_of(Base, Derived)> {};
+
+    template<class Base, class Derived>
+    inline constexpr bool is_base_of_v = is_base_of<Base, Derived>::value;
+
+
+    // decay
+    namespace detail
+    {
+        template<class U, bool Array = is_array_v<U>, bool Function = is_function_v<U>>
+        struct decay_selector { using type = remove_cv_t<U>; };
+
+        template<class U>
+        struct decay_selector<U, true, false> { using type = remove_reference_t<decltype(declval<U&>()[0])>*; };
+
+        template<class U>
+        struct decay_selector<U, false, true> { using type = U*; };
+    }
+
+    template<class T>
+    struct decay { using type = detail::decay_selector<remove_reference_t<T>>::type; };
+
+    template<class T>
+    using decay_t = decay<T>::type;
+
+
+    // invoke_result (call expressions only, pointers to members are not supported)
+    template<class F, class... Args>
+    struct invoke_result {};
+
+    template<class F, class... Args> requires requires { declval<F>()(declval<Args>()...); }
+    struct invoke_result<F, Args...> { using type = decltype(declval<F>()(declval<Args>()...)); };
+
+    template<class F, class... Args>
+    using invoke_result_t = invoke_result<F, Args...>::type;
 }
 
 
@@ -0,0 +1,47 @@
+#ifndef STL_UTF_HPP
+#define STL_UTF_HPP
+
+
+#include "cstddef.hpp"
+#include "span.hpp"
+
+namespace std
+{
+    enum class utf_status
+    {
+        ok,
+        invalid_sequence,
+        output_too_small
+    };
+
+    // read is the number of input code units consumed: on failure it points at the first unit of
+    // the offending sequence. written is the number of output code units stored.
+    struct utf_result
+    {
+        utf_status status;
+        size_t read;
+        size_t written;
+    };
+
+    // Strict validation: overlong forms, surrogates, code points above U+10FFFF and truncated
+    // sequences are all rejected.
+    // Runs 32 bytes at a time with AVX2, skips ASCII 16 bytes at a time with SSE2, scalar otherwise.
+    bool utf8_validate(span<const char> input) noexcept;
+
+    // Output sizes needed to transcode a valid input, so callers can size their buffers.
+    size_t utf16_length_from_utf8(span<const char> input) noexcept;
+    size_t utf8_length_from_utf16(span<const char16_t> input) noexcept;
+
+    // Both converters validate their input and never write past the output span.
+    utf_result utf8_to_utf16(span<const char> input, span<char16_t> output) noexcept;
+    utf_result utf16_to_utf8(span<const char16_t> input, span<char> output) noexcept;
+
+#if __WCHAR_MAX__ == 0xFFFF
+    // wchar_t is UTF-16 on the firmware target (-fshort-wchar), matching UEFI CHAR16 strings.
+    utf_result utf8_to_utf16(span<const char> input, span<wchar_t> output) noexcept;
+    utf_result utf16_to_utf8(span<const wchar_t> input, span<char> output) noexcept;
+#endif
+}
+
+
+#endif //STL_UTF_HPP
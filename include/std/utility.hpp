@@ -7,19 +7,63 @@
 namespace std
 {
     template<class T>
-    remove_reference_t<T>&& move(T&& var) noexcept;
+    remove_reference_t<T>&& move(T&& var) noexcept
+    {
+        return static_cast<remove_reference_t<T>&&>(var);
+    }
 
     template<class T>
-    add_rvalue_reference_t<T> declval() noexcept;
+    add_rvalue_reference_t<T> declval() noexcept
+    {
+        static_assert(always_false<T>, "declval not allowed in an evaluated context");
+    }
 
     template<class T>
-    constexpr T&& forward(remove_reference_t<T>& t) noexcept;
+    constexpr T&& forward(remove_reference_t<T>& t) noexcept
+    {
+        return static_cast<T&&>(t);
+    }
 
     template<class T>
-    constexpr T&& forward(remove_reference_t<T>&& t) noexcept;
+    constexpr T&& forward(remove_reference_t<T>&& t) noexcept
+    {
+        return static_cast<T&&>(t);
+    }
 
     template<class T>
-    constexpr void swap(T& a, T& b) noexcept(is_nothrow_move_constructible_v<T> && is_nothrow_move_assignable_v<T>);
+    constexpr void swap(T& a, T& b) noexcept(is_nothrow_move_constructible_v<T> && is_nothrow_move_assignable_v<T>)
+    {
+        T temporary = move(a);
+        a = move(b);
+        b = move(temporary);
+    }
+
+
+    // Compile-time integer sequences
+    template<class T, T... Values>
+    struct integer_sequence
+    {
+        using value_type = T;
+
+        static constexpr size_t size() noexcept { return sizeof...(Values); }
+    };
+
+    template<size_t... Values>
+    using index_sequence = integer_sequence<size_t, Values...>;
+
+#if __has_builtin(__make_integer_seq)
+    template<class T, T N>
+    using make_integer_sequence = __make_integer_seq<integer_sequence, T, N>;
+#else
+    template<class T, T N>
+    using make_integer_sequence = integer_sequence<T, __integer_pack(N)...>;
+#endif
+
+    template<size_t N>
+    using make_index_sequence = make_integer_sequence<size_t, N>;
+
+    template<class... T>
+    using index_sequence_for = make_index_sequence<sizeof...(T)>;
 }
 
 
@@ -1,8 +1,10 @@
-#include "std/string.hpp"
+#include "std/intern_pool.hpp"
+#include "std/startup.hpp"
 
-extern "C" int _start() {
-  std::string test { "Hello World!" };
-  test.at(3);
-  test.size();
-  return 0;
+extern "C" STL_STARTUP int _start() {
+  std::run_static_constructors();
+
+  std::intern_pool names;
+  const std::atom test = names.intern("Hello World!");
+  return names.view(test).empty() ? 1 : 0;
 }
@@ -0,0 +1,326 @@
+#include "alloc_profile.hpp"
+#include "section.hpp"
+#include "thread_local.hpp"
+
+#if STL_ALLOC_PROFILING
+
+
+namespace std
+{
+    namespace detail
+    {
+        inline constexpr size_t alloc_profile_live_capacity = 4096; // power of two
+        inline constexpr uint32_t alloc_profile_no_site = static_cast<uint32_t>(-1);
+
+        struct alloc_live_entry
+        {
+            const void* pointer;
+            uint32_t site_index;
+            uint64_t timestamp;
+        };
+
+        // Open-addressing tables owned by a single thread: the hot path takes no lock and issues
+        // no atomic operation, only claiming a profile slot does.
+        struct alloc_thread_profile
+        {
+            alloc_site_stats sites[alloc_profile_site_capacity];
+            alloc_live_entry live[alloc_profile_live_capacity];
+            alloc_profile_totals totals;
+        };
+
+        alloc_thread_profile alloc_profiles[alloc_profile_max_threads];
+        uint32_t alloc_profile_claimed = 0;
+
+        STL_THREAD_LOCAL alloc_thread_profile* alloc_current_profile = nullptr;
+        STL_THREAD_LOCAL bool alloc_profile_exhausted = false;
+
+        uint64_t alloc_timestamp() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            return __builtin_ia32_rdtsc();
+#else
+            return 0;
+#endif
+        }
+
+        size_t alloc_hash(const void* pointer, size_t capacity) noexcept
+        {
+            const uint64_t key = reinterpret_cast<uintptr_t>(pointer) >> 4;
+            return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+        }
+
+        alloc_thread_profile* alloc_profile_for_thread() noexcept
+        {
+            if (alloc_current_profile || alloc_profile_exhausted)
+                return alloc_current_profile;
+
+            const uint32_t slot = __atomic_fetch_add(&alloc_profile_claimed, 1, __ATOMIC_ACQ_REL);
+            if (slot >= alloc_profile_max_threads)
+            {
+                alloc_profile_exhausted = true;
+                return nullptr;
+            }
+
+            alloc_current_profile = &alloc_profiles[slot];
+            return alloc_current_profile;
+        }
+
+        uint32_t alloc_profile_threads() noexcept
+        {
+            const uint32_t claimed = __atomic_load_n(&alloc_profile_claimed, __ATOMIC_ACQUIRE);
+            return claimed < alloc_profile_max_threads ? claimed : alloc_profile_max_threads;
+        }
+
+        uint32_t alloc_find_site(alloc_thread_profile& profile, const void* site) noexcept
+        {
+            size_t index = alloc_hash(site, alloc_profile_site_capacity);
+
+            for (size_t probe = 0; probe < alloc_profile_site_capacity; ++probe)
+            {
+                alloc_site_stats& stats = profile.sites[index];
+
+                if (stats.site == site)
+                    return static_cast<uint32_t>(index);
+
+                if (!stats.site)
+                {
+                    stats = { site, 0, 0, 0, 0 };
+                    return static_cast<uint32_t>(index);
+                }
+
+                index = (index + 1) & (alloc_profile_site_capacity - 1);
+            }
+
+            return alloc_profile_no_site;
+        }
+
+        size_t alloc_find_live(const alloc_thread_profile& profile, const void* pointer) noexcept
+        {
+            size_t index = alloc_hash(pointer, alloc_profile_live_capacity);
+
+            for (size_t probe = 0; probe < alloc_profile_live_capacity; ++probe)
+            {
+                const void* current = profile.live[index].pointer;
+
+                if (current == pointer || !current)
+                    return index;
+
+                index = (index + 1) & (alloc_profile_live_capacity - 1);
+            }
+
+            return alloc_profile_live_capacity;
+        }
+
+        // Backward-shift deletion keeps the probe sequences intact without tombstones.
+        void alloc_erase_live(alloc_thread_profile& profile, size_t hole) noexcept
+        {
+            constexpr size_t mask = alloc_profile_live_capacity - 1;
+            size_t next = hole;
+
+            for (size_t probe = 1; probe < alloc_profile_live_capacity; ++probe)
+            {
+                next = (next + 1) & mask;
+                if (!profile.live[next].pointer)
+                    break;
+
+                const size_t home = alloc_hash(profile.live[next].pointer, alloc_profile_live_capacity);
+                const bool stays = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+                if (stays)
+                    continue;
+
+                profile.live[hole] = profile.live[next];
+                hole = next;
+            }
+
+            profile.live[hole].pointer = nullptr;
+        }
+
+        void alloc_profile_on_allocate(const void* pointer, size_t size, const void* site) noexcept
+        {
+            alloc_thread_profile* profile = alloc_profile_for_thread();
+            if (!profile || !pointer)
+                return;
+
+            const uint32_t site_index = alloc_find_site(*profile, site);
+            const size_t slot = alloc_find_live(*profile, pointer);
+
+            if (site_index == alloc_profile_no_site || slot == alloc_profile_live_capacity)
+            {
+                ++profile->totals.untracked_allocations;
+                return;
+            }
+
+            alloc_site_stats& stats = profile->sites[site_index];
+            ++stats.allocations;
+            ++stats.live;
+            stats.bytes += size;
+
+            profile->live[slot] = { pointer, site_index, alloc_timestamp() };
+        }
+
+        void alloc_profile_on_deallocate(const void* pointer) noexcept
+        {
+            alloc_thread_profile* profile = alloc_profile_for_thread();
+            if (!profile || !pointer)
+                return;
+
+            const size_t slot = alloc_find_live(*profile, pointer);
+            if (slot == alloc_profile_live_capacity || !profile->live[slot].pointer)
+            {
+                ++profile->totals.unmatched_deallocations;
+                return;
+            }
+
+            const alloc_live_entry& entry = profile->live[slot];
+            alloc_site_stats& stats = profile->sites[entry.site_index];
+            --stats.live;
+            stats.lifetime_cycles += alloc_timestamp() - entry.timestamp;
+
+            alloc_erase_live(*profile, slot);
+        }
+
+        // Text output, the library has no formatting facility yet.
+        class alloc_line_writer
+        {
+        public:
+            void text(string_view value) noexcept
+            {
+                for (size_t i = 0; i < value.size() && m_size < sizeof(m_buffer); ++i)
+                    m_buffer[m_size++] = value[i];
+            }
+
+            void decimal(uint64_t value) noexcept
+            {
+                char digits[20];
+                size_t count = 0;
+
+                do
+                {
+                    digits[count++] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while (value);
+
+                while (count)
+                    text(string_view(&digits[--count], 1));
+            }
+
+            void hexadecimal(uint64_t value) noexcept
+            {
+                text("0x");
+                for (int shift = 60; shift >= 0; shift -= 4)
+                    text(string_view(&"0123456789abcdef"[(value >> shift) & 0xF], 1));
+            }
+
+            string_view line() const noexcept
+            {
+                return string_view(m_buffer, m_size);
+            }
+        private:
+            char m_buffer[160];
+            size_t m_size = 0;
+        };
+    }
+
+
+    STL_COLD size_t alloc_profile_summary(span<alloc_site_stats> output, alloc_profile_totals* totals) noexcept
+    {
+        size_t count = 0;
+        alloc_profile_totals merged_totals{ 0, 0, 0 };
+
+        for (uint32_t thread = 0; thread < detail::alloc_profile_threads(); ++thread)
+        {
+            const detail::alloc_thread_profile& profile = detail::alloc_profiles[thread];
+            merged_totals.untracked_allocations += profile.totals.untracked_allocations;
+            merged_totals.unmatched_deallocations += profile.totals.unmatched_deallocations;
+
+            for (const alloc_site_stats& stats : profile.sites)
+            {
+                if (!stats.site)
+                    continue;
+
+                size_t index = 0;
+                while (index < count && output[index].site != stats.site)
+                    ++index;
+
+                if (index == count)
+                {
+                    if (count == output.size())
+                    {
+                        ++merged_totals.dropped_sites;
+                        continue;
+                    }
+
+                    output[count++] = { stats.site, 0, 0, 0, 0 };
+                }
+
+                output[index].allocations += stats.allocations;
+                output[index].bytes += stats.bytes;
+                output[index].live += stats.live;
+                output[index].lifetime_cycles += stats.lifetime_cycles;
+            }
+        }
+
+        // Insertion sort: a few hundred sites at most, and it runs off the hot path.
+        for (size_t i = 1; i < count; ++i)
+        {
+            const alloc_site_stats current = output[i];
+            size_t j = i;
+
+            for (; j > 0 && output[j - 1].bytes < current.bytes; --j)
+                output[j] = output[j - 1];
+
+            output[j] = current;
+        }
+
+        if (totals)
+            *totals = merged_totals;
+
+        return count;
+    }
+
+    STL_COLD void alloc_profile_dump(void (*sink)(string_view line), span<alloc_site_stats> scratch) noexcept
+    {
+        alloc_profile_totals totals;
+        const size_t count = alloc_profile_summary(scratch, &totals);
+
+        detail::alloc_line_writer header;
+        header.text("alloc profile: ");
+        header.decimal(count);
+        header.text(" sites, ");
+        header.decimal(totals.untracked_allocations);
+        header.text(" untracked allocations, ");
+        header.decimal(totals.unmatched_deallocations);
+        header.text(" unmatched deallocations, ");
+        header.decimal(totals.dropped_sites);
+        header.text(" dropped sites");
+        sink(header.line());
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const alloc_site_stats& stats = scratch[i];
+            const uint64_t released = stats.allocations - stats.live;
+
+            detail::alloc_line_writer line;
+            line.text("  site ");
+            line.hexadecimal(reinterpret_cast<uintptr_t>(stats.site));
+            line.text("  allocs ");
+            line.decimal(stats.allocations);
+            line.text("  bytes ");
+            line.decimal(stats.bytes);
+            line.text("  live ");
+            line.decimal(stats.live);
+            line.text("  avg lifetime ");
+            line.decimal(released ? stats.lifetime_cycles / released : 0);
+            line.text(" cycles");
+            sink(line.line());
+        }
+    }
+
+    STL_COLD void alloc_profile_reset() noexcept
+    {
+        for (uint32_t thread = 0; thread < detail::alloc_profile_threads(); ++thread)
+            detail::alloc_profiles[thread] = {};
+    }
+}
+
+#endif
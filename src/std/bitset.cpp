@@ -0,0 +1,253 @@
+#include "bitset.hpp"
+#include "utility.hpp"
+#include "section.hpp"
+
+
+namespace std
+{
+
+
+    // dynamic_bitset
+    // Constructors implementations
+    dynamic_bitset::dynamic_bitset() noexcept : m_words(nullptr), m_size(0)
+    {
+    }
+
+    dynamic_bitset::dynamic_bitset(size_t bits, bool value) : dynamic_bitset()
+    {
+        resize(bits, value);
+    }
+
+    dynamic_bitset::dynamic_bitset(const dynamic_bitset& other) : dynamic_bitset()
+    {
+        *this = other;
+    }
+
+    dynamic_bitset::dynamic_bitset(dynamic_bitset&& other) noexcept : dynamic_bitset()
+    {
+        swap(other);
+    }
+
+    // Destructor
+    dynamic_bitset::~dynamic_bitset()
+    {
+        delete[] m_words;
+    }
+
+    // Operators
+    dynamic_bitset& dynamic_bitset::operator=(const dynamic_bitset& other)
+    {
+        if (this == &other)
+            return *this;
+
+        if (num_words() != other.num_words())
+        {
+            delete[] m_words;
+            m_words = other.num_words() ? new word_type[other.num_words()] : nullptr;
+        }
+
+        m_size = other.m_size;
+        detail::bitset_copy(m_words, other.m_words, num_words());
+        return *this;
+    }
+
+    dynamic_bitset& dynamic_bitset::operator=(dynamic_bitset&& other) noexcept
+    {
+        dynamic_bitset(move(other)).swap(*this);
+        return *this;
+    }
+
+    bool dynamic_bitset::operator[](size_t pos) const
+    {
+        return (m_words[pos / detail::bitset_word_bits] >> (pos % detail::bitset_word_bits)) & 1;
+    }
+
+    bool dynamic_bitset::operator==(const dynamic_bitset& other) const noexcept
+    {
+        return m_size == other.m_size && detail::bitset_equal(m_words, other.m_words, num_words());
+    }
+
+    dynamic_bitset& dynamic_bitset::operator&=(const dynamic_bitset& other) noexcept
+    {
+        detail::bitset_and(m_words, other.m_words, num_words());
+        return *this;
+    }
+
+    dynamic_bitset& dynamic_bitset::operator|=(const dynamic_bitset& other) noexcept
+    {
+        detail::bitset_or(m_words, other.m_words, num_words());
+        return *this;
+    }
+
+    dynamic_bitset& dynamic_bitset::operator^=(const dynamic_bitset& other) noexcept
+    {
+        detail::bitset_xor(m_words, other.m_words, num_words());
+        return *this;
+    }
+
+    // Member functions
+    bool dynamic_bitset::test(size_t pos) const
+    {
+        return (*this)[pos];
+    }
+
+    bool dynamic_bitset::all() const noexcept
+    {
+        return count() == m_size;
+    }
+
+    bool dynamic_bitset::any() const noexcept
+    {
+        return !none();
+    }
+
+    bool dynamic_bitset::none() const noexcept
+    {
+        return find_first() == npos;
+    }
+
+    STL_HOT size_t dynamic_bitset::count() const noexcept
+    {
+        return detail::bitset_count(m_words, num_words());
+    }
+
+    dynamic_bitset& dynamic_bitset::set() noexcept
+    {
+        detail::bitset_fill(m_words, num_words(), ~word_type(0));
+        clear_unused_bits();
+        return *this;
+    }
+
+    dynamic_bitset& dynamic_bitset::set(size_t pos, bool value)
+    {
+        const word_type mask = word_type(1) << (pos % detail::bitset_word_bits);
+        word_type& word = m_words[pos / detail::bitset_word_bits];
+        word = value ? word | mask : word & ~mask;
+        return *this;
+    }
+
+    dynamic_bitset& dynamic_bitset::reset() noexcept
+    {
+        detail::bitset_fill(m_words, num_words(), 0);
+        return *this;
+    }
+
+    dynamic_bitset& dynamic_bitset::reset(size_t pos)
+    {
+        return set(pos, false);
+    }
+
+    dynamic_bitset& dynamic_bitset::flip() noexcept
+    {
+        detail::bitset_not(m_words, num_words());
+        clear_unused_bits();
+        return *this;
+    }
+
+    dynamic_bitset& dynamic_bitset::flip(size_t pos)
+    {
+        m_words[pos / detail::bitset_word_bits] ^= word_type(1) << (pos % detail::bitset_word_bits);
+        return *this;
+    }
+
+    dynamic_bitset& dynamic_bitset::and_not(const dynamic_bitset& other) noexcept
+    {
+        detail::bitset_and_not(m_words, other.m_words, num_words());
+        return *this;
+    }
+
+    void dynamic_bitset::resize(size_t bits, bool value)
+    {
+        const size_t old_size = m_size;
+        const size_t old_words = num_words();
+        const size_t new_words = detail::bitset_words_for(bits);
+
+        if (new_words != old_words)
+        {
+            word_type* words = new_words ? new word_type[new_words] : nullptr;
+            const size_t kept = old_words < new_words ? old_words : new_words;
+
+            detail::bitset_copy(words, m_words, kept);
+            detail::bitset_fill(words + kept, new_words - kept, value ? ~word_type(0) : 0);
+
+            delete[] m_words;
+            m_words = words;
+        }
+
+        // The padding bits of the old last word are zero, so only a "true" fill has to patch them.
+        if (value && bits > old_size && old_size % detail::bitset_word_bits != 0)
+            m_words[old_size / detail::bitset_word_bits] |= ~word_type(0) << (old_size % detail::bitset_word_bits);
+
+        m_size = bits;
+        clear_unused_bits();
+    }
+
+    void dynamic_bitset::clear() noexcept
+    {
+        delete[] m_words;
+        m_words = nullptr;
+        m_size = 0;
+    }
+
+    void dynamic_bitset::swap(dynamic_bitset& other) noexcept
+    {
+        word_type* words = m_words;
+        m_words = other.m_words;
+        other.m_words = words;
+
+        size_t size = m_size;
+        m_size = other.m_size;
+        other.m_size = size;
+    }
+
+    STL_HOT size_t dynamic_bitset::find_first() const noexcept
+    {
+        return detail::bitset_find_next(m_words, num_words(), m_size, 0, 0);
+    }
+
+    STL_HOT size_t dynamic_bitset::find_next(size_t pos) const noexcept
+    {
+        return pos >= m_size ? npos : detail::bitset_find_next(m_words, num_words(), m_size, pos + 1, 0);
+    }
+
+    size_t dynamic_bitset::find_last() const noexcept
+    {
+        return detail::bitset_find_last(m_words, num_words(), m_size, 0);
+    }
+
+    STL_HOT size_t dynamic_bitset::find_first_unset() const noexcept
+    {
+        return detail::bitset_find_next(m_words, num_words(), m_size, 0, ~word_type(0));
+    }
+
+    STL_HOT size_t dynamic_bitset::find_next_unset(size_t pos) const noexcept
+    {
+        return pos >= m_size ? npos : detail::bitset_find_next(m_words, num_words(), m_size, pos + 1, ~word_type(0));
+    }
+
+    size_t dynamic_bitset::size() const noexcept
+    {
+        return m_size;
+    }
+
+    size_t dynamic_bitset::num_words() const noexcept
+    {
+        return detail::bitset_words_for(m_size);
+    }
+
+    const dynamic_bitset::word_type* dynamic_bitset::data() const noexcept
+    {
+        return m_words;
+    }
+
+    dynamic_bitset::word_type* dynamic_bitset::data() noexcept
+    {
+        return m_words;
+    }
+
+    void dynamic_bitset::clear_unused_bits() noexcept
+    {
+        if (m_size % detail::bitset_word_bits != 0)
+            m_words[num_words() - 1] &= (word_type(1) << (m_size % detail::bitset_word_bits)) - 1;
+    }
+}
@@ -0,0 +1,69 @@
+#include "concurrent_unordered_map.hpp"
+
+
+namespace std
+{
+    namespace detail
+    {
+        // shared_seqlock
+        // Member functions
+        void shared_seqlock::lock() noexcept
+        {
+            // Claim the writer bit, which turns new readers away, then wait for the readers
+            // already in to leave.
+            uint32_t state = __atomic_load_n(&m_state, __ATOMIC_RELAXED);
+            while ((state & 1) != 0 || !__atomic_compare_exchange_n(&m_state, &state, state | 1, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+                __builtin_ia32_pause();
+                state = __atomic_load_n(&m_state, __ATOMIC_RELAXED);
+            }
+
+            while (__atomic_load_n(&m_state, __ATOMIC_ACQUIRE) != 1)
+                __builtin_ia32_pause();
+
+            // Odd from here on: an optimistic reader overlapping with the writes below sees the
+            // sequence change and reads again.
+            __atomic_store_n(&m_sequence, m_sequence + 1, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+        }
+
+        void shared_seqlock::unlock() noexcept
+        {
+            __atomic_store_n(&m_sequence, m_sequence + 1, __ATOMIC_RELEASE);
+            __atomic_store_n(&m_state, 0, __ATOMIC_RELEASE);
+        }
+
+        void shared_seqlock::lock_shared() noexcept
+        {
+            uint32_t state = __atomic_load_n(&m_state, __ATOMIC_RELAXED);
+            while ((state & 1) != 0 || !__atomic_compare_exchange_n(&m_state, &state, state + 2, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+                __builtin_ia32_pause();
+                state = __atomic_load_n(&m_state, __ATOMIC_RELAXED);
+            }
+        }
+
+        void shared_seqlock::unlock_shared() noexcept
+        {
+            __atomic_fetch_sub(&m_state, 2, __ATOMIC_RELEASE);
+        }
+
+        uint32_t shared_seqlock::read_begin() const noexcept
+        {
+            uint32_t sequence = __atomic_load_n(&m_sequence, __ATOMIC_ACQUIRE);
+            while ((sequence & 1) != 0)
+            {
+                __builtin_ia32_pause();
+                sequence = __atomic_load_n(&m_sequence, __ATOMIC_ACQUIRE);
+            }
+            return sequence;
+        }
+
+        bool shared_seqlock::read_retry(uint32_t sequence) const noexcept
+        {
+            // Orders the data reads before the second look at the sequence.
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            return __atomic_load_n(&m_sequence, __ATOMIC_RELAXED) != sequence;
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#include "coroutine.hpp"
+
+
+namespace std
+{
+    // noop_coroutine
+    coroutine_handle<noop_coroutine_promise>::coroutine_handle(void* frame) noexcept : m_frame(frame)
+    {
+    }
+
+    noop_coroutine_promise& coroutine_handle<noop_coroutine_promise>::promise() const noexcept
+    {
+        return *static_cast<noop_coroutine_promise*>(__builtin_coro_promise(m_frame, __alignof(noop_coroutine_promise), false));
+    }
+
+#if !__has_builtin(__builtin_coro_noop)
+    namespace detail
+    {
+        // Same layout as a compiler generated frame: resume and destroy entry points, then the promise.
+        struct noop_coroutine_frame
+        {
+            void (*resume)(void*) noexcept;
+            void (*destroy)(void*) noexcept;
+            noop_coroutine_promise promise;
+        };
+
+        void noop_coroutine_entry(void*) noexcept
+        {
+        }
+
+        constinit noop_coroutine_frame noop_frame{ &noop_coroutine_entry, &noop_coroutine_entry, {} };
+    }
+#endif
+
+    noop_coroutine_handle noop_coroutine() noexcept
+    {
+#if __has_builtin(__builtin_coro_noop)
+        return noop_coroutine_handle(__builtin_coro_noop());
+#else
+        return noop_coroutine_handle(&detail::noop_frame);
+#endif
+    }
+
+
+    // frame_arena
+    namespace detail
+    {
+        inline constexpr size_t frame_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+        constexpr size_t align_frame_size(size_t size) noexcept
+        {
+            return (size + frame_alignment - 1) & ~(frame_alignment - 1);
+        }
+    }
+
+    // Constructors implementations
+    frame_arena::frame_arena(void* buffer, size_t size) noexcept
+    {
+        char* begin = static_cast<char*>(buffer);
+        char* aligned = reinterpret_cast<char*>(detail::align_frame_size(reinterpret_cast<size_t>(begin)));
+
+        m_begin = aligned;
+        m_top = aligned;
+        m_end = aligned <= begin + size ? begin + size : aligned;
+    }
+
+    // Member functions
+    void* frame_arena::allocate(size_t size)
+    {
+        const size_t rounded = detail::align_frame_size(size);
+
+        if (static_cast<size_t>(m_end - m_top) < rounded)
+            return ::operator new(size);
+
+        void* frame = m_top;
+        m_top += rounded;
+        return frame;
+    }
+
+    void frame_arena::deallocate(void* pointer, size_t size) noexcept
+    {
+        char* frame = static_cast<char*>(pointer);
+
+        if (frame < m_begin || frame >= m_end)
+        {
+            ::operator delete(pointer);
+            return;
+        }
+
+        // Out of order frees stay allocated until everything above them is released or reset() is called.
+        if (frame + detail::align_frame_size(size) == m_top)
+            m_top = frame;
+    }
+
+    void frame_arena::reset() noexcept
+    {
+        m_top = m_begin;
+    }
+
+    size_t frame_arena::used() const noexcept
+    {
+        return static_cast<size_t>(m_top - m_begin);
+    }
+
+
+    // promise_allocator
+    namespace detail
+    {
+        inline void global_frame_deallocate(void*, void* frame, size_t) noexcept
+        {
+            ::operator delete(frame);
+        }
+
+        void* promise_allocator::operator new(size_t size)
+        {
+            void* frame = ::operator new(frame_total_size(size));
+            *frame_trailer_of(frame, size) = { &global_frame_deallocate, nullptr };
+            return frame;
+        }
+
+        void promise_allocator::operator delete(void* frame, size_t size) noexcept
+        {
+            const frame_trailer trailer = *frame_trailer_of(frame, size);
+            trailer.deallocate(trailer.context, frame, frame_total_size(size));
+        }
+    }
+}
\ No newline at end of file
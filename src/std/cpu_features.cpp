@@ -0,0 +1,109 @@
+#include "cpu_features.hpp"
+#include "section.hpp"
+
+
+namespace std
+{
+    namespace detail
+    {
+        struct cpuid_registers
+        {
+            uint32_t eax;
+            uint32_t ebx;
+            uint32_t ecx;
+            uint32_t edx;
+        };
+
+#if defined(__x86_64__) || defined(__i386__)
+        inline cpuid_registers cpuid(uint32_t leaf, uint32_t subleaf = 0) noexcept
+        {
+            cpuid_registers registers;
+            asm volatile("cpuid"
+                         : "=a"(registers.eax), "=b"(registers.ebx), "=c"(registers.ecx), "=d"(registers.edx)
+                         : "a"(leaf), "c"(subleaf));
+            return registers;
+        }
+
+        // Register state the OS saves on context switches (XCR0). Only valid when OSXSAVE is set.
+        inline uint64_t xgetbv(uint32_t index) noexcept
+        {
+            uint32_t low;
+            uint32_t high;
+            asm volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(index));
+            return (static_cast<uint64_t>(high) << 32) | low;
+        }
+#endif
+
+        inline constexpr uint32_t cpu_bit(uint32_t value, int bit) noexcept
+        {
+            return (value >> bit) & 1;
+        }
+
+        STL_COLD cpu_feature_set probe_cpu_features() noexcept
+        {
+            cpu_feature_set features;
+
+#if defined(__x86_64__) || defined(__i386__)
+            const auto add = [&features](bool present, cpu_feature feature) {
+                if (present)
+                    features = features | feature;
+            };
+
+            const uint32_t max_leaf = cpuid(0).eax;
+            const cpuid_registers leaf1 = cpuid(1);
+
+            add(cpu_bit(leaf1.edx, 26), cpu_feature::sse2);
+            add(cpu_bit(leaf1.ecx, 0), cpu_feature::sse3);
+            add(cpu_bit(leaf1.ecx, 9), cpu_feature::ssse3);
+            add(cpu_bit(leaf1.ecx, 19), cpu_feature::sse4_1);
+            add(cpu_bit(leaf1.ecx, 20), cpu_feature::sse4_2);
+            add(cpu_bit(leaf1.ecx, 23), cpu_feature::popcnt);
+
+            // XMM and YMM state (bits 1 and 2), then the opmask and ZMM state (bits 5 to 7).
+            const uint64_t xcr0 = cpu_bit(leaf1.ecx, 27) ? xgetbv(0) : 0;
+            const bool avx_state = (xcr0 & 0x06) == 0x06;
+            const bool avx512_state = (xcr0 & 0xE6) == 0xE6;
+
+            add(avx_state && cpu_bit(leaf1.ecx, 28), cpu_feature::avx);
+            add(avx_state && cpu_bit(leaf1.ecx, 12), cpu_feature::fma);
+
+            if (max_leaf >= 7)
+            {
+                const cpuid_registers leaf7 = cpuid(7, 0);
+
+                add(cpu_bit(leaf7.ebx, 3), cpu_feature::bmi1);
+                add(cpu_bit(leaf7.ebx, 8), cpu_feature::bmi2);
+                add(avx_state && cpu_bit(leaf7.ebx, 5), cpu_feature::avx2);
+                add(avx512_state && cpu_bit(leaf7.ebx, 16), cpu_feature::avx512f);
+                add(avx512_state && cpu_bit(leaf7.ebx, 30), cpu_feature::avx512bw);
+                add(avx512_state && cpu_bit(leaf7.ebx, 31), cpu_feature::avx512vl);
+            }
+
+            if (cpuid(0x8000'0000).eax >= 0x8000'0001)
+                add(cpu_bit(cpuid(0x8000'0001).ecx, 5), cpu_feature::lzcnt);
+#endif
+
+            return features;
+        }
+
+        STL_RO_AFTER_INIT cpu_feature_set host_cpu_features;
+        STL_RO_AFTER_INIT bool host_cpu_features_ready = false;
+
+        // First in line among the static constructors, so that the other ones can dispatch too.
+        [[gnu::constructor(101)]] STL_STARTUP void detect_host_cpu_features() noexcept
+        {
+            host_cpu_features = probe_cpu_features();
+            __atomic_store_n(&host_cpu_features_ready, true, __ATOMIC_RELEASE);
+        }
+    }
+
+
+    cpu_feature_set cpu_features() noexcept
+    {
+        // Only reachable before the static constructors ran (from another constructor, say).
+        if (!__atomic_load_n(&detail::host_cpu_features_ready, __ATOMIC_ACQUIRE))
+            return detail::probe_cpu_features();
+
+        return detail::host_cpu_features;
+    }
+}
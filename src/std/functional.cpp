@@ -3,8 +3,50 @@
 
 namespace std
 {
-    template<class T>
-    constexpr bool less<T>::operator()(const T &lhs, const T &rhs) const {
-        return lhs < rhs;
+    namespace detail
+    {
+        inline uint64_t hash_load64(const uint8_t* bytes) noexcept
+        {
+            uint64_t word;
+            __builtin_memcpy(&word, bytes, sizeof(word));
+            return word;
+        }
+
+        inline uint64_t hash_load32(const uint8_t* bytes) noexcept
+        {
+            uint32_t word;
+            __builtin_memcpy(&word, bytes, sizeof(word));
+            return word;
+        }
+
+        size_t hash_bytes(const void* data, size_t size, size_t seed) noexcept
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            const size_t length = size;
+            uint64_t hash = seed ^ hash_multiplier;
+
+            for (; size > 16; bytes += 16, size -= 16)
+                hash = hash_fold(hash_load64(bytes) ^ hash_secret, hash_load64(bytes + 8) ^ hash);
+
+            // The last 1 to 16 bytes, read as two possibly overlapping words.
+            uint64_t low = 0;
+            uint64_t high = 0;
+            if (size >= 8)
+            {
+                low = hash_load64(bytes);
+                high = hash_load64(bytes + size - 8);
+            }
+            else if (size >= 4)
+            {
+                low = hash_load32(bytes);
+                high = hash_load32(bytes + size - 4);
+            }
+            else if (size > 0)
+            {
+                low = (uint64_t(bytes[0]) << 16) | (uint64_t(bytes[size / 2]) << 8) | bytes[size - 1];
+            }
+
+            return hash_fold(hash_fold(low ^ hash_secret, high ^ hash), length ^ hash_multiplier);
+        }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,219 @@
+#include "intern_pool.hpp"
+#include "bit.hpp"
+#include "new.hpp"
+#include "section.hpp"
+
+
+namespace std
+{
+    namespace detail
+    {
+        inline constexpr size_t intern_block_header = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+        inline constexpr size_t intern_initial_index = 64;
+
+        // Strings longer than this get a block of their own instead of wasting the current one.
+        inline constexpr size_t intern_large_string = intern_block_size / 4;
+
+        void*& intern_link(void* block) noexcept
+        {
+            return *static_cast<void**>(block);
+        }
+
+        // Segment k holds the entries intern_first_segment * (2^k - 1) and up.
+        size_t intern_segment(uint32_t index, size_t& offset) noexcept
+        {
+            const uint64_t position = static_cast<uint64_t>(index) + intern_first_segment;
+            const size_t segment = static_cast<size_t>(bit_width(position) - bit_width(intern_first_segment));
+            offset = static_cast<size_t>(position - (static_cast<uint64_t>(intern_first_segment) << segment));
+            return segment;
+        }
+
+
+        // intern_shard
+        // Constructors implementations
+        intern_shard::intern_shard() noexcept
+            : m_segments{}, m_index(nullptr), m_index_capacity(0), m_count(0), m_cursor(nullptr), m_available(0),
+              m_blocks(nullptr), m_lock(false)
+        {
+        }
+
+        // Destructor implementation
+        intern_shard::~intern_shard()
+        {
+            for (intern_entry* segment : m_segments)
+                ::operator delete(segment);
+            ::operator delete(m_index);
+
+            void* block = m_blocks;
+            while (block)
+            {
+                void* next = intern_link(block);
+                ::operator delete(block);
+                block = next;
+            }
+        }
+
+        // Member functions
+        STL_HOT uint32_t intern_shard::intern(string_view text, size_t hash, uint32_t limit) noexcept
+        {
+            size_t slot = probe(text, hash);
+            if (m_index && m_index[slot])
+                return static_cast<uint32_t>(m_index[slot]) - 1;
+
+            if (m_count >= limit)
+                return intern_none;
+
+            // Kept at most 3/4 full, so that probe always meets an empty slot.
+            if ((static_cast<size_t>(m_count) + 1) * 4 > m_index_capacity * 3)
+            {
+                if (!grow_index())
+                    return intern_none;
+                slot = probe(text, hash);
+            }
+
+            size_t offset;
+            const size_t segment = intern_segment(m_count, offset);
+            if (!m_segments[segment])
+            {
+                m_segments[segment] = static_cast<intern_entry*>(::operator new((intern_first_segment << segment) * sizeof(intern_entry), nothrow));
+                if (!m_segments[segment])
+                    return intern_none;
+            }
+
+            const char* data = store(text);
+            if (!data)
+                return intern_none;
+
+            const uint32_t index = m_count;
+            m_segments[segment][offset] = { data, text.size() };
+            m_index[slot] = (static_cast<uint64_t>(hash) & 0xFFFFFFFF00000000ull) | (static_cast<uint64_t>(index) + 1);
+            __atomic_store_n(&m_count, index + 1, __ATOMIC_RELEASE);
+            return index;
+        }
+
+        uint32_t intern_shard::find(string_view text, size_t hash) const noexcept
+        {
+            if (!m_index)
+                return intern_none;
+
+            const uint64_t entry = m_index[probe(text, hash)];
+            return entry ? static_cast<uint32_t>(entry) - 1 : intern_none;
+        }
+
+        const intern_entry& intern_shard::entry(uint32_t index) const noexcept
+        {
+            size_t offset;
+            const size_t segment = intern_segment(index, offset);
+            return m_segments[segment][offset];
+        }
+
+        uint32_t intern_shard::size() const noexcept
+        {
+            return __atomic_load_n(&m_count, __ATOMIC_ACQUIRE);
+        }
+
+        void intern_shard::lock() noexcept
+        {
+            while (__atomic_exchange_n(&m_lock, true, __ATOMIC_ACQUIRE))
+            {
+                while (__atomic_load_n(&m_lock, __ATOMIC_RELAXED))
+                    __builtin_ia32_pause();
+            }
+        }
+
+        void intern_shard::unlock() noexcept
+        {
+            __atomic_store_n(&m_lock, false, __ATOMIC_RELEASE);
+        }
+
+        size_t intern_shard::probe(string_view text, size_t hash) const noexcept
+        {
+            if (!m_index)
+                return 0;
+
+            const size_t mask = m_index_capacity - 1;
+            const uint64_t tag = static_cast<uint64_t>(hash) & 0xFFFFFFFF00000000ull;
+
+            // Linear probing; the tag (high hash bits) rejects nearly every other string without
+            // touching its text.
+            for (size_t slot = hash & mask; ; slot = (slot + 1) & mask)
+            {
+                const uint64_t current = m_index[slot];
+                if (!current)
+                    return slot;
+
+                if ((current & 0xFFFFFFFF00000000ull) == tag)
+                {
+                    const intern_entry& candidate = entry(static_cast<uint32_t>(current) - 1);
+                    if (string_view(candidate.data, candidate.size) == text)
+                        return slot;
+                }
+            }
+        }
+
+        bool intern_shard::grow_index() noexcept
+        {
+            const size_t capacity = m_index_capacity ? m_index_capacity * 2 : intern_initial_index;
+            uint64_t* index = static_cast<uint64_t*>(::operator new(capacity * sizeof(uint64_t), nothrow));
+            if (!index)
+                return false;
+
+            for (size_t slot = 0; slot < capacity; ++slot)
+                index[slot] = 0;
+
+            // The index only keeps the high half of each hash, so the strings are hashed again;
+            // growing is the rare path.
+            for (uint32_t i = 0; i < m_count; ++i)
+            {
+                const intern_entry& current = entry(i);
+                const size_t hash = hash_bytes(current.data, current.size);
+
+                size_t slot = hash & (capacity - 1);
+                while (index[slot])
+                    slot = (slot + 1) & (capacity - 1);
+                index[slot] = (static_cast<uint64_t>(hash) & 0xFFFFFFFF00000000ull) | (static_cast<uint64_t>(i) + 1);
+            }
+
+            ::operator delete(m_index);
+            m_index = index;
+            m_index_capacity = capacity;
+            return true;
+        }
+
+        const char* intern_shard::store(string_view text) noexcept
+        {
+            const size_t size = text.size() + 1;
+
+            char* destination;
+            if (size > m_available)
+            {
+                const size_t block_size = size > intern_large_string ? size : intern_block_size;
+                char* block = static_cast<char*>(::operator new(intern_block_header + block_size, nothrow));
+                if (!block)
+                    return nullptr;
+
+                intern_link(block) = m_blocks;
+                m_blocks = block;
+                destination = block + intern_block_header;
+
+                // A large string leaves the current block in use for the next small ones.
+                if (size <= intern_large_string)
+                {
+                    m_cursor = destination + size;
+                    m_available = block_size - size;
+                }
+            }
+            else
+            {
+                destination = m_cursor;
+                m_cursor += size;
+                m_available -= size;
+            }
+
+            for (size_t i = 0; i < text.size(); ++i)
+                destination[i] = text[i];
+            destination[text.size()] = '\0';
+            return destination;
+        }
+    }
+}
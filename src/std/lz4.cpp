@@ -0,0 +1,720 @@
+#include "lz4.hpp"
+#include "section.hpp"
+
+
+namespace std
+{
+    namespace detail
+    {
+        inline constexpr uint32_t lz4_frame_magic = 0x184D2204;
+        inline constexpr uint32_t lz4_skippable_magic = 0x184D2A50;    // the low 4 bits are free
+        inline constexpr uint32_t lz4_uncompressed_bit = 0x80000000;
+
+        // Frame descriptor flags
+        inline constexpr uint8_t lz4_flag_independent = 0x20;
+        inline constexpr uint8_t lz4_flag_block_checksum = 0x10;
+        inline constexpr uint8_t lz4_flag_content_size = 0x08;
+        inline constexpr uint8_t lz4_flag_content_checksum = 0x04;
+        inline constexpr uint8_t lz4_flag_dictionary = 0x01;
+
+        inline constexpr uint32_t xxh32_prime1 = 2654435761u;
+        inline constexpr uint32_t xxh32_prime2 = 2246822519u;
+        inline constexpr uint32_t xxh32_prime3 = 3266489917u;
+        inline constexpr uint32_t xxh32_prime4 = 668265263u;
+        inline constexpr uint32_t xxh32_prime5 = 374761393u;
+
+        // The formats are little endian; byte by byte so that the compiler emits plain loads
+        // without assuming alignment.
+        uint32_t lz4_read32(const uint8_t* data) noexcept
+        {
+            return uint32_t(data[0]) | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16 | uint32_t(data[3]) << 24;
+        }
+
+        uint64_t lz4_read64(const uint8_t* data) noexcept
+        {
+            return uint64_t(lz4_read32(data)) | uint64_t(lz4_read32(data + 4)) << 32;
+        }
+
+        void lz4_write32(uint8_t* data, uint32_t value) noexcept
+        {
+            for (size_t i = 0; i < 4; ++i)
+                data[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+
+        uint32_t xxh32_rotate(uint32_t value, int bits) noexcept
+        {
+            return (value << bits) | (value >> (32 - bits));
+        }
+
+        uint32_t xxh32_round(uint32_t lane, uint32_t input) noexcept
+        {
+            return xxh32_rotate(lane + input * xxh32_prime2, 13) * xxh32_prime1;
+        }
+
+
+        // lz4_xxh32_state
+        // Constructors implementations
+        lz4_xxh32_state::lz4_xxh32_state(uint32_t seed) noexcept
+        {
+            reset(seed);
+        }
+
+        // Member functions
+        void lz4_xxh32_state::reset(uint32_t seed) noexcept
+        {
+            m_lanes[0] = seed + xxh32_prime1 + xxh32_prime2;
+            m_lanes[1] = seed + xxh32_prime2;
+            m_lanes[2] = seed;
+            m_lanes[3] = seed - xxh32_prime1;
+            m_buffered = 0;
+            m_total = 0;
+            m_seed = seed;
+        }
+
+        void lz4_xxh32_state::update(const void* data, size_t size) noexcept
+        {
+            const uint8_t* input = static_cast<const uint8_t*>(data);
+            m_total += size;
+
+            if (m_buffered)
+            {
+                while (size && m_buffered < 16)
+                {
+                    m_buffer[m_buffered++] = *input++;
+                    --size;
+                }
+                if (m_buffered < 16)
+                    return;
+
+                for (size_t lane = 0; lane < 4; ++lane)
+                    m_lanes[lane] = xxh32_round(m_lanes[lane], lz4_read32(m_buffer + lane * 4));
+                m_buffered = 0;
+            }
+
+            for (; size >= 16; input += 16, size -= 16)
+            {
+                for (size_t lane = 0; lane < 4; ++lane)
+                    m_lanes[lane] = xxh32_round(m_lanes[lane], lz4_read32(input + lane * 4));
+            }
+
+            for (; size; --size)
+                m_buffer[m_buffered++] = *input++;
+        }
+
+        uint32_t lz4_xxh32_state::digest() const noexcept
+        {
+            uint32_t hash;
+            if (m_total >= 16)
+            {
+                hash = xxh32_rotate(m_lanes[0], 1) + xxh32_rotate(m_lanes[1], 7) + xxh32_rotate(m_lanes[2], 12)
+                       + xxh32_rotate(m_lanes[3], 18);
+            }
+            else
+            {
+                hash = m_seed + xxh32_prime5;
+            }
+
+            hash += static_cast<uint32_t>(m_total);
+
+            size_t i = 0;
+            for (; i + 4 <= m_buffered; i += 4)
+                hash = xxh32_rotate(hash + lz4_read32(m_buffer + i) * xxh32_prime3, 17) * xxh32_prime4;
+            for (; i < m_buffered; ++i)
+                hash = xxh32_rotate(hash + m_buffer[i] * xxh32_prime5, 11) * xxh32_prime1;
+
+            hash ^= hash >> 15;
+            hash *= xxh32_prime2;
+            hash ^= hash >> 13;
+            hash *= xxh32_prime3;
+            hash ^= hash >> 16;
+            return hash;
+        }
+
+
+        // Functions
+        uint32_t lz4_xxh32(const void* data, size_t size, uint32_t seed) noexcept
+        {
+            lz4_xxh32_state state(seed);
+            state.update(data, size);
+            return state.digest();
+        }
+
+        // Adds the 255-continued extension of a length field.
+        bool lz4_read_length(const uint8_t*& input, const uint8_t* end, size_t& length) noexcept
+        {
+            uint8_t byte;
+            do
+            {
+                if (input == end)
+                    return false;
+
+                byte = *input++;
+                length += byte;
+            } while (byte == 255);
+
+            return true;
+        }
+
+        // The copies below may write up to 15 bytes past their end, the caller checked there is
+        // room for that.
+        void lz4_copy_wide(uint8_t* destination, const uint8_t* source, size_t size) noexcept
+        {
+            for (size_t i = 0; i < size; i += 16)
+                __builtin_memcpy(destination + i, source + i, 16);
+        }
+
+        void lz4_copy_match(uint8_t* destination, size_t offset, size_t length) noexcept
+        {
+            uint8_t* const end = destination + length;
+            const uint8_t* match = destination - offset;
+
+            // A period shorter than a word: spell the pattern out byte by byte until the distance
+            // is a multiple of the period that is at least 8, from where words copy it unchanged.
+            if (offset < 8)
+            {
+                const size_t distance = offset * ((8 + offset - 1) / offset);
+                for (size_t i = 0; i < distance; ++i)
+                    destination[i] = match[i];
+
+                destination += distance;
+                match = destination - distance;
+                offset = distance;
+            }
+
+            if (offset < 16)
+            {
+                for (; destination < end; destination += 8, match += 8)
+                    __builtin_memcpy(destination, match, 8);
+            }
+            else
+            {
+                for (; destination < end; destination += 16, match += 16)
+                    __builtin_memcpy(destination, match, 16);
+            }
+        }
+
+        STL_HOT size_t lz4_decode(const uint8_t* source, size_t size, uint8_t* destination, size_t history, size_t position, size_t capacity) noexcept
+        {
+            const uint8_t* input = source;
+            const uint8_t* const input_end = source + size;
+            uint8_t* output = destination + position;
+            uint8_t* const output_end = destination + capacity;
+            const uint8_t* const lowest = destination + history;
+
+            // Even an empty block holds one token.
+            if (!size)
+                return lz4_error;
+
+            while (true)
+            {
+                const uint8_t token = *input++;
+
+                size_t literals = token >> 4;
+                if (literals == 15 && !lz4_read_length(input, input_end, literals))
+                    return lz4_error;
+
+                if (literals > static_cast<size_t>(input_end - input) || literals > static_cast<size_t>(output_end - output))
+                    return lz4_error;
+
+                if (literals + 16 <= static_cast<size_t>(input_end - input) && literals + 16 <= static_cast<size_t>(output_end - output))
+                    lz4_copy_wide(output, input, literals);
+                else
+                    __builtin_memcpy(output, input, literals);
+
+                input += literals;
+                output += literals;
+
+                // The last sequence has literals only.
+                if (input == input_end)
+                    break;
+
+                if (input_end - input < 2)
+                    return lz4_error;
+
+                const size_t offset = size_t(input[0]) | size_t(input[1]) << 8;
+                input += 2;
+                if (!offset || offset > static_cast<size_t>(output - lowest))
+                    return lz4_error;
+
+                size_t length = token & 15;
+                if (length == 15 && !lz4_read_length(input, input_end, length))
+                    return lz4_error;
+                length += 4;
+
+                if (length > static_cast<size_t>(output_end - output))
+                    return lz4_error;
+
+                if (length + 16 <= static_cast<size_t>(output_end - output))
+                {
+                    lz4_copy_match(output, offset, length);
+                }
+                else
+                {
+                    for (size_t i = 0; i < length; ++i)
+                        output[i] = output[i - offset];
+                }
+                output += length;
+
+                if (input == input_end)
+                    return lz4_error;
+            }
+
+            return static_cast<size_t>(output - destination);
+        }
+    }
+
+
+    // Functions
+    size_t lz4_decompress_block(span<const char> source, span<char> destination) noexcept
+    {
+        return detail::lz4_decode(reinterpret_cast<const uint8_t*>(source.data()), source.size(),
+                                  reinterpret_cast<uint8_t*>(destination.data()), 0, 0, destination.size());
+    }
+
+
+    // lz4_frame_decoder
+    // Constructors implementations
+    lz4_frame_decoder::lz4_frame_decoder(span<char> workspace) noexcept : m_workspace(workspace)
+    {
+        reset();
+    }
+
+    // Member functions
+    STL_HOT lz4_status lz4_frame_decoder::decompress(span<const char>& input, span<char>& output) noexcept
+    {
+        while (true)
+        {
+            switch (m_stage)
+            {
+                case stage::magic:
+                {
+                    if (!gather(input, 4))
+                        return lz4_status::need_input;
+
+                    const uint32_t magic = detail::lz4_read32(m_header);
+                    m_header_size = 0;
+                    if (magic == detail::lz4_frame_magic)
+                        m_stage = stage::descriptor;
+                    else if ((magic & 0xFFFFFFF0) == detail::lz4_skippable_magic)
+                        m_stage = stage::skippable_size;
+                    else
+                        m_stage = stage::error;
+                    break;
+                }
+                case stage::skippable_size:
+                    if (!gather(input, 4))
+                        return lz4_status::need_input;
+
+                    m_skip = detail::lz4_read32(m_header);
+                    m_header_size = 0;
+                    m_stage = stage::skip;
+                    break;
+                case stage::skip:
+                {
+                    const size_t count = m_skip < input.size() ? static_cast<size_t>(m_skip) : input.size();
+                    input = input.subspan(count);
+                    m_skip -= count;
+                    if (m_skip)
+                        return lz4_status::need_input;
+
+                    m_stage = stage::magic;
+                    break;
+                }
+                case stage::descriptor:
+                {
+                    if (!gather(input, 2))
+                        return lz4_status::need_input;
+
+                    const size_t size = 3 + (m_header[0] & detail::lz4_flag_content_size ? 8 : 0)
+                                        + (m_header[0] & detail::lz4_flag_dictionary ? 4 : 0);
+                    if (!gather(input, size))
+                        return lz4_status::need_input;
+
+                    m_stage = parse_descriptor() ? stage::block_size : stage::error;
+                    m_header_size = 0;
+                    break;
+                }
+                case stage::block_size:
+                {
+                    if (!gather(input, 4))
+                        return lz4_status::need_input;
+
+                    const uint32_t value = detail::lz4_read32(m_header);
+                    m_header_size = 0;
+
+                    if (!value)
+                    {
+                        m_stage = m_flags & detail::lz4_flag_content_checksum ? stage::content_checksum : stage::done;
+                        break;
+                    }
+
+                    m_block_compressed = !(value & detail::lz4_uncompressed_bit);
+                    m_block_size = value & ~detail::lz4_uncompressed_bit;
+                    m_block_received = 0;
+                    if (m_block_size > m_block_max)
+                    {
+                        m_stage = stage::error;
+                        break;
+                    }
+
+                    prepare_window();
+                    m_stage = stage::block_data;
+                    break;
+                }
+                case stage::block_data:
+                {
+                    // A block the input holds whole is decoded from there, without staging.
+                    if (m_block_compressed && !m_block_received && input.size() >= m_block_size)
+                    {
+                        const char* data = input.data();
+                        input = input.subspan(m_block_size);
+                        if (!finish_block(data))
+                            m_stage = stage::error;
+                        break;
+                    }
+
+                    // Stored blocks go straight to the window.
+                    char* destination = (m_block_compressed ? m_staging : m_window + m_window_used) + m_block_received;
+                    const size_t wanted = m_block_size - m_block_received;
+                    const size_t count = wanted < input.size() ? wanted : input.size();
+                    __builtin_memcpy(destination, input.data(), count);
+                    input = input.subspan(count);
+                    m_block_received += count;
+
+                    if (m_block_received < m_block_size)
+                        return lz4_status::need_input;
+
+                    if (!finish_block(m_block_compressed ? m_staging : m_window + m_window_used))
+                        m_stage = stage::error;
+                    break;
+                }
+                case stage::block_checksum:
+                    if (!gather(input, 4))
+                        return lz4_status::need_input;
+
+                    m_stage = detail::lz4_read32(m_header) == m_block_hash ? stage::flush : stage::error;
+                    m_header_size = 0;
+                    break;
+                case stage::flush:
+                {
+                    const size_t pending = m_window_used - m_flushed;
+                    const size_t count = pending < output.size() ? pending : output.size();
+                    __builtin_memcpy(output.data(), m_window + m_flushed, count);
+                    output = output.subspan(count);
+                    m_flushed += count;
+
+                    if (m_flushed < m_window_used)
+                        return lz4_status::output_full;
+
+                    m_stage = stage::block_size;
+                    break;
+                }
+                case stage::content_checksum:
+                    if (!gather(input, 4))
+                        return lz4_status::need_input;
+
+                    m_stage = detail::lz4_read32(m_header) == m_content_hash.digest() ? stage::done : stage::error;
+                    m_header_size = 0;
+                    break;
+                case stage::done:
+                    return lz4_status::done;
+                case stage::error:
+                    return lz4_status::error;
+            }
+        }
+    }
+
+    void lz4_frame_decoder::reset() noexcept
+    {
+        m_staging = nullptr;
+        m_window = nullptr;
+        m_window_size = 0;
+        m_window_used = 0;
+        m_flushed = 0;
+        m_block_max = 0;
+        m_block_size = 0;
+        m_block_received = 0;
+        m_block_compressed = false;
+        m_flags = 0;
+        m_block_hash = 0;
+        m_content_size = 0;
+        m_skip = 0;
+        m_header_size = 0;
+        m_stage = stage::magic;
+        m_content_hash.reset();
+    }
+
+    uint64_t lz4_frame_decoder::content_size() const noexcept
+    {
+        return m_content_size;
+    }
+
+    bool lz4_frame_decoder::gather(span<const char>& input, size_t size) noexcept
+    {
+        while (m_header_size < size && !input.empty())
+        {
+            m_header[m_header_size++] = static_cast<uint8_t>(input[0]);
+            input = input.subspan(1);
+        }
+
+        return m_header_size >= size;
+    }
+
+    bool lz4_frame_decoder::parse_descriptor() noexcept
+    {
+        const uint8_t flags = m_header[0];
+        const uint8_t block_descriptor = m_header[1];
+
+        // Version 01, reserved bits clear, no dictionary.
+        if ((flags >> 6) != 1 || (flags & 0x02) || (flags & detail::lz4_flag_dictionary) || (block_descriptor & 0x8F))
+            return false;
+
+        const uint8_t code = block_descriptor >> 4;
+        if (code < static_cast<uint8_t>(lz4_block_size::max_64kb))
+            return false;
+
+        if (m_header[m_header_size - 1] != static_cast<uint8_t>(detail::lz4_xxh32(m_header, m_header_size - 1) >> 8))
+            return false;
+
+        const bool linked = !(flags & detail::lz4_flag_independent);
+        m_flags = flags;
+        m_block_max = lz4_block_bytes(static_cast<lz4_block_size>(code));
+        m_content_size = flags & detail::lz4_flag_content_size ? detail::lz4_read64(m_header + 2) : 0;
+
+        if (m_workspace.size() < workspace_size(static_cast<lz4_block_size>(code), linked))
+            return false;
+
+        m_staging = m_workspace.data();
+        m_window = m_workspace.data() + m_block_max;
+        m_window_size = m_workspace.size() - m_block_max;
+        m_window_used = 0;
+        m_flushed = 0;
+        m_content_hash.reset();
+        return true;
+    }
+
+    // Makes room for a whole block after the decoded data, keeping the last 64 KiB of it when
+    // blocks refer back to their predecessors.
+    void lz4_frame_decoder::prepare_window() noexcept
+    {
+        if (m_window_size - m_window_used >= m_block_max)
+            return;
+
+        size_t kept = 0;
+        if (!(m_flags & detail::lz4_flag_independent))
+        {
+            kept = m_window_used < detail::lz4_history ? m_window_used : detail::lz4_history;
+            __builtin_memmove(m_window, m_window + m_window_used - kept, kept);
+        }
+
+        m_window_used = kept;
+        m_flushed = kept;
+    }
+
+    bool lz4_frame_decoder::finish_block(const char* data) noexcept
+    {
+        if (m_flags & detail::lz4_flag_block_checksum)
+            m_block_hash = detail::lz4_xxh32(data, m_block_size);
+
+        size_t decoded = m_block_size;
+        if (m_block_compressed)
+        {
+            // Independent blocks may not reach into the previous ones.
+            const size_t history = m_flags & detail::lz4_flag_independent ? m_window_used : 0;
+            const size_t end = detail::lz4_decode(reinterpret_cast<const uint8_t*>(data), m_block_size, reinterpret_cast<uint8_t*>(m_window),
+                                                  history, m_window_used, m_window_used + m_block_max);
+            if (end == lz4_error)
+                return false;
+
+            decoded = end - m_window_used;
+        }
+
+        if (m_flags & detail::lz4_flag_content_checksum)
+            m_content_hash.update(m_window + m_window_used, decoded);
+
+        m_flushed = m_window_used;
+        m_window_used += decoded;
+        m_stage = m_flags & detail::lz4_flag_block_checksum ? stage::block_checksum : stage::flush;
+        return true;
+    }
+
+
+#if defined(__linux__) && defined(__x86_64__)
+
+    namespace detail
+    {
+        inline constexpr size_t lz4_min_match = 4;
+        inline constexpr size_t lz4_last_literals = 5;     // a block ends with at least 5 literals
+        inline constexpr size_t lz4_match_limit = 12;      // and its last match starts 12 bytes before the end
+        inline constexpr int lz4_hash_log = 14;
+
+        // Hash of the 5 bytes at data, which tells more matches apart than 4.
+        uint32_t lz4_hash(const uint8_t* data) noexcept
+        {
+            return static_cast<uint32_t>(((lz4_read64(data) << 24) * 889523592379ull) >> (64 - lz4_hash_log));
+        }
+
+        uint8_t* lz4_write_length(uint8_t* output, size_t length) noexcept
+        {
+            for (; length >= 255; length -= 255)
+                *output++ = 255;
+            *output++ = static_cast<uint8_t>(length);
+            return output;
+        }
+
+        // One sequence: literals, then a match unless length is 0. nullptr when it does not fit.
+        uint8_t* lz4_write_sequence(uint8_t* output, uint8_t* output_end, const uint8_t* literals, size_t literal_count,
+                                    size_t offset, size_t length) noexcept
+        {
+            const size_t worst = 1 + literal_count / 255 + 1 + literal_count + 2 + (length / 255 + 1);
+            if (worst > static_cast<size_t>(output_end - output))
+                return nullptr;
+
+            const size_t match_code = length ? length - lz4_min_match : 0;
+            uint8_t* token = output++;
+            *token = static_cast<uint8_t>((literal_count < 15 ? literal_count : 15) << 4);
+            if (literal_count >= 15)
+                output = lz4_write_length(output, literal_count - 15);
+
+            __builtin_memcpy(output, literals, literal_count);
+            output += literal_count;
+
+            if (!length)
+                return output;
+
+            *output++ = static_cast<uint8_t>(offset);
+            *output++ = static_cast<uint8_t>(offset >> 8);
+            *token |= static_cast<uint8_t>(match_code < 15 ? match_code : 15);
+            if (match_code >= 15)
+                output = lz4_write_length(output, match_code - 15);
+
+            return output;
+        }
+    }
+
+
+    // Functions
+    size_t lz4_compress_block(span<const char> source, span<char> destination) noexcept
+    {
+        const uint8_t* const begin = reinterpret_cast<const uint8_t*>(source.data());
+        const uint8_t* const end = begin + source.size();
+        uint8_t* output = reinterpret_cast<uint8_t*>(destination.data());
+        uint8_t* const output_end = output + destination.size();
+        const uint8_t* anchor = begin;
+
+        if (source.size() > detail::lz4_match_limit)
+        {
+            // Last position seen for each hash, relative to begin.
+            uint32_t table[1 << detail::lz4_hash_log] = {};
+            const uint8_t* const last_start = end - detail::lz4_match_limit;
+            const uint8_t* const match_end = end - detail::lz4_last_literals;
+
+            // Positions skipped grow with the misses, so incompressible data goes by fast.
+            size_t misses = 0;
+            const uint8_t* input = begin + 1;
+            table[detail::lz4_hash(begin)] = 0;
+
+            while (input <= last_start)
+            {
+                const uint32_t sequence = detail::lz4_read32(input);
+                const uint32_t hash = detail::lz4_hash(input);
+                const uint8_t* candidate = begin + table[hash];
+                table[hash] = static_cast<uint32_t>(input - begin);
+
+                if (candidate >= input || static_cast<size_t>(input - candidate) > lz4_max_distance
+                    || detail::lz4_read32(candidate) != sequence)
+                {
+                    input += 1 + (misses++ >> 6);
+                    continue;
+                }
+                misses = 0;
+
+                while (input > anchor && candidate > begin && input[-1] == candidate[-1])
+                {
+                    --input;
+                    --candidate;
+                }
+
+                const uint8_t* matched = input + detail::lz4_min_match;
+                for (const uint8_t* other = candidate + detail::lz4_min_match; matched < match_end && *matched == *other; ++other)
+                    ++matched;
+
+                output = detail::lz4_write_sequence(output, output_end, anchor, static_cast<size_t>(input - anchor),
+                                                    static_cast<size_t>(input - candidate), static_cast<size_t>(matched - input));
+                if (!output)
+                    return 0;
+
+                input = matched;
+                anchor = input;
+
+                // The position just before the next search, which the skipping would miss.
+                if (input - 2 > begin && input - 2 <= last_start)
+                    table[detail::lz4_hash(input - 2)] = static_cast<uint32_t>(input - 2 - begin);
+            }
+        }
+
+        output = detail::lz4_write_sequence(output, output_end, anchor, static_cast<size_t>(end - anchor), 0, 0);
+        if (!output)
+            return 0;
+
+        return static_cast<size_t>(output - reinterpret_cast<uint8_t*>(destination.data()));
+    }
+
+    size_t lz4_compress_frame(span<const char> source, span<char> destination, lz4_block_size block_size) noexcept
+    {
+        uint8_t* const begin = reinterpret_cast<uint8_t*>(destination.data());
+        uint8_t* output = begin;
+        uint8_t* const output_end = begin + destination.size();
+
+        if (destination.size() < 15 + 8)
+            return 0;
+
+        detail::lz4_write32(output, detail::lz4_frame_magic);
+        output += 4;
+
+        uint8_t* const descriptor = output;
+        *output++ = 0x40 | detail::lz4_flag_independent | detail::lz4_flag_content_size | detail::lz4_flag_content_checksum;
+        *output++ = static_cast<uint8_t>(static_cast<uint8_t>(block_size) << 4);
+        detail::lz4_write32(output, static_cast<uint32_t>(source.size()));
+        detail::lz4_write32(output + 4, static_cast<uint32_t>(static_cast<uint64_t>(source.size()) >> 32));
+        output += 8;
+        *output = static_cast<uint8_t>(detail::lz4_xxh32(descriptor, static_cast<size_t>(output - descriptor)) >> 8);
+        ++output;
+
+        const size_t block = lz4_block_bytes(block_size);
+        for (size_t offset = 0; offset < source.size(); offset += block)
+        {
+            const span<const char> chunk = source.subspan(offset, source.size() - offset < block ? source.size() - offset : block);
+            if (static_cast<size_t>(output_end - output) < 4 + 8)
+                return 0;
+
+            // Compressed only if that saves at least one byte.
+            const size_t room = static_cast<size_t>(output_end - output) - 4 - 8;
+            const size_t limit = chunk.size() - 1 < room ? chunk.size() - 1 : room;
+            const size_t compressed = lz4_compress_block(chunk, span<char>(reinterpret_cast<char*>(output + 4), limit));
+
+            if (compressed)
+            {
+                detail::lz4_write32(output, static_cast<uint32_t>(compressed));
+                output += 4 + compressed;
+            }
+            else
+            {
+                if (chunk.size() > room)
+                    return 0;
+
+                detail::lz4_write32(output, static_cast<uint32_t>(chunk.size()) | detail::lz4_uncompressed_bit);
+                __builtin_memcpy(output + 4, chunk.data(), chunk.size());
+                output += 4 + chunk.size();
+            }
+        }
+
+        detail::lz4_write32(output, 0);
+        detail::lz4_write32(output + 4, detail::lz4_xxh32(source.data(), source.size()));
+        output += 8;
+
+        return static_cast<size_t>(output - begin);
+    }
+
+#endif
+}
@@ -0,0 +1,308 @@
+#include "mapped_file.hpp"
+
+#if defined(__linux__) && defined(__x86_64__)
+
+#include "utility.hpp"
+
+
+namespace std
+{
+    // Raw Linux system calls, the library does not link against a libc.
+    namespace detail
+    {
+        enum : long
+        {
+            sys_read = 0,
+            sys_close = 3,
+            sys_fstat = 5,
+            sys_mmap = 9,
+            sys_munmap = 11,
+            sys_madvise = 28,
+            sys_openat = 257
+        };
+
+        inline constexpr long at_fdcwd = -100;
+        inline constexpr long o_rdonly_cloexec = 0x80000;
+        inline constexpr long prot_read = 0x1;
+        inline constexpr long map_private_populate = 0x02 | 0x8000;
+        inline constexpr long madv_random = 1;
+        inline constexpr long madv_sequential = 2;
+        inline constexpr long eintr = 4;
+
+        inline constexpr unsigned s_ifmt = 0170000;
+        inline constexpr unsigned s_ifreg = 0100000;
+
+        // struct stat as laid out by the x86_64 kernel
+        struct kernel_stat
+        {
+            unsigned long st_dev;
+            unsigned long st_ino;
+            unsigned long st_nlink;
+            unsigned int st_mode;
+            unsigned int st_uid;
+            unsigned int st_gid;
+            unsigned int pad0;
+            unsigned long st_rdev;
+            long st_size;
+            long st_blksize;
+            long st_blocks;
+            unsigned long times[6];
+            long reserved[3];
+        };
+
+        long linux_syscall(long number, long a = 0, long b = 0, long c = 0, long d = 0, long e = 0, long f = 0) noexcept
+        {
+            register long r10 asm("r10") = d;
+            register long r8 asm("r8") = e;
+            register long r9 asm("r9") = f;
+            long result;
+
+            asm volatile("syscall"
+                         : "=a"(result)
+                         : "a"(number), "D"(a), "S"(b), "d"(c), "r"(r10), "r"(r8), "r"(r9)
+                         : "rcx", "r11", "memory");
+
+            return result;
+        }
+
+        int open_read_only(const char* path) noexcept
+        {
+            return static_cast<int>(linux_syscall(sys_openat, at_fdcwd, reinterpret_cast<long>(path), o_rdonly_cloexec));
+        }
+
+        void close_fd(int fd) noexcept
+        {
+            linux_syscall(sys_close, fd);
+        }
+    }
+
+
+    // mapped_file
+    // Constructors implementations
+    mapped_file::mapped_file() noexcept : m_data(nullptr), m_size(0), m_open(false)
+    {
+    }
+
+    mapped_file::mapped_file(const char* path, access_hint hint) noexcept : mapped_file()
+    {
+        open(path, hint);
+    }
+
+    mapped_file::mapped_file(mapped_file&& other) noexcept : mapped_file()
+    {
+        swap(other);
+    }
+
+    // Destructor
+    mapped_file::~mapped_file()
+    {
+        close();
+    }
+
+    // Operators
+    mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+    {
+        mapped_file(move(other)).swap(*this);
+        return *this;
+    }
+
+    mapped_file::operator bool() const noexcept
+    {
+        return m_open;
+    }
+
+    // Member functions
+    bool mapped_file::open(const char* path, access_hint hint) noexcept
+    {
+        const int fd = detail::open_read_only(path);
+        if (fd < 0)
+            return false;
+
+        // The mapping keeps the file referenced, the descriptor is not needed past this point.
+        const bool result = open_fd(fd, hint);
+        detail::close_fd(fd);
+        return result;
+    }
+
+    bool mapped_file::open_fd(int fd, access_hint hint) noexcept
+    {
+        close();
+
+        detail::kernel_stat status{};
+        if (detail::linux_syscall(detail::sys_fstat, fd, reinterpret_cast<long>(&status)) < 0)
+            return false;
+
+        if ((status.st_mode & detail::s_ifmt) != detail::s_ifreg)
+            return false;
+
+        // mmap rejects empty lengths, an empty file is simply an empty view.
+        if (status.st_size > 0)
+        {
+            const long address = detail::linux_syscall(detail::sys_mmap, 0, status.st_size, detail::prot_read,
+                                                       detail::map_private_populate, fd, 0);
+            if (address < 0 && address > -4096)
+                return false;
+
+            if (hint != access_hint::normal)
+            {
+                const long advice = hint == access_hint::sequential ? detail::madv_sequential : detail::madv_random;
+                detail::linux_syscall(detail::sys_madvise, address, status.st_size, advice);
+            }
+
+            m_data = reinterpret_cast<const char*>(address);
+            m_size = static_cast<size_t>(status.st_size);
+        }
+
+        m_open = true;
+        return true;
+    }
+
+    void mapped_file::close() noexcept
+    {
+        if (m_data)
+            detail::linux_syscall(detail::sys_munmap, reinterpret_cast<long>(m_data), static_cast<long>(m_size));
+
+        m_data = nullptr;
+        m_size = 0;
+        m_open = false;
+    }
+
+    void mapped_file::swap(mapped_file& other) noexcept
+    {
+        const char* data = m_data;
+        m_data = other.m_data;
+        other.m_data = data;
+
+        size_t size = m_size;
+        m_size = other.m_size;
+        other.m_size = size;
+
+        bool open = m_open;
+        m_open = other.m_open;
+        other.m_open = open;
+    }
+
+    bool mapped_file::is_open() const noexcept
+    {
+        return m_open;
+    }
+
+    span<const char> mapped_file::bytes() const noexcept
+    {
+        return span<const char>(m_data, m_size);
+    }
+
+    string_view mapped_file::view() const noexcept
+    {
+        return string_view(m_data, m_size);
+    }
+
+    size_t mapped_file::size() const noexcept
+    {
+        return m_size;
+    }
+
+
+    // chunked_reader
+    // Constructors implementations
+    chunked_reader::chunked_reader(int fd, span<char> buffer) noexcept : m_fd(fd), m_buffer(buffer), m_failed(false)
+    {
+    }
+
+    // Member functions
+    span<const char> chunked_reader::next() noexcept
+    {
+        if (m_failed || m_buffer.empty())
+            return {};
+
+        long count;
+        do
+        {
+            count = detail::linux_syscall(detail::sys_read, m_fd, reinterpret_cast<long>(m_buffer.data()),
+                                          static_cast<long>(m_buffer.size()));
+        } while (count == -detail::eintr);
+
+        if (count < 0)
+        {
+            m_failed = true;
+            return {};
+        }
+
+        return span<const char>(m_buffer.data(), static_cast<size_t>(count));
+    }
+
+    bool chunked_reader::failed() const noexcept
+    {
+        return m_failed;
+    }
+
+
+    // file_input
+    // Constructors implementations
+    file_input::file_input(span<char> fallback_buffer) noexcept : m_buffer(fallback_buffer), m_fd(-1), m_owns_fd(false)
+    {
+    }
+
+    // Destructor
+    file_input::~file_input()
+    {
+        close();
+    }
+
+    // Member functions
+    bool file_input::open(const char* path, access_hint hint) noexcept
+    {
+        close();
+
+        const int fd = detail::open_read_only(path);
+        if (fd < 0)
+            return false;
+
+        if (m_mapping.open_fd(fd, hint))
+        {
+            detail::close_fd(fd);
+            return true;
+        }
+
+        m_fd = fd;
+        m_owns_fd = true;
+        return true;
+    }
+
+    bool file_input::open_fd(int fd, access_hint hint) noexcept
+    {
+        close();
+
+        if (fd < 0)
+            return false;
+
+        if (m_mapping.open_fd(fd, hint))
+            return true;
+
+        // Not mappable: read through the descriptor, provided it is an open one.
+        detail::kernel_stat status{};
+        if (detail::linux_syscall(detail::sys_fstat, fd, reinterpret_cast<long>(&status)) < 0)
+            return false;
+
+        m_fd = fd;
+        return true;
+    }
+
+    void file_input::close() noexcept
+    {
+        m_mapping.close();
+
+        if (m_owns_fd)
+            detail::close_fd(m_fd);
+
+        m_fd = -1;
+        m_owns_fd = false;
+    }
+
+    bool file_input::is_mapped() const noexcept
+    {
+        return m_mapping.is_open();
+    }
+}
+
+#endif
@@ -0,0 +1,262 @@
+#include "object_pool.hpp"
+#include "new.hpp"
+#include "utility.hpp"
+#include "section.hpp"
+#include "thread_local.hpp"
+
+
+namespace std
+{
+    namespace detail
+    {
+        inline constexpr uint32_t pool_unassigned_thread = static_cast<uint32_t>(-1);
+        inline constexpr size_t pool_block_header = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+        // Thread indices are shared by every pool and never recycled.
+        uint32_t pool_thread_count = 0;
+        STL_THREAD_LOCAL uint32_t pool_thread_index = pool_unassigned_thread;
+
+        uint32_t pool_current_thread() noexcept
+        {
+            if (pool_thread_index == pool_unassigned_thread)
+                pool_thread_index = __atomic_fetch_add(&pool_thread_count, 1, __ATOMIC_RELAXED);
+
+            return pool_thread_index;
+        }
+
+        // The tag takes the top 16 bits, the pointer is sign extended back from the low 48.
+        constexpr uint64_t pool_pack(void* node, uint64_t tag) noexcept
+        {
+            return (tag << 48) | (reinterpret_cast<uintptr_t>(node) & 0xFFFF'FFFF'FFFFull);
+        }
+
+        inline void* pool_unpack(uint64_t head) noexcept
+        {
+            return reinterpret_cast<void*>(static_cast<int64_t>(head << 16) >> 16);
+        }
+
+        inline void*& pool_link(void* node) noexcept
+        {
+            return *static_cast<void**>(node);
+        }
+
+        void pool_stack::push(void* node) noexcept
+        {
+            uint64_t head = __atomic_load_n(&m_head, __ATOMIC_RELAXED);
+            uint64_t desired;
+
+            do
+            {
+                __atomic_store_n(&pool_link(node), pool_unpack(head), __ATOMIC_RELAXED);
+                desired = pool_pack(node, (head >> 48) + 1);
+            } while (!__atomic_compare_exchange_n(&m_head, &head, desired, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+        }
+
+        void* pool_stack::pop() noexcept
+        {
+            uint64_t head = __atomic_load_n(&m_head, __ATOMIC_ACQUIRE);
+            uint64_t desired;
+            void* node;
+
+            do
+            {
+                node = pool_unpack(head);
+                if (!node)
+                    return nullptr;
+
+                // The node may already belong to another thread, in which case the link read
+                // here is stale and the tag makes the CAS fail. Nodes are never unmapped while
+                // the pool lives, so the read itself is always safe.
+                void* next = __atomic_load_n(&pool_link(node), __ATOMIC_RELAXED);
+                desired = pool_pack(next, (head >> 48) + 1);
+            } while (!__atomic_compare_exchange_n(&m_head, &head, desired, true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+            return node;
+        }
+
+
+        // Constructors implementations
+        object_pool_base::object_pool_base(size_t object_size) noexcept
+            : m_object_size(object_size), m_full(), m_empty(), m_loose(), m_blocks(nullptr), m_caches{},
+              m_shared{}, m_shared_lock(false)
+        {
+        }
+
+        // Destructor
+        object_pool_base::~object_pool_base()
+        {
+            void* block = m_blocks;
+
+            while (block)
+            {
+                void* next = pool_link(block);
+                ::operator delete(block);
+                block = next;
+            }
+        }
+
+        // Member functions
+        STL_HOT void* object_pool_base::allocate() noexcept
+        {
+            pool_thread_cache* cache = lock_cache();
+            pool_magazine* loaded = cache->loaded;
+            void* object;
+
+            if (loaded && loaded->count)
+                object = loaded->objects[--loaded->count];
+            else
+                object = allocate_slow(*cache);
+
+            unlock_cache(cache);
+            return object;
+        }
+
+        STL_HOT void object_pool_base::deallocate(void* object) noexcept
+        {
+            if (!object)
+                return;
+
+            pool_thread_cache* cache = lock_cache();
+            pool_magazine* loaded = cache->loaded;
+
+            if (loaded && loaded->count < pool_magazine_capacity)
+                loaded->objects[loaded->count++] = object;
+            else
+                deallocate_slow(*cache, object);
+
+            unlock_cache(cache);
+        }
+
+        void object_pool_base::flush() noexcept
+        {
+            pool_thread_cache* cache = lock_cache();
+
+            pool_magazine* magazines[] = { cache->loaded, cache->previous };
+            for (pool_magazine* magazine : magazines)
+            {
+                if (magazine)
+                    (magazine->count ? m_full : m_empty).push(magazine);
+            }
+
+            cache->loaded = nullptr;
+            cache->previous = nullptr;
+            unlock_cache(cache);
+        }
+
+        pool_thread_cache* object_pool_base::lock_cache() noexcept
+        {
+            const uint32_t thread = pool_current_thread();
+            if (thread < pool_max_threads)
+                return &m_caches[thread];
+
+            while (__atomic_exchange_n(&m_shared_lock, true, __ATOMIC_ACQUIRE))
+            {
+                while (__atomic_load_n(&m_shared_lock, __ATOMIC_RELAXED))
+                    __builtin_ia32_pause();
+            }
+
+            return &m_shared;
+        }
+
+        void object_pool_base::unlock_cache(pool_thread_cache* cache) noexcept
+        {
+            if (cache == &m_shared)
+                __atomic_store_n(&m_shared_lock, false, __ATOMIC_RELEASE);
+        }
+
+        void* object_pool_base::allocate_slow(pool_thread_cache& cache) noexcept
+        {
+            // The previous magazine still has objects: make it the loaded one.
+            if (cache.previous && cache.previous->count)
+            {
+                swap(cache.loaded, cache.previous);
+                return cache.loaded->objects[--cache.loaded->count];
+            }
+
+            pool_magazine* full = static_cast<pool_magazine*>(m_full.pop());
+            if (!full)
+            {
+                if (void* object = m_loose.pop())
+                    return object;
+
+                full = fill_from_block();
+                if (!full)
+                    return nullptr;
+            }
+
+            // Both magazines are empty here. Keep one around for the frees to come, and trade
+            // the other one for the full magazine.
+            if (cache.previous)
+                m_empty.push(cache.previous);
+
+            cache.previous = cache.loaded;
+            cache.loaded = full;
+            return full->objects[--full->count];
+        }
+
+        void object_pool_base::deallocate_slow(pool_thread_cache& cache, void* object) noexcept
+        {
+            if (cache.previous && cache.previous->count < pool_magazine_capacity)
+            {
+                swap(cache.loaded, cache.previous);
+                cache.loaded->objects[cache.loaded->count++] = object;
+                return;
+            }
+
+            pool_magazine* empty = static_cast<pool_magazine*>(m_empty.pop());
+            if (!empty)
+            {
+                empty = static_cast<pool_magazine*>(allocate_block(sizeof(pool_magazine)));
+                if (!empty)
+                {
+                    m_loose.push(object);
+                    return;
+                }
+            }
+
+            // Both magazines are full (or missing): the older one goes to the depot.
+            if (cache.previous)
+                m_full.push(cache.previous);
+
+            empty->count = 0;
+            cache.previous = cache.loaded;
+            cache.loaded = empty;
+            empty->objects[empty->count++] = object;
+        }
+
+        // Carves a fresh block into one magazine worth of objects, stored right after it.
+        pool_magazine* object_pool_base::fill_from_block() noexcept
+        {
+            constexpr size_t objects_offset = (sizeof(pool_magazine) + pool_block_header - 1) & ~(pool_block_header - 1);
+
+            char* block = static_cast<char*>(allocate_block(objects_offset + pool_magazine_capacity * m_object_size));
+            if (!block)
+                return nullptr;
+
+            pool_magazine* magazine = reinterpret_cast<pool_magazine*>(block);
+            magazine->next = nullptr;
+            magazine->count = pool_magazine_capacity;
+
+            // Reversed, so that the objects are handed out in address order.
+            for (size_t i = 0; i < pool_magazine_capacity; ++i)
+                magazine->objects[pool_magazine_capacity - 1 - i] = block + objects_offset + i * m_object_size;
+
+            return magazine;
+        }
+
+        void* object_pool_base::allocate_block(size_t size) noexcept
+        {
+            char* block = static_cast<char*>(::operator new(pool_block_header + size, nothrow));
+            if (!block)
+                return nullptr;
+
+            void* head = __atomic_load_n(&m_blocks, __ATOMIC_RELAXED);
+            do
+            {
+                pool_link(block) = head;
+            } while (!__atomic_compare_exchange_n(&m_blocks, &head, block, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+            return block + pool_block_header;
+        }
+    }
+}
@@ -0,0 +1,17 @@
+#include "perfect_hash.hpp"
+
+
+namespace std
+{
+    namespace detail
+    {
+        // Not constexpr: reaching either one during constant evaluation is the compile error.
+        void perfect_hash_duplicate_key() noexcept
+        {
+        }
+
+        void perfect_hash_no_displacement_found() noexcept
+        {
+        }
+    }
+}
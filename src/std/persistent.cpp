@@ -0,0 +1,29 @@
+#include "persistent.hpp"
+
+
+namespace std
+{
+    namespace detail
+    {
+        void persistent_retain(persistent_node* node) noexcept
+        {
+            __atomic_fetch_add(&node->references, 1, __ATOMIC_RELAXED);
+        }
+
+        bool persistent_release(persistent_node* node) noexcept
+        {
+            // The only reference cannot be taken again by anybody else: no atomic write needed,
+            // which saves it on every node a transient lets go of.
+            if (__atomic_load_n(&node->references, __ATOMIC_ACQUIRE) == 1)
+                return true;
+
+            return __atomic_sub_fetch(&node->references, 1, __ATOMIC_ACQ_REL) == 0;
+        }
+
+        bool persistent_unique(const persistent_node* node) noexcept
+        {
+            // Acquire: what the other owners did with the node happened before they let go of it.
+            return __atomic_load_n(&node->references, __ATOMIC_ACQUIRE) == 1;
+        }
+    }
+}
@@ -0,0 +1,373 @@
+#include "reclamation.hpp"
+#include "thread_local.hpp"
+#include "utility.hpp"
+
+
+namespace std
+{
+    namespace detail
+    {
+        inline constexpr uint32_t reclaim_unassigned_thread = static_cast<uint32_t>(-1);
+
+        uint32_t reclaim_thread_count = 0;
+        STL_THREAD_LOCAL uint32_t reclaim_thread_index = reclaim_unassigned_thread;
+
+        // Index of the calling thread's records, reclaim_max_threads for the shared ones.
+        uint32_t reclaim_current_thread() noexcept
+        {
+            if (reclaim_thread_index == reclaim_unassigned_thread)
+                reclaim_thread_index = __atomic_fetch_add(&reclaim_thread_count, 1, __ATOMIC_RELAXED);
+
+            return reclaim_thread_index < reclaim_max_threads ? reclaim_thread_index : reclaim_max_threads;
+        }
+
+        void reclaim_lock(uint32_t& lock) noexcept
+        {
+            while (__atomic_exchange_n(&lock, 1u, __ATOMIC_ACQUIRE))
+            {
+                while (__atomic_load_n(&lock, __ATOMIC_RELAXED))
+                    __builtin_ia32_pause();
+            }
+        }
+
+        void reclaim_unlock(uint32_t& lock) noexcept
+        {
+            __atomic_store_n(&lock, 0u, __ATOMIC_RELEASE);
+        }
+
+        // Runs the deleters of a detached list. Called with no lock held, since a deleter may
+        // retire more nodes.
+        void reclaim_list(retired_node* node) noexcept
+        {
+            while (node)
+            {
+                retired_node* const next = node->next;
+                node->reclaim(node);
+                node = next;
+            }
+        }
+
+
+        /// Epochs
+        // Classic three epoch scheme (Fraser): the global epoch only moves from e to e + 1 once
+        // every thread inside a guard has announced e, so when it reaches e + 2 nobody can
+        // still hold a node retired during e.
+        inline constexpr size_t epoch_batch = 64;
+        inline constexpr uint64_t epoch_nesting_mask = 0xFFFF'FFFFull;
+
+        struct alignas(reclaim_cache_line) epoch_record
+        {
+            uint64_t state;             // announced epoch << 32 | guard nesting, 0 nesting when outside
+            retired_node* limbo[3];     // nodes retired during epoch e go to limbo[e % 3]
+            uint32_t limbo_epoch[3];
+            size_t retired;
+            uint32_t lock;              // only taken on the shared record
+        };
+
+        uint32_t epoch_global = 0;
+        epoch_record epoch_records[reclaim_max_threads + 1];
+
+        uint32_t epoch_try_advance() noexcept
+        {
+            uint32_t global = __atomic_load_n(&epoch_global, __ATOMIC_ACQUIRE);
+            for (const epoch_record& record : epoch_records)
+            {
+                const uint64_t state = __atomic_load_n(&record.state, __ATOMIC_ACQUIRE);
+                if ((state & epoch_nesting_mask) != 0 && static_cast<uint32_t>(state >> 32) != global)
+                    return global;
+            }
+
+            __atomic_compare_exchange_n(&epoch_global, &global, global + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+            return __atomic_load_n(&epoch_global, __ATOMIC_ACQUIRE);
+        }
+
+        // Detaches the lists of record retired two epochs or more before global.
+        retired_node* epoch_collect(epoch_record& record, uint32_t global) noexcept
+        {
+            retired_node* collected = nullptr;
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                if (!record.limbo[i] || global - record.limbo_epoch[i] < 2)
+                    continue;
+
+                retired_node* tail = record.limbo[i];
+                size_t count = 1;
+                for (; tail->next; tail = tail->next)
+                    ++count;
+
+                tail->next = collected;
+                collected = record.limbo[i];
+                record.limbo[i] = nullptr;
+                record.retired -= count;
+            }
+            return collected;
+        }
+
+        void epoch_retire(retired_node* node) noexcept
+        {
+            const uint32_t thread = reclaim_current_thread();
+            epoch_record& record = epoch_records[thread];
+            if (thread == reclaim_max_threads)
+                reclaim_lock(record.lock);
+
+            uint32_t global = __atomic_load_n(&epoch_global, __ATOMIC_ACQUIRE);
+            retired_node* collected = epoch_collect(record, global);
+
+            // limbo[global % 3] is empty or still collecting global: anything older sharing the
+            // slot was three epochs back and has just been collected.
+            retired_node*& limbo = record.limbo[global % 3];
+            node->next = limbo;
+            limbo = node;
+            record.limbo_epoch[global % 3] = global;
+
+            if (++record.retired >= epoch_batch)
+            {
+                global = epoch_try_advance();
+                retired_node* const freed = epoch_collect(record, global);
+                if (freed)
+                {
+                    retired_node* tail = freed;
+                    while (tail->next)
+                        tail = tail->next;
+                    tail->next = collected;
+                    collected = freed;
+                }
+            }
+
+            if (thread == reclaim_max_threads)
+                reclaim_unlock(record.lock);
+
+            reclaim_list(collected);
+        }
+
+
+        /// Hazard pointers
+        // A thread scans the published pointers once its list holds hazard_scan_threshold
+        // nodes; at most hazard_max_slots of them survive a scan, so the scans cost O(1) per
+        // retired node and each thread holds less than threshold + slots nodes.
+        inline constexpr size_t hazard_max_slots = 4 * reclaim_max_threads;
+        inline constexpr size_t hazard_scan_threshold = 2 * hazard_max_slots;
+        inline constexpr size_t hazard_set_size = 2 * hazard_max_slots;
+
+        struct alignas(reclaim_cache_line) hazard_slot
+        {
+            const void* pointer;    // must stay the first member, hazard_pointer points at it
+            uint32_t owned;
+        };
+
+        struct alignas(reclaim_cache_line) hazard_record
+        {
+            retired_node* head;
+            size_t retired;
+            uint32_t lock;          // only taken on the shared record
+        };
+
+        hazard_slot hazard_slots[hazard_max_slots];
+        hazard_record hazard_records[reclaim_max_threads + 1];
+
+        size_t hazard_set_index(const void* pointer) noexcept
+        {
+            return static_cast<size_t>((reinterpret_cast<uintptr_t>(pointer) >> 4) * 0x9E3779B97F4A7C15ull >> 32) & (hazard_set_size - 1);
+        }
+
+        // Splits the record's list into the nodes still protected, kept, and the others,
+        // returned to be freed.
+        retired_node* hazard_scan(hazard_record& record) noexcept
+        {
+            // Pairs with the store in hazard_pointer::try_protect: a pointer published before
+            // the node was unlinked is seen here.
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+            const void* protected_set[hazard_set_size] = {};
+            for (const hazard_slot& slot : hazard_slots)
+            {
+                const void* pointer = __atomic_load_n(&slot.pointer, __ATOMIC_ACQUIRE);
+                if (!pointer)
+                    continue;
+
+                size_t index = hazard_set_index(pointer);
+                while (protected_set[index] && protected_set[index] != pointer)
+                    index = (index + 1) & (hazard_set_size - 1);
+                protected_set[index] = pointer;
+            }
+
+            retired_node* kept = nullptr;
+            retired_node* freed = nullptr;
+            size_t kept_count = 0;
+            for (retired_node* node = record.head; node;)
+            {
+                retired_node* const next = node->next;
+
+                size_t index = hazard_set_index(node->object);
+                while (protected_set[index] && protected_set[index] != node->object)
+                    index = (index + 1) & (hazard_set_size - 1);
+
+                if (protected_set[index])
+                {
+                    node->next = kept;
+                    kept = node;
+                    ++kept_count;
+                }
+                else
+                {
+                    node->next = freed;
+                    freed = node;
+                }
+                node = next;
+            }
+
+            record.head = kept;
+            record.retired = kept_count;
+            return freed;
+        }
+
+        void hazard_retire(retired_node* node) noexcept
+        {
+            const uint32_t thread = reclaim_current_thread();
+            hazard_record& record = hazard_records[thread];
+            if (thread == reclaim_max_threads)
+                reclaim_lock(record.lock);
+
+            node->next = record.head;
+            record.head = node;
+
+            retired_node* freed = nullptr;
+            if (++record.retired >= hazard_scan_threshold)
+                freed = hazard_scan(record);
+
+            if (thread == reclaim_max_threads)
+                reclaim_unlock(record.lock);
+
+            reclaim_list(freed);
+        }
+    }
+
+
+    // epoch_guard
+    // Constructors implementations
+    epoch_guard::epoch_guard() noexcept : m_state(&detail::epoch_records[detail::reclaim_current_thread()].state)
+    {
+        // Entering announces the current epoch, nesting only counts. The CAS is also the full
+        // barrier that orders the announcement before the reads the guard covers.
+        uint64_t state = __atomic_load_n(m_state, __ATOMIC_RELAXED);
+        uint64_t entered;
+        do
+        {
+            if ((state & detail::epoch_nesting_mask) == 0)
+                entered = (static_cast<uint64_t>(__atomic_load_n(&detail::epoch_global, __ATOMIC_ACQUIRE)) << 32) | 1;
+            else
+                entered = state + 1;
+        } while (!__atomic_compare_exchange_n(m_state, &state, entered, true, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+    }
+
+    // Destructor implementation
+    epoch_guard::~epoch_guard()
+    {
+        __atomic_fetch_sub(m_state, 1, __ATOMIC_RELEASE);
+    }
+
+
+    // Functions
+    void epoch_synchronize() noexcept
+    {
+        const uint32_t target = __atomic_load_n(&detail::epoch_global, __ATOMIC_ACQUIRE) + 2;
+        uint32_t global = detail::epoch_try_advance();
+        while (static_cast<int32_t>(global - target) < 0)
+        {
+            __builtin_ia32_pause();
+            global = detail::epoch_try_advance();
+        }
+
+        const uint32_t thread = detail::reclaim_current_thread();
+        detail::epoch_record& record = detail::epoch_records[thread];
+        if (thread == detail::reclaim_max_threads)
+            detail::reclaim_lock(record.lock);
+
+        detail::retired_node* const collected = detail::epoch_collect(record, global);
+
+        if (thread == detail::reclaim_max_threads)
+            detail::reclaim_unlock(record.lock);
+
+        detail::reclaim_list(collected);
+    }
+
+
+    // hazard_pointer
+    // Constructors implementations
+    hazard_pointer::hazard_pointer() noexcept : m_slot(nullptr)
+    {
+    }
+
+    hazard_pointer::hazard_pointer(const void** slot) noexcept : m_slot(slot)
+    {
+    }
+
+    hazard_pointer::hazard_pointer(hazard_pointer&& other) noexcept : m_slot(other.m_slot)
+    {
+        other.m_slot = nullptr;
+    }
+
+    // Destructor implementation
+    hazard_pointer::~hazard_pointer()
+    {
+        if (!m_slot)
+            return;
+
+        __atomic_store_n(m_slot, nullptr, __ATOMIC_RELEASE);
+        __atomic_store_n(&reinterpret_cast<detail::hazard_slot*>(m_slot)->owned, 0u, __ATOMIC_RELEASE);
+    }
+
+    // Operators
+    hazard_pointer& hazard_pointer::operator=(hazard_pointer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            this->~hazard_pointer();
+            m_slot = other.m_slot;
+            other.m_slot = nullptr;
+        }
+        return *this;
+    }
+
+    // Member functions
+    bool hazard_pointer::empty() const noexcept
+    {
+        return m_slot == nullptr;
+    }
+
+    void hazard_pointer::reset_protection(nullptr_t) noexcept
+    {
+        __atomic_store_n(m_slot, nullptr, __ATOMIC_RELEASE);
+    }
+
+
+    // Functions
+    hazard_pointer make_hazard_pointer() noexcept
+    {
+        // Start at the calling thread's own group of slots, which it most likely freed last.
+        const size_t first = detail::reclaim_current_thread() * 4 % detail::hazard_max_slots;
+        for (size_t i = 0; i < detail::hazard_max_slots; ++i)
+        {
+            detail::hazard_slot& slot = detail::hazard_slots[(first + i) % detail::hazard_max_slots];
+            uint32_t owned = __atomic_load_n(&slot.owned, __ATOMIC_RELAXED);
+            if (owned == 0 && __atomic_compare_exchange_n(&slot.owned, &owned, 1u, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                return hazard_pointer(&slot.pointer);
+        }
+        return hazard_pointer();
+    }
+
+    void hazard_pointer_clean_up() noexcept
+    {
+        const uint32_t thread = detail::reclaim_current_thread();
+        detail::hazard_record& record = detail::hazard_records[thread];
+        if (thread == detail::reclaim_max_threads)
+            detail::reclaim_lock(record.lock);
+
+        detail::retired_node* const freed = detail::hazard_scan(record);
+
+        if (thread == detail::reclaim_max_threads)
+            detail::reclaim_unlock(record.lock);
+
+        detail::reclaim_list(freed);
+    }
+}
@@ -0,0 +1,32 @@
+#include "regex.hpp"
+
+
+namespace std
+{
+    namespace detail
+    {
+        void regex_unbalanced_parenthesis() noexcept
+        {
+        }
+
+        void regex_invalid_escape() noexcept
+        {
+        }
+
+        void regex_invalid_class() noexcept
+        {
+        }
+
+        void regex_invalid_quantifier() noexcept
+        {
+        }
+
+        void regex_unsupported_syntax() noexcept
+        {
+        }
+
+        void regex_too_many_states() noexcept
+        {
+        }
+    }
+}
@@ -0,0 +1,386 @@
+#include "searcher.hpp"
+#include "bit.hpp"
+#include "cpu_features.hpp"
+#include "new.hpp"
+#include "section.hpp"
+#include "utility.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace std
+{
+    namespace detail
+    {
+        constexpr size_t search_npos = string_view::npos;
+
+        // Bytes of the needle still to compare once its first and last byte matched.
+        constexpr size_t middle_length(size_t length) noexcept
+        {
+            return length < 2 ? 0 : length - 2;
+        }
+
+        size_t find_short_scalar(const char* haystack, size_t size, const char* needle, size_t length) noexcept
+        {
+            if (length > size)
+                return search_npos;
+
+            const char first = needle[0];
+            for (size_t i = 0; i + length <= size; ++i)
+            {
+                if (haystack[i] == first && __builtin_memcmp(haystack + i + 1, needle + 1, length - 1) == 0)
+                    return i;
+            }
+            return search_npos;
+        }
+
+#if defined(__SSE2__)
+        // Each lane is a candidate position: lane i of the first vector holds haystack[index + i],
+        // lane i of the second haystack[index + i + length - 1], so one AND of two comparisons
+        // keeps only the positions where the needle can start.
+        size_t find_short_sse2(const char* haystack, size_t size, const char* needle, size_t length) noexcept
+        {
+            if (length > size)
+                return search_npos;
+
+            const __m128i first = _mm_set1_epi8(needle[0]);
+            const __m128i last = _mm_set1_epi8(needle[length - 1]);
+            const size_t middle = middle_length(length);
+
+            size_t index = 0;
+            for (; index + length - 1 + 16 <= size; index += 16)
+            {
+                const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + index));
+                const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + index + length - 1));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+
+                while (mask != 0)
+                {
+                    const size_t candidate = index + countr_zero(mask);
+                    if (__builtin_memcmp(haystack + candidate + 1, needle + 1, middle) == 0)
+                        return candidate;
+                    mask &= mask - 1;
+                }
+            }
+
+            const size_t rest = find_short_scalar(haystack + index, size - index, needle, length);
+            return rest == search_npos ? search_npos : index + rest;
+        }
+#endif
+
+#if defined(__x86_64__)
+        STL_TARGET("avx2") size_t find_short_avx2(const char* haystack, size_t size, const char* needle, size_t length) noexcept
+        {
+            if (length > size)
+                return search_npos;
+
+            const __m256i first = _mm256_set1_epi8(needle[0]);
+            const __m256i last = _mm256_set1_epi8(needle[length - 1]);
+            const size_t middle = middle_length(length);
+
+            size_t index = 0;
+            for (; index + length - 1 + 32 <= size; index += 32)
+            {
+                const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + index));
+                const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + index + length - 1));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+
+                while (mask != 0)
+                {
+                    const size_t candidate = index + countr_zero(mask);
+                    if (__builtin_memcmp(haystack + candidate + 1, needle + 1, middle) == 0)
+                        return candidate;
+                    mask &= mask - 1;
+                }
+            }
+
+            const size_t rest = find_short_sse2(haystack + index, size - index, needle, length);
+            return rest == search_npos ? search_npos : index + rest;
+        }
+#endif
+
+#if defined(__x86_64__) && !defined(__AVX2__)
+        // The build cannot assume AVX2, the search picks it at run time.
+        using find_short_kernel = cpu_dispatch<size_t(const char*, size_t, const char*, size_t)>;
+
+        const find_short_kernel::variant find_short_variants[] =
+        {
+            { cpu_feature::avx2, &find_short_avx2 },
+            { {}, &find_short_sse2 }
+        };
+
+        find_short_kernel find_short_dispatch(find_short_variants);
+#endif
+
+        // needle is not empty.
+        STL_HOT size_t find_short(const char* haystack, size_t size, const char* needle, size_t length) noexcept
+        {
+#if defined(__AVX2__)
+            return find_short_avx2(haystack, size, needle, length);
+#elif defined(__x86_64__)
+            return find_short_dispatch(haystack, size, needle, length);
+#elif defined(__SSE2__)
+            return find_short_sse2(haystack, size, needle, length);
+#else
+            return find_short_scalar(haystack, size, needle, length);
+#endif
+        }
+
+        // Boyer-Moore-Horspool: the haystack byte under the needle's last position tells how far
+        // the needle can move before that byte lines up with an equal one in the needle.
+        size_t find_horspool(const char* haystack, size_t size, const char* needle, size_t length, const uint32_t (&shift)[256]) noexcept
+        {
+            const size_t last = length - 1;
+            const uint8_t last_byte = static_cast<uint8_t>(needle[last]);
+
+            size_t index = 0;
+            while (index + length <= size)
+            {
+                const uint8_t byte = static_cast<uint8_t>(haystack[index + last]);
+                if (byte == last_byte && __builtin_memcmp(haystack + index, needle, last) == 0)
+                    return index;
+                index += shift[byte];
+            }
+            return search_npos;
+        }
+    }
+
+
+    // Functions
+    size_t find_substring(string_view haystack, string_view needle, size_t from) noexcept
+    {
+        if (from > haystack.size())
+            return string_view::npos;
+        if (needle.empty())
+            return from;
+
+        const size_t found = detail::find_short(haystack.data() + from, haystack.size() - from, needle.data(), needle.size());
+        return found == string_view::npos ? found : from + found;
+    }
+
+
+    // substring_searcher
+    // Constructors implementations
+    substring_searcher::substring_searcher(string_view needle) noexcept : m_needle(needle), m_shift{}
+    {
+        const size_t length = needle.size();
+        if (length < horspool_threshold)
+            return;
+
+        for (uint32_t& shift : m_shift)
+            shift = static_cast<uint32_t>(length);
+        for (size_t i = 0; i + 1 < length; ++i)
+            m_shift[static_cast<uint8_t>(needle[i])] = static_cast<uint32_t>(length - 1 - i);
+    }
+
+    // Member functions
+    size_t substring_searcher::find(string_view haystack, size_t from) const noexcept
+    {
+        if (m_needle.size() < horspool_threshold)
+            return find_substring(haystack, m_needle, from);
+        if (from > haystack.size())
+            return string_view::npos;
+
+        const size_t found = detail::find_horspool(haystack.data() + from, haystack.size() - from, m_needle.data(), m_needle.size(), m_shift);
+        return found == string_view::npos ? found : from + found;
+    }
+
+    string_view substring_searcher::needle() const noexcept
+    {
+        return m_needle;
+    }
+
+
+    // aho_corasick
+    // Constructors implementations
+    STL_COLD aho_corasick::aho_corasick(span<const string_view> patterns)
+        : m_block(nullptr), m_transitions(nullptr), m_outputs(nullptr), m_output_links(nullptr), m_lengths(nullptr),
+          m_state_count(0), m_class_count(0), m_first_output_row(0), m_pattern_count(patterns.size()), m_classes{}
+    {
+        // Byte classes: every byte used by some pattern gets its own column, all the others
+        // share column 0 (which is then the first used byte's when they are all used).
+        bool used[256] = {};
+        size_t used_count = 0;
+        size_t max_states = 1;
+        for (const string_view pattern : patterns)
+        {
+            for (const char ch : pattern)
+            {
+                used_count += !used[static_cast<uint8_t>(ch)];
+                used[static_cast<uint8_t>(ch)] = true;
+            }
+            max_states += pattern.size();
+        }
+
+        uint32_t class_count = used_count == 256 ? 0 : 1;
+        for (size_t byte = 0; byte < 256; ++byte)
+        {
+            if (used[byte])
+                m_classes[byte] = static_cast<uint8_t>(class_count++);
+        }
+
+        // Build tables, indexed by the states' trie numbers.
+        const size_t table_size = max_states * class_count;
+        uint32_t* build = static_cast<uint32_t*>(::operator new((table_size + max_states * 5) * sizeof(uint32_t), nothrow));
+        if (!build)
+            return;
+
+        uint32_t* next = build;
+        uint32_t* fail = next + table_size;
+        uint32_t* output = fail + max_states;
+        uint32_t* link = output + max_states;
+        uint32_t* order = link + max_states;
+        uint32_t* renumbered = order + max_states;
+        __builtin_memset(build, 0, (table_size + max_states * 3) * sizeof(uint32_t));
+
+        // The trie, 0 standing for "no edge" since no edge leads back to the root.
+        uint32_t state_count = 1;
+        for (size_t p = 0; p < patterns.size(); ++p)
+        {
+            if (patterns[p].empty())
+                continue;
+
+            uint32_t state = 0;
+            for (const char ch : patterns[p])
+            {
+                uint32_t& edge = next[state * class_count + m_classes[static_cast<uint8_t>(ch)]];
+                if (edge == 0)
+                    edge = state_count++;
+                state = edge;
+            }
+            if (output[state] == 0)
+                output[state] = static_cast<uint32_t>(p + 1);
+        }
+
+        // Breadth first, so that a state's failure target, which is shallower, is complete
+        // before the state itself: missing edges are then copied from it, which turns the trie
+        // into the full automaton.
+        size_t head = 0;
+        size_t tail = 0;
+        order[tail++] = 0;
+        while (head < tail)
+        {
+            const uint32_t state = order[head++];
+            for (uint32_t c = 0; c < class_count; ++c)
+            {
+                uint32_t& edge = next[state * class_count + c];
+                if (edge == 0)
+                {
+                    edge = state == 0 ? 0 : next[fail[state] * class_count + c];
+                    continue;
+                }
+
+                const uint32_t child = edge;
+                const uint32_t target = state == 0 ? 0 : next[fail[state] * class_count + c];
+                fail[child] = target;
+                link[child] = output[target] != 0 ? target : link[target];
+                order[tail++] = child;
+            }
+        }
+
+        // States that report something go last, the others keep their breadth first order,
+        // which puts the shallow, most visited states together at the start of the table.
+        uint32_t numbered = 0;
+        for (uint32_t i = 0; i < state_count; ++i)
+        {
+            if (output[order[i]] == 0 && link[order[i]] == 0)
+                renumbered[order[i]] = numbered++;
+        }
+        const uint32_t first_output_state = numbered;
+        for (uint32_t i = 0; i < state_count; ++i)
+        {
+            if (output[order[i]] != 0 || link[order[i]] != 0)
+                renumbered[order[i]] = numbered++;
+        }
+
+        const size_t final_size = (static_cast<size_t>(state_count) * (class_count + 2) + patterns.size()) * sizeof(uint32_t);
+        uint32_t* block = static_cast<uint32_t*>(::operator new(final_size, nothrow));
+        if (!block)
+        {
+            ::operator delete(build);
+            return;
+        }
+
+        m_block = block;
+        m_transitions = block;
+        m_outputs = m_transitions + static_cast<size_t>(state_count) * class_count;
+        m_output_links = m_outputs + state_count;
+        m_lengths = m_output_links + state_count;
+        m_state_count = state_count;
+        m_class_count = class_count;
+        m_first_output_row = first_output_state * class_count;
+
+        for (uint32_t state = 0; state < state_count; ++state)
+        {
+            const uint32_t row = renumbered[state];
+            for (uint32_t c = 0; c < class_count; ++c)
+                m_transitions[row * class_count + c] = renumbered[next[state * class_count + c]] * class_count;
+
+            m_outputs[row] = output[state];
+            m_output_links[row] = link[state] != 0 ? renumbered[link[state]] : 0;
+        }
+        for (size_t p = 0; p < patterns.size(); ++p)
+            m_lengths[p] = static_cast<uint32_t>(patterns[p].size());
+
+        ::operator delete(build);
+    }
+
+    aho_corasick::aho_corasick(aho_corasick&& other) noexcept
+        : m_block(other.m_block), m_transitions(other.m_transitions), m_outputs(other.m_outputs), m_output_links(other.m_output_links),
+          m_lengths(other.m_lengths), m_state_count(other.m_state_count), m_class_count(other.m_class_count),
+          m_first_output_row(other.m_first_output_row), m_pattern_count(other.m_pattern_count)
+    {
+        __builtin_memcpy(m_classes, other.m_classes, sizeof(m_classes));
+        other.m_block = nullptr;
+        other.m_transitions = nullptr;
+        other.m_state_count = 0;
+    }
+
+    // Destructor implementation
+    aho_corasick::~aho_corasick()
+    {
+        release();
+    }
+
+    // Operators
+    aho_corasick& aho_corasick::operator=(aho_corasick&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            new (this) aho_corasick(move(other));
+        }
+        return *this;
+    }
+
+    // Member functions
+    STL_HOT aho_corasick::match aho_corasick::find_first(string_view text) const noexcept
+    {
+        match first{ string_view::npos, string_view::npos };
+        find_all(text, [&first](const match& found) noexcept
+        {
+            first = found;
+            return false;
+        });
+        return first;
+    }
+
+    size_t aho_corasick::pattern_count() const noexcept
+    {
+        return m_pattern_count;
+    }
+
+    size_t aho_corasick::state_count() const noexcept
+    {
+        return m_state_count;
+    }
+
+    void aho_corasick::release() noexcept
+    {
+        if (m_block)
+            ::operator delete(m_block);
+        m_block = nullptr;
+        m_transitions = nullptr;
+    }
+}
@@ -0,0 +1,160 @@
+#include "snapshot.hpp"
+#include "functional.hpp"
+#include "new.hpp"
+
+
+namespace std
+{
+    // snapshot_string
+    // Member functions
+    void snapshot_string::assign(const char* data, size_t size) noexcept
+    {
+        m_data = data;
+        m_size = size;
+    }
+
+    string_view snapshot_string::view() const noexcept
+    {
+        return m_data ? string_view(m_data.get(), static_cast<size_t>(m_size)) : string_view();
+    }
+
+    const char* snapshot_string::c_str() const noexcept
+    {
+        return m_data ? m_data.get() : "";
+    }
+
+    size_t snapshot_string::size() const noexcept
+    {
+        return static_cast<size_t>(m_size);
+    }
+
+    bool snapshot_string::empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+
+    // snapshot_traits
+    // Functions
+    void snapshot_traits<string_view>::write(snapshot_writer& writer, string_view value, snapshot_ref<snapshot_string> out) noexcept
+    {
+        const snapshot_ref<char> text = writer.allocate<char>(value.size() + 1);
+        if (!text)
+            return;
+
+        char* destination = writer.get(text);
+        for (size_t i = 0; i < value.size(); ++i)
+            destination[i] = value[i];
+
+        if (snapshot_string* image = writer.get(out))
+            image->assign(writer.get(text), value.size());
+    }
+
+
+    // snapshot_writer
+    // Constructors implementations
+    snapshot_writer::snapshot_writer() noexcept : m_data(nullptr), m_size(0), m_capacity(0), m_failed(false)
+    {
+        // Offset 0 holds the header, which also makes it the null reference.
+        reserve(sizeof(snapshot_header), snapshot_alignment);
+    }
+
+    // Destructor implementation
+    snapshot_writer::~snapshot_writer()
+    {
+        ::operator delete(m_data);
+    }
+
+    // Member functions
+    bool snapshot_writer::failed() const noexcept
+    {
+        return m_failed;
+    }
+
+    uint64_t snapshot_writer::reserve(size_t size, size_t alignment) noexcept
+    {
+        if (m_failed)
+            return 0;
+
+        const size_t offset = (m_size + alignment - 1) & ~(alignment - 1);
+        const size_t end = offset + size;
+
+        if (end > m_capacity)
+        {
+            size_t capacity = m_capacity ? m_capacity : 4096;
+            while (capacity < end)
+                capacity *= 2;
+
+            // operator new returns memory aligned for any fundamental type, and snapshot_alignment
+            // is no more than that.
+            char* data = static_cast<char*>(::operator new(capacity, nothrow));
+            if (!data)
+            {
+                m_failed = true;
+                return 0;
+            }
+
+            if (m_data)
+            {
+                __builtin_memcpy(data, m_data, m_size);
+                ::operator delete(m_data);
+            }
+            m_data = data;
+            m_capacity = capacity;
+        }
+
+        __builtin_memset(m_data + m_size, 0, end - m_size);
+        m_size = end;
+        return offset;
+    }
+
+    span<const char> snapshot_writer::seal(uint64_t root, size_t root_size, uint32_t version) noexcept
+    {
+        if (m_failed || !root)
+            return {};
+
+        // Trailing padding, so that images can be concatenated or mapped after one another.
+        reserve(0, snapshot_alignment);
+        if (m_failed)
+            return {};
+
+        snapshot_header& header = *reinterpret_cast<snapshot_header*>(m_data);
+        header.magic = snapshot_magic;
+        header.format = snapshot_format;
+        header.version = version;
+        header.root_size = static_cast<uint32_t>(root_size);
+        header.size = m_size;
+        header.root = root;
+        header.checksum = detail::hash_bytes(m_data + sizeof(snapshot_header), m_size - sizeof(snapshot_header));
+        header.reserved = 0;
+
+        return span<const char>(m_data, m_size);
+    }
+
+
+    // Functions
+    namespace detail
+    {
+        const void* snapshot_validate(span<const char> image, uint32_t version, size_t root_size, size_t root_alignment) noexcept
+        {
+            if (image.size() < sizeof(snapshot_header) || reinterpret_cast<uintptr_t>(image.data()) % snapshot_alignment)
+                return nullptr;
+
+            const snapshot_header& header = *reinterpret_cast<const snapshot_header*>(image.data());
+            if (header.magic != snapshot_magic || header.format != snapshot_format || header.version != version)
+                return nullptr;
+
+            if (header.root_size != root_size || header.size < sizeof(snapshot_header) || header.size > image.size())
+                return nullptr;
+
+            if (header.root < sizeof(snapshot_header) || header.root % root_alignment || header.root > header.size - root_size)
+                return nullptr;
+
+            const size_t payload = static_cast<size_t>(header.size) - sizeof(snapshot_header);
+            if (hash_bytes(image.data() + sizeof(snapshot_header), payload) != header.checksum)
+                return nullptr;
+
+            return image.data() + header.root;
+        }
+    }
+}
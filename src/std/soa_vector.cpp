@@ -0,0 +1,22 @@
+#include "soa_vector.hpp"
+
+
+namespace std
+{
+    namespace detail
+    {
+        size_t soa_layout(size_t capacity, const size_t* element_sizes, size_t count, size_t* offsets) noexcept
+        {
+            size_t offset = 0;
+
+            for (size_t column = 0; column < count; ++column)
+            {
+                offsets[column] = offset;
+                offset += capacity * element_sizes[column];
+                offset = (offset + soa_column_alignment - 1) & ~(soa_column_alignment - 1);
+            }
+
+            return offset;
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#include "startup.hpp"
+#include "trace.hpp"
+
+
+// Bounds defined by parser.ld
+extern "C"
+{
+    using stl_init_function = void (*)();
+
+    extern stl_init_function __init_array_start[];
+    extern stl_init_function __init_array_end[];
+    extern stl_init_function __ctors_start[];
+    extern stl_init_function __ctors_end[];
+    extern stl_init_function __crt_xc_start[];
+    extern stl_init_function __crt_xc_end[];
+    extern stl_init_function __crt_xt_start[];
+    extern stl_init_function __crt_xt_end[];
+    extern stl_init_function __fini_array_start[];
+    extern stl_init_function __fini_array_end[];
+    extern char __ro_after_init_start[];
+    extern char __ro_after_init_end[];
+}
+
+namespace std
+{
+    STL_STARTUP void run_static_constructors() noexcept
+    {
+        STL_TRACE_ZONE(boot, "run_static_constructors");
+
+        // .ctors entries may be 0 or -1 list markers left by old toolchains.
+        for (stl_init_function* entry = __ctors_end; entry != __ctors_start; )
+        {
+            const stl_init_function function = *--entry;
+            if (function && function != reinterpret_cast<stl_init_function>(-1))
+                function();
+        }
+
+        for (stl_init_function* entry = __crt_xc_start; entry != __crt_xc_end; ++entry)
+        {
+            if (*entry)
+                (*entry)();
+        }
+
+        for (stl_init_function* entry = __init_array_start; entry != __init_array_end; ++entry)
+            (*entry)();
+    }
+
+    STL_COLD void run_static_destructors() noexcept
+    {
+        for (stl_init_function* entry = __fini_array_end; entry != __fini_array_start; )
+            (*--entry)();
+
+        for (stl_init_function* entry = __crt_xt_start; entry != __crt_xt_end; ++entry)
+        {
+            if (*entry)
+                (*entry)();
+        }
+    }
+
+    span<char> ro_after_init_region() noexcept
+    {
+        return span<char>(__ro_after_init_start, __ro_after_init_end);
+    }
+
+    STL_STARTUP void seal_ro_after_init(void (*protect)(span<char> region)) noexcept
+    {
+        STL_TRACE_ZONE(boot, "seal_ro_after_init");
+        const span<char> region = ro_after_init_region();
+        if (!region.empty())
+            protect(region);
+    }
+}
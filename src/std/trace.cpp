@@ -0,0 +1,286 @@
+#include "trace.hpp"
+#include "section.hpp"
+#include "thread_local.hpp"
+
+#if STL_TRACING
+
+
+namespace std
+{
+    namespace detail
+    {
+        inline constexpr uint32_t trace_max_threads = 16;
+        inline constexpr uint64_t trace_ring_capacity = 2048;  // power of two
+        inline constexpr size_t trace_read_batch = 64;
+
+        // Written by its thread only. head counts every event ever recorded and is published
+        // with a release store, so a reader sees the events below it.
+        struct trace_ring
+        {
+            trace_event events[trace_ring_capacity];
+            uint64_t head;
+        };
+
+        trace_ring trace_rings[trace_max_threads];
+        uint32_t trace_claimed = 0;
+        uint64_t trace_untracked = 0;
+
+        STL_THREAD_LOCAL trace_ring* trace_current_ring = nullptr;
+        STL_THREAD_LOCAL bool trace_exhausted = false;
+
+        trace_ring* trace_ring_for_thread() noexcept
+        {
+            if (trace_current_ring || trace_exhausted)
+                return trace_current_ring;
+
+            const uint32_t slot = __atomic_fetch_add(&trace_claimed, 1, __ATOMIC_ACQ_REL);
+            if (slot >= trace_max_threads)
+            {
+                trace_exhausted = true;
+                return nullptr;
+            }
+
+            trace_current_ring = &trace_rings[slot];
+            return trace_current_ring;
+        }
+
+        uint32_t trace_threads() noexcept
+        {
+            const uint32_t claimed = __atomic_load_n(&trace_claimed, __ATOMIC_ACQUIRE);
+            return claimed < trace_max_threads ? claimed : trace_max_threads;
+        }
+
+        STL_HOT void trace_record(const char* name, trace_category category, uint64_t begin, uint64_t end) noexcept
+        {
+            trace_ring* ring = trace_ring_for_thread();
+            if (!ring)
+            {
+                __atomic_fetch_add(&trace_untracked, 1, __ATOMIC_RELAXED);
+                return;
+            }
+
+            const uint64_t head = ring->head;
+            const uint32_t thread = static_cast<uint32_t>(ring - trace_rings);
+            ring->events[head & (trace_ring_capacity - 1)] = { name, begin, end, category, thread };
+            __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+        }
+
+        // Copies up to output.size() events of ring, from event number index on, and advances
+        // index past them. Events the writer may have overwritten during the copy are dropped
+        // from the result, as a seqlock reader would retry them.
+        size_t trace_read(const trace_ring& ring, uint64_t& index, span<trace_event> output) noexcept
+        {
+            const uint64_t head = __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE);
+            if (head > trace_ring_capacity && index < head - trace_ring_capacity)
+                index = head - trace_ring_capacity;
+
+            const uint64_t available = head - index;
+            const size_t count = available < output.size() ? static_cast<size_t>(available) : output.size();
+            for (size_t i = 0; i < count; ++i)
+                output[i] = ring.events[(index + i) & (trace_ring_capacity - 1)];
+
+            // The writer may be storing event number after, over after - capacity.
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            const uint64_t after = __atomic_load_n(&ring.head, __ATOMIC_RELAXED);
+            const uint64_t first_valid = after >= trace_ring_capacity ? after - trace_ring_capacity + 1 : 0;
+
+            size_t skipped = 0;
+            if (index < first_valid)
+                skipped = first_valid - index < count ? static_cast<size_t>(first_valid - index) : count;
+
+            for (size_t i = skipped; i < count; ++i)
+                output[i - skipped] = output[i];
+
+            index += count;
+            return count - skipped;
+        }
+
+        // Fixed-point JSON output, the library has no formatting facility yet.
+        class trace_json_writer
+        {
+        public:
+            void text(string_view value) noexcept
+            {
+                for (size_t i = 0; i < value.size() && m_size < sizeof(m_buffer); ++i)
+                    m_buffer[m_size++] = value[i];
+            }
+
+            void decimal(uint64_t value) noexcept
+            {
+                char digits[20];
+                size_t count = 0;
+
+                do
+                {
+                    digits[count++] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while (value);
+
+                while (count)
+                    text(string_view(&digits[--count], 1));
+            }
+
+            // value / 1000 with three decimals: microseconds from nanoseconds.
+            void thousandths(uint64_t value) noexcept
+            {
+                decimal(value / 1000);
+                const uint64_t fraction = value % 1000;
+                const char digits[4] = { '.', static_cast<char>('0' + fraction / 100), static_cast<char>('0' + fraction / 10 % 10),
+                                         static_cast<char>('0' + fraction % 10) };
+                text(string_view(digits, 4));
+            }
+
+            void quoted(const char* value) noexcept
+            {
+                text("\"");
+                for (; *value; ++value)
+                {
+                    const char ch = *value;
+                    if (ch == '"' || ch == '\\')
+                    {
+                        const char escaped[2] = { '\\', ch };
+                        text(string_view(escaped, 2));
+                    }
+                    else if (static_cast<unsigned char>(ch) < 0x20)
+                    {
+                        const char escaped[6] = { '\\', 'u', '0', '0', "0123456789abcdef"[ch >> 4], "0123456789abcdef"[ch & 0xF] };
+                        text(string_view(escaped, 6));
+                    }
+                    else
+                    {
+                        text(string_view(&ch, 1));
+                    }
+                }
+                text("\"");
+            }
+
+            string_view chunk() const noexcept
+            {
+                return string_view(m_buffer, m_size);
+            }
+        private:
+            char m_buffer[320];
+            size_t m_size = 0;
+        };
+
+        const char* trace_category_name(trace_category category) noexcept
+        {
+            switch (category)
+            {
+                case trace_category::boot:
+                    return "boot";
+                case trace_category::memory:
+                    return "memory";
+                case trace_category::io:
+                    return "io";
+                case trace_category::parser:
+                    return "parser";
+                case trace_category::user:
+                    return "user";
+            }
+            return "unknown";
+        }
+    }
+
+
+    // Functions
+    STL_COLD size_t trace_collect(span<trace_event> output, uint64_t* dropped) noexcept
+    {
+        size_t count = 0;
+        uint64_t lost = __atomic_load_n(&detail::trace_untracked, __ATOMIC_RELAXED);
+
+        for (uint32_t thread = 0; thread < detail::trace_threads(); ++thread)
+        {
+            const detail::trace_ring& ring = detail::trace_rings[thread];
+            uint64_t index = 0;
+            uint64_t copied = 0;
+
+            while (count < output.size())
+            {
+                const uint64_t before = index;
+                const size_t read = detail::trace_read(ring, index, output.subspan(count));
+                count += read;
+                copied += read;
+                if (index == before)
+                    break;
+            }
+
+            // Every event numbered below index was either copied or overwritten.
+            lost += index - copied;
+        }
+
+        if (dropped)
+            *dropped = lost;
+
+        return count;
+    }
+
+    STL_COLD void trace_export_chrome(void (*sink)(string_view chunk), uint64_t ticks_per_microsecond) noexcept
+    {
+        if (!ticks_per_microsecond)
+            ticks_per_microsecond = 1;
+
+        trace_event batch[detail::trace_read_batch];
+        const uint32_t threads = detail::trace_threads();
+
+        // First pass for the origin, so that timestamps stay small enough to scale.
+        uint64_t origin = ~uint64_t(0);
+        for (uint32_t thread = 0; thread < threads; ++thread)
+        {
+            uint64_t index = 0;
+            for (uint64_t before = ~uint64_t(0); before != index; )
+            {
+                before = index;
+                const size_t count = detail::trace_read(detail::trace_rings[thread], index, span<trace_event>(batch));
+                for (size_t i = 0; i < count; ++i)
+                    origin = batch[i].begin < origin ? batch[i].begin : origin;
+            }
+        }
+
+        sink("{\"traceEvents\":[");
+
+        bool first = true;
+        for (uint32_t thread = 0; thread < threads; ++thread)
+        {
+            uint64_t index = 0;
+            for (uint64_t before = ~uint64_t(0); before != index; )
+            {
+                before = index;
+                const size_t count = detail::trace_read(detail::trace_rings[thread], index, span<trace_event>(batch));
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const trace_event& event = batch[i];
+                    const uint64_t begin = event.begin > origin ? event.begin - origin : 0;
+                    const uint64_t duration = event.end > event.begin ? event.end - event.begin : 0;
+
+                    detail::trace_json_writer writer;
+                    writer.text(first ? "\n{\"name\":" : ",\n{\"name\":");
+                    writer.quoted(event.name);
+                    writer.text(",\"cat\":\"");
+                    writer.text(detail::trace_category_name(event.category));
+                    writer.text("\",\"ph\":\"X\",\"ts\":");
+                    writer.thousandths(begin * 1000 / ticks_per_microsecond);
+                    writer.text(",\"dur\":");
+                    writer.thousandths(duration * 1000 / ticks_per_microsecond);
+                    writer.text(",\"pid\":1,\"tid\":");
+                    writer.decimal(event.thread);
+                    writer.text("}");
+                    sink(writer.chunk());
+                    first = false;
+                }
+            }
+        }
+
+        sink("\n],\"displayTimeUnit\":\"ns\"}\n");
+    }
+
+    STL_COLD void trace_reset() noexcept
+    {
+        for (uint32_t thread = 0; thread < detail::trace_threads(); ++thread)
+            __atomic_store_n(&detail::trace_rings[thread].head, 0, __ATOMIC_RELEASE);
+        __atomic_store_n(&detail::trace_untracked, 0, __ATOMIC_RELAXED);
+    }
+}
+
+#endif
@@ -0,0 +1,532 @@
+#include "utf.hpp"
+#include "cstdint.hpp"
+#include "bit.hpp"
+#include "cpu_features.hpp"
+#include "section.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+
+namespace std
+{
+    namespace detail
+    {
+        // Scalar decoders, shared by every path: the vector loops only ever consume pure ASCII
+        // blocks and leave the rest to them.
+        struct utf_decoded
+        {
+            uint32_t code_point;
+            size_t length; // 0 when the sequence is invalid
+        };
+
+        constexpr bool is_utf8_continuation(uint8_t byte) noexcept
+        {
+            return (byte & 0xC0) == 0x80;
+        }
+
+        utf_decoded decode_utf8(const uint8_t* input, size_t available) noexcept
+        {
+            const uint8_t lead = input[0];
+
+            if (lead < 0x80)
+                return { lead, 1 };
+
+            // Stray continuation bytes and the overlong C0/C1 leads
+            if (lead < 0xC2)
+                return { 0, 0 };
+
+            if (lead < 0xE0)
+            {
+                if (available < 2 || !is_utf8_continuation(input[1]))
+                    return { 0, 0 };
+
+                return { (uint32_t(lead & 0x1F) << 6) | (input[1] & 0x3F), 2 };
+            }
+
+            if (lead < 0xF0)
+            {
+                if (available < 3 || !is_utf8_continuation(input[1]) || !is_utf8_continuation(input[2]))
+                    return { 0, 0 };
+
+                // Overlong forms and UTF-16 surrogates
+                if ((lead == 0xE0 && input[1] < 0xA0) || (lead == 0xED && input[1] >= 0xA0))
+                    return { 0, 0 };
+
+                return { (uint32_t(lead & 0x0F) << 12) | (uint32_t(input[1] & 0x3F) << 6) | (input[2] & 0x3F), 3 };
+            }
+
+            if (lead < 0xF5)
+            {
+                if (available < 4 || !is_utf8_continuation(input[1]) || !is_utf8_continuation(input[2])
+                    || !is_utf8_continuation(input[3]))
+                    return { 0, 0 };
+
+                // Overlong forms and code points above U+10FFFF
+                if ((lead == 0xF0 && input[1] < 0x90) || (lead == 0xF4 && input[1] >= 0x90))
+                    return { 0, 0 };
+
+                return { (uint32_t(lead & 0x07) << 18) | (uint32_t(input[1] & 0x3F) << 12)
+                         | (uint32_t(input[2] & 0x3F) << 6) | (input[3] & 0x3F), 4 };
+            }
+
+            return { 0, 0 };
+        }
+
+        utf_decoded decode_utf16(const char16_t* input, size_t available) noexcept
+        {
+            const uint32_t unit = input[0];
+
+            if (unit < 0xD800 || unit > 0xDFFF)
+                return { unit, 1 };
+
+            // Lone low surrogate or truncated pair
+            if (unit > 0xDBFF || available < 2)
+                return { 0, 0 };
+
+            const uint32_t low = input[1];
+            if (low < 0xDC00 || low > 0xDFFF)
+                return { 0, 0 };
+
+            return { 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00), 2 };
+        }
+
+        size_t encode_utf8(uint32_t code_point, uint8_t* output) noexcept
+        {
+            if (code_point < 0x80)
+            {
+                output[0] = static_cast<uint8_t>(code_point);
+                return 1;
+            }
+
+            if (code_point < 0x800)
+            {
+                output[0] = static_cast<uint8_t>(0xC0 | (code_point >> 6));
+                output[1] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+                return 2;
+            }
+
+            if (code_point < 0x10000)
+            {
+                output[0] = static_cast<uint8_t>(0xE0 | (code_point >> 12));
+                output[1] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3F));
+                output[2] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+                return 3;
+            }
+
+            output[0] = static_cast<uint8_t>(0xF0 | (code_point >> 18));
+            output[1] = static_cast<uint8_t>(0x80 | ((code_point >> 12) & 0x3F));
+            output[2] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3F));
+            output[3] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+            return 4;
+        }
+
+        constexpr size_t utf8_length_of(uint32_t code_point) noexcept
+        {
+            return code_point < 0x80 ? 1 : code_point < 0x800 ? 2 : code_point < 0x10000 ? 3 : 4;
+        }
+
+        // Length of the leading run of ASCII bytes.
+        size_t ascii_prefix_length(const uint8_t* input, size_t size) noexcept
+        {
+            size_t index = 0;
+
+#if defined(__AVX2__)
+            for (; index + 32 <= size; index += 32)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + index));
+                const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(block));
+                if (mask)
+                    return index + countr_zero(mask);
+            }
+#endif
+#if defined(__SSE2__)
+            for (; index + 16 <= size; index += 16)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + index));
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(block));
+                if (mask)
+                    return index + countr_zero(mask);
+            }
+#endif
+
+            while (index < size && input[index] < 0x80)
+                ++index;
+
+            return index;
+        }
+
+#if defined(__x86_64__)
+        // Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte".
+        // Every byte is classified by three 16-entry lookups: the high and low nibbles of the byte
+        // before it and its own high nibble. The AND of the three is non-zero only on an error; the
+        // remaining case (a missing or extra 3rd/4th byte) is caught by comparing against the bytes
+        // two and three positions back.
+        enum : uint8_t
+        {
+            utf8_too_short = 1 << 0,
+            utf8_too_long = 1 << 1,
+            utf8_overlong_3 = 1 << 2,
+            utf8_too_large = 1 << 3,
+            utf8_surrogate = 1 << 4,
+            utf8_overlong_2 = 1 << 5,
+            utf8_too_large_1000 = 1 << 6,
+            utf8_overlong_4 = 1 << 6,
+            utf8_two_conts = 1 << 7,
+            utf8_carry = utf8_too_short | utf8_too_long | utf8_two_conts
+        };
+
+        alignas(16) constexpr uint8_t utf8_byte_1_high[16] =
+        {
+            // 0_______: ASCII
+            utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+            utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+            // 10______: continuation
+            utf8_two_conts, utf8_two_conts, utf8_two_conts, utf8_two_conts,
+            // 1100____, 1101____: two byte lead
+            utf8_too_short | utf8_overlong_2,
+            utf8_too_short,
+            // 1110____: three byte lead
+            utf8_too_short | utf8_overlong_3 | utf8_surrogate,
+            // 1111____: four byte lead
+            utf8_too_short | utf8_too_large | utf8_too_large_1000 | utf8_overlong_4
+        };
+
+        alignas(16) constexpr uint8_t utf8_byte_1_low[16] =
+        {
+            utf8_carry | utf8_overlong_3 | utf8_overlong_2 | utf8_overlong_4,
+            utf8_carry | utf8_overlong_2,
+            utf8_carry,
+            utf8_carry,
+            utf8_carry | utf8_too_large,
+            utf8_carry | utf8_too_large | utf8_too_large_1000,
+            utf8_carry | utf8_too_large | utf8_too_large_1000,
+            utf8_carry | utf8_too_large | utf8_too_large_1000,
+            utf8_carry | utf8_too_large | utf8_too_large_1000,
+            utf8_carry | utf8_too_large | utf8_too_large_1000,
+            utf8_carry | utf8_too_large | utf8_too_large_1000,
+            utf8_carry | utf8_too_large | utf8_too_large_1000,
+            utf8_carry | utf8_too_large | utf8_too_large_1000,
+            utf8_carry | utf8_too_large | utf8_too_large_1000 | utf8_surrogate,
+            utf8_carry | utf8_too_large | utf8_too_large_1000,
+            utf8_carry | utf8_too_large | utf8_too_large_1000
+        };
+
+        alignas(16) constexpr uint8_t utf8_byte_2_high[16] =
+        {
+            // ________ 0_______: ASCII
+            utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+            utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+            // ________ 1000____
+            utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large_1000 | utf8_overlong_4,
+            // ________ 1001____
+            utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large,
+            // ________ 101_____
+            utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+            utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+            // ________ 11______
+            utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short
+        };
+
+        STL_TARGET("avx2") inline __m256i utf8_lookup(const uint8_t (&table)[16], __m256i nibbles) noexcept
+        {
+            const __m256i lut = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table)));
+            return _mm256_shuffle_epi8(lut, nibbles);
+        }
+
+        STL_TARGET("avx2") inline __m256i utf8_high_nibbles(__m256i bytes) noexcept
+        {
+            return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+        }
+
+        // The block shifted right by N bytes, the gap filled from the end of the previous block.
+        template<int N>
+        STL_TARGET("avx2") inline __m256i utf8_previous(__m256i block, __m256i previous) noexcept
+        {
+            return _mm256_alignr_epi8(block, _mm256_permute2x128_si256(previous, block, 0x21), 16 - N);
+        }
+
+        STL_TARGET("avx2") inline __m256i utf8_block_errors(__m256i block, __m256i previous) noexcept
+        {
+            const __m256i low_nibble_mask = _mm256_set1_epi8(0x0F);
+            const __m256i previous_1 = utf8_previous<1>(block, previous);
+
+            const __m256i special_cases = _mm256_and_si256(
+                    _mm256_and_si256(utf8_lookup(utf8_byte_1_high, utf8_high_nibbles(previous_1)),
+                                     utf8_lookup(utf8_byte_1_low, _mm256_and_si256(previous_1, low_nibble_mask))),
+                    utf8_lookup(utf8_byte_2_high, utf8_high_nibbles(block)));
+
+            // Only 111_____ (resp. 1111____) stays >= 0x80 after the saturating subtraction.
+            const __m256i is_third_byte = _mm256_subs_epu8(utf8_previous<2>(block, previous), _mm256_set1_epi8(char(0xE0 - 0x80)));
+            const __m256i is_fourth_byte = _mm256_subs_epu8(utf8_previous<3>(block, previous), _mm256_set1_epi8(char(0xF0 - 0x80)));
+            const __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+                                                                  _mm256_set1_epi8(char(0x80)));
+
+            return _mm256_xor_si256(must_be_continuation, special_cases);
+        }
+
+        // Non-zero where one of the last three bytes starts a sequence that runs past the block.
+        STL_TARGET("avx2") inline __m256i utf8_incomplete_tail(__m256i block) noexcept
+        {
+            const __m256i max_value = _mm256_setr_epi8(
+                    char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+                    char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+                    char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+                    char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+                    char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+            return _mm256_subs_epu8(block, max_value);
+        }
+
+        STL_TARGET("avx2") bool utf8_validate_avx2(const uint8_t* input, size_t size) noexcept
+        {
+            __m256i error = _mm256_setzero_si256();
+            __m256i previous = _mm256_setzero_si256();
+            __m256i previous_incomplete = _mm256_setzero_si256();
+
+            size_t index = 0;
+            for (; index + 32 <= size; index += 32)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + index));
+
+                if (_mm256_movemask_epi8(block) == 0)
+                {
+                    // An ASCII block is only wrong if the previous one left a sequence open.
+                    error = _mm256_or_si256(error, previous_incomplete);
+                }
+                else
+                {
+                    error = _mm256_or_si256(error, utf8_block_errors(block, previous));
+                    previous_incomplete = utf8_incomplete_tail(block);
+                }
+
+                previous = block;
+            }
+
+            if (index < size)
+            {
+                // Zero padding reads as ASCII, which flags any sequence cut by the end of input.
+                alignas(32) uint8_t tail[32] = {};
+                for (size_t i = 0; index + i < size; ++i)
+                    tail[i] = input[index + i];
+
+                const __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+                error = _mm256_or_si256(error, utf8_block_errors(block, previous));
+                previous_incomplete = utf8_incomplete_tail(block);
+            }
+
+            error = _mm256_or_si256(error, previous_incomplete);
+            return _mm256_testz_si256(error, error);
+        }
+#endif
+
+        bool utf8_validate_scalar(const uint8_t* input, size_t size) noexcept
+        {
+            size_t index = 0;
+            while (true)
+            {
+                index += ascii_prefix_length(input + index, size - index);
+                if (index == size)
+                    return true;
+
+                const utf_decoded decoded = decode_utf8(input + index, size - index);
+                if (decoded.length == 0)
+                    return false;
+
+                index += decoded.length;
+            }
+        }
+
+#if defined(__x86_64__) && !defined(__AVX2__)
+        // The build cannot assume AVX2, the validator picks it at run time.
+        using utf8_validate_kernel = cpu_dispatch<bool(const uint8_t*, size_t)>;
+
+        const utf8_validate_kernel::variant utf8_validate_variants[] =
+        {
+            { cpu_feature::avx2, &utf8_validate_avx2 },
+            { {}, &utf8_validate_scalar }
+        };
+
+        utf8_validate_kernel utf8_validate_dispatch(utf8_validate_variants);
+#endif
+    }
+
+
+    STL_HOT bool utf8_validate(span<const char> input) noexcept
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(input.data());
+        const size_t size = input.size();
+
+#if defined(__AVX2__)
+        return detail::utf8_validate_avx2(bytes, size);
+#elif defined(__x86_64__)
+        return detail::utf8_validate_dispatch(bytes, size);
+#else
+        return detail::utf8_validate_scalar(bytes, size);
+#endif
+    }
+
+    size_t utf16_length_from_utf8(span<const char> input) noexcept
+    {
+        // One unit per lead byte, plus one for every 4 byte lead (surrogate pair).
+        size_t length = 0;
+        for (const char c : input)
+        {
+            const uint8_t byte = static_cast<uint8_t>(c);
+            length += !detail::is_utf8_continuation(byte);
+            length += byte >= 0xF0;
+        }
+        return length;
+    }
+
+    size_t utf8_length_from_utf16(span<const char16_t> input) noexcept
+    {
+        // Each half of a surrogate pair accounts for two of the four bytes.
+        size_t length = 0;
+        for (const char16_t unit : input)
+            length += unit < 0x80 ? 1 : (unit < 0x800 || (unit >= 0xD800 && unit <= 0xDFFF)) ? 2 : 3;
+        return length;
+    }
+
+    STL_HOT utf_result utf8_to_utf16(span<const char> input, span<char16_t> output) noexcept
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(input.data());
+        const size_t size = input.size();
+        char16_t* units = output.data();
+        const size_t capacity = output.size();
+
+        size_t read = 0;
+        size_t written = 0;
+
+        while (read < size)
+        {
+            // ASCII fast path: widen whole blocks while there is room for them.
+#if defined(__AVX2__)
+            while (read + 32 <= size && written + 32 <= capacity)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + read));
+                if (_mm256_movemask_epi8(block))
+                    break;
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(units + written), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(block)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(units + written + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(block, 1)));
+                read += 32;
+                written += 32;
+            }
+#endif
+#if defined(__SSE2__)
+            while (read + 16 <= size && written + 16 <= capacity)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + read));
+                if (_mm_movemask_epi8(block))
+                    break;
+
+                const __m128i zero = _mm_setzero_si128();
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(units + written), _mm_unpacklo_epi8(block, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(units + written + 8), _mm_unpackhi_epi8(block, zero));
+                read += 16;
+                written += 16;
+            }
+#endif
+
+            // Scalar path up to the end of the block that stopped the vector loop, so it is not
+            // loaded again for every code point it contains.
+            const size_t stop = size - read < 16 ? size : read + 16;
+            while (read < stop)
+            {
+                const detail::utf_decoded decoded = detail::decode_utf8(bytes + read, size - read);
+                if (decoded.length == 0)
+                    return { utf_status::invalid_sequence, read, written };
+
+                const bool pair = decoded.code_point >= 0x10000;
+                if (written + 1 + pair > capacity)
+                    return { utf_status::output_too_small, read, written };
+
+                if (pair)
+                {
+                    const uint32_t offset = decoded.code_point - 0x10000;
+                    units[written++] = static_cast<char16_t>(0xD800 + (offset >> 10));
+                    units[written++] = static_cast<char16_t>(0xDC00 + (offset & 0x3FF));
+                }
+                else
+                {
+                    units[written++] = static_cast<char16_t>(decoded.code_point);
+                }
+
+                read += decoded.length;
+            }
+        }
+
+        return { utf_status::ok, read, written };
+    }
+
+    STL_HOT utf_result utf16_to_utf8(span<const char16_t> input, span<char> output) noexcept
+    {
+        const char16_t* units = input.data();
+        const size_t size = input.size();
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(output.data());
+        const size_t capacity = output.size();
+
+        size_t read = 0;
+        size_t written = 0;
+
+        while (read < size)
+        {
+            // ASCII fast path: narrow whole blocks while there is room for them.
+#if defined(__AVX2__)
+            while (read + 16 <= size && written + 16 <= capacity)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(units + read));
+                if (!_mm256_testz_si256(block, _mm256_set1_epi16(static_cast<short>(0xFF80))))
+                    break;
+
+                const __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(block), _mm256_extracti128_si256(block, 1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + written), packed);
+                read += 16;
+                written += 16;
+            }
+#endif
+#if defined(__SSE2__)
+            while (read + 8 <= size && written + 8 <= capacity)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(units + read));
+                const __m128i high_bits = _mm_and_si128(block, _mm_set1_epi16(static_cast<short>(0xFF80)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high_bits, _mm_setzero_si128())) != 0xFFFF)
+                    break;
+
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(bytes + written), _mm_packus_epi16(block, block));
+                read += 8;
+                written += 8;
+            }
+#endif
+
+            const size_t stop = size - read < 8 ? size : read + 8;
+            while (read < stop)
+            {
+                const detail::utf_decoded decoded = detail::decode_utf16(units + read, size - read);
+                if (decoded.length == 0)
+                    return { utf_status::invalid_sequence, read, written };
+
+                if (written + detail::utf8_length_of(decoded.code_point) > capacity)
+                    return { utf_status::output_too_small, read, written };
+
+                written += detail::encode_utf8(decoded.code_point, bytes + written);
+                read += decoded.length;
+            }
+        }
+
+        return { utf_status::ok, read, written };
+    }
+
+#if __WCHAR_MAX__ == 0xFFFF
+    utf_result utf8_to_utf16(span<const char> input, span<wchar_t> output) noexcept
+    {
+        return utf8_to_utf16(input, span<char16_t>(reinterpret_cast<char16_t*>(output.data()), output.size()));
+    }
+
+    utf_result utf16_to_utf8(span<const wchar_t> input, span<char> output) noexcept
+    {
+        return utf16_to_utf8(span<const char16_t>(reinterpret_cast<const char16_t*>(input.data()), input.size()), output);
+    }
+#endif
+}
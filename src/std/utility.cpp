@@ -1,28 +0,0 @@
-#include "utility.hpp"
-
-namespace std
-{
-    template<class T>
-    remove_reference_t<T>&& move(T&& var) noexcept
-    {
-        return static_cast<typename remove_reference_t<T>&&>(var);
-    }
-
-    template<class T>
-    add_rvalue_reference_t<T> declval() noexcept
-    {
-        static_assert(stdimpl::always_false<T>, "declval not allowed in an evaluated context");
-    }
-
-    template<class T>
-    constexpr T&& forward(remove_reference_t<T>& t) noexcept
-    {
-        return static_cast<T&&>(t);
-    }
-
-    template<class T>
-    constexpr T&& forward(remove_reference_t<T>&& t) noexcept
-    {
-        return static_cast<T&&>(t);
-    }
-}
\ No newline at end of file